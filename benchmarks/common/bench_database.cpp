@@ -0,0 +1,236 @@
+#include "bench_database.h"
+#include "database/SQLite_database.h"
+#include "database/migrations.h"
+#include "utils/time/time_format.h"
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace lynx::bench
+{
+
+namespace
+{
+
+constexpr std::array<const char *, 13> categories_ = {"KITCHEN", "ELECTRONICS", "HOME", "CLEANING", "FOOD",     "BEVERAGES", "PERSONAL_CARE",
+                                                       "PETS",    "TOOLS",       "OFFICE", "TOYS",   "CLOTHING", "OTHER"};
+
+constexpr std::array<const char *, 3> methods_ = {"PIX", "CARD", "BOLETO"};
+
+SeededIds seeded_;
+
+auto database_path() -> const std::filesystem::path &
+{
+    static const auto path = std::filesystem::temp_directory_path() / ("lynx_bench_" + std::to_string(::getpid()) + ".db");
+    return path;
+}
+
+auto connection() -> sqlite3 *
+{
+    return database::SQLiteDatabase::get_instance().get_connection();
+}
+
+// Statement preparado uma vez e reaproveitado em todas as linhas do seed
+class Statement
+{
+private:
+    sqlite3_stmt *stmt_ = nullptr;
+
+public:
+    explicit Statement(const char *sql)
+    {
+        if (sqlite3_prepare_v2(connection(), sql, -1, &stmt_, nullptr) != SQLITE_OK)
+            throw std::runtime_error(sqlite3_errmsg(connection()));
+    }
+
+    ~Statement()
+    {
+        sqlite3_finalize(stmt_);
+    }
+
+    Statement(const Statement &) = delete;
+    Statement &operator=(const Statement &) = delete;
+
+    auto bind(int index, int64_t value) -> Statement &
+    {
+        sqlite3_bind_int64(stmt_, index, value);
+        return *this;
+    }
+
+    auto bind(int index, const std::string &value) -> Statement &
+    {
+        sqlite3_bind_text(stmt_, index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+        return *this;
+    }
+
+    auto bind_null(int index) -> Statement &
+    {
+        sqlite3_bind_null(stmt_, index);
+        return *this;
+    }
+
+    auto run() -> void
+    {
+        if (sqlite3_step(stmt_) != SQLITE_DONE)
+            throw std::runtime_error(sqlite3_errmsg(connection()));
+
+        sqlite3_reset(stmt_);
+        sqlite3_clear_bindings(stmt_);
+    }
+};
+
+auto load_schema() -> void
+{
+    std::ifstream file(LYNX_SCHEMA_PATH);
+    if (!file)
+        throw std::runtime_error("Schema não encontrado: " LYNX_SCHEMA_PATH);
+
+    std::stringstream schema;
+    schema << file.rdbuf();
+    exec(schema.str());
+
+    // seed() grava as datas em UTC: nada a migrar
+    database::mark_migrations_applied(connection());
+}
+
+auto product_price(int product_id) -> int64_t
+{
+    return 199 + (static_cast<int64_t>(product_id) * 37) % 50000;
+}
+
+auto seed() -> void
+{
+    using std::chrono::minutes;
+
+    const auto now = std::chrono::system_clock::now();
+    const auto sql_time = [](const std::chrono::system_clock::time_point &tp) {
+        return utils::time::format_time(tp, utils::time::TimeFormat::sql);
+    };
+
+    exec("BEGIN TRANSACTION;");
+
+    Statement customer("INSERT INTO customers (name, email, created_at) VALUES (?, ?, ?)");
+    for (int id = 1; id <= Dataset::customers_; ++id)
+    {
+        customer.bind(1, "Cliente " + std::to_string(id))
+            .bind(2, "cliente" + std::to_string(id) + "@lynx.dev")
+            .bind(3, sql_time(now - std::chrono::hours(id)))
+            .run();
+    }
+
+    Statement product("INSERT INTO products (name, category, price_cents, active, stock) VALUES (?, ?, ?, ?, ?)");
+    for (int id = 1; id <= Dataset::products_; ++id)
+    {
+        product.bind(1, "Produto " + std::to_string(id))
+            .bind(2, categories_[id % categories_.size()])
+            .bind(3, product_price(id))
+            .bind(4, id % 10 != 0)
+            .bind(5, 100 + id % 400)
+            .run();
+    }
+
+    Statement order("INSERT INTO orders (customer_id, status, created_at) VALUES (?, ?, ?)");
+    Statement item("INSERT INTO order_items (order_id, product_id, quantity, unit_price_cents) VALUES (?, ?, ?, ?)");
+    Statement payment("INSERT INTO payments (order_id, method, amount_cents, paid_at) VALUES (?, ?, ?, ?)");
+
+    // Um terço pago, um décimo cancelado, parte já quitada esperando o mark_settled_as_paid e o resto em aberto
+    for (int id = 1; id <= Dataset::orders_; ++id)
+    {
+        const auto created_at = now - minutes(id);
+
+        const char *status = "NEW";
+        bool paid = false;
+
+        if (id % 3 == 0)
+        {
+            status = "PAID";
+            paid = true;
+        }
+        else if (id % 10 == 1)
+        {
+            status = "CANCELLED";
+        }
+        else if (id % 7 == 2)
+        {
+            paid = true;
+            seeded_.settled_orders.push_back(id);
+        }
+        else
+        {
+            seeded_.new_orders.push_back(id);
+        }
+
+        order.bind(1, id % Dataset::customers_ + 1).bind(2, status).bind(3, sql_time(created_at)).run();
+
+        int64_t total = 0;
+        for (int k = 0; k < Dataset::items_per_order_; ++k)
+        {
+            const int product_id = (id * 7 + k * 13) % Dataset::products_ + 1;
+            const int quantity = (id + k) % 3 + 1;
+
+            item.bind(1, id).bind(2, product_id).bind(3, quantity).bind(4, product_price(product_id)).run();
+            total += quantity * product_price(product_id);
+        }
+
+        if (std::string_view(status) == "CANCELLED")
+            continue;
+
+        payment.bind(1, id).bind(2, methods_[id % methods_.size()]).bind(3, total);
+        if (paid)
+            payment.bind(4, sql_time(created_at + minutes(5)));
+        else
+            payment.bind_null(4);
+
+        payment.run();
+
+        if (!paid)
+            seeded_.open_payments.push_back(static_cast<int>(sqlite3_last_insert_rowid(connection())));
+    }
+
+    // O write-back do estoque parte do que já foi semeado, como num banco em produção
+    exec("UPDATE inventory_checkpoint SET last_order_item_id = (SELECT MAX(id) FROM order_items) WHERE id = 1;");
+    exec("COMMIT;");
+    exec("ANALYZE;");
+}
+
+} // namespace
+
+auto open_temp_database() -> void
+{
+    std::filesystem::remove(database_path());
+
+    database::SQLiteDatabase::set_path(database_path().string());
+
+    load_schema();
+    seed();
+}
+
+auto remove_temp_database() -> void
+{
+    std::error_code ignored;
+    std::filesystem::remove(database_path(), ignored);
+    std::filesystem::remove(database_path().string() + "-journal", ignored);
+}
+
+auto seeded_ids() -> const SeededIds &
+{
+    return seeded_;
+}
+
+auto exec(const std::string &sql) -> void
+{
+    char *error = nullptr;
+    if (sqlite3_exec(connection(), sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+    {
+        const std::string message = error != nullptr ? error : "sqlite3_exec";
+        sqlite3_free(error);
+        throw std::runtime_error(message);
+    }
+}
+
+} // namespace lynx::bench
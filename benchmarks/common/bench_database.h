@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ * Banco SQLite temporário do lynx_bench e do lynx_loadgen: arquivo novo em temp_directory_path(), com o
+ * schema de docker/sqlite/init.sql e um volume de dados parecido com o de produção. É criado uma vez
+ * no main, antes de rodar os benchmarks, e apagado no fim.
+ */
+
+namespace lynx::bench
+{
+
+struct Dataset
+{
+    static constexpr int customers_ = 1000;
+    static constexpr int products_ = 5000;
+    static constexpr int orders_ = 20000;
+    static constexpr int items_per_order_ = 3;
+};
+
+/* Ids gravados pelo seed, por situação, para os benchmarks escolherem linhas existentes */
+struct SeededIds
+{
+    std::vector<int> new_orders;     // NEW sem pagamento confirmado
+    std::vector<int> settled_orders; // NEW com pagamento cobrindo o total (alvo do mark_settled_as_paid)
+    std::vector<int> open_payments;  // paid_at nulo
+};
+
+/* Aponta o SQLiteDatabase para o arquivo temporário, aplica o schema e grava os dados */
+auto open_temp_database() -> void;
+auto remove_temp_database() -> void;
+
+auto seeded_ids() -> const SeededIds &;
+
+/* Executa SQL direto na conexão (restaurar estado entre iterações); erro vira std::runtime_error */
+auto exec(const std::string &sql) -> void;
+
+} // namespace lynx::bench
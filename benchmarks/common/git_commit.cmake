@@ -0,0 +1,13 @@
+# Rodado a cada build pelo alvo lynx_git_commit (cmake -P): o configure_file só regrava o header
+# quando o commit muda, então os benchmarks recompilam só depois de um commit novo.
+#   -DSOURCE_DIR=<repositório> -DTEMPLATE=<lynx_git_commit.h.in> -DOUTPUT=<header gerado>
+
+execute_process(
+    COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE LYNX_GIT_COMMIT
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+
+configure_file(${TEMPLATE} ${OUTPUT} @ONLY)
@@ -0,0 +1,250 @@
+#include "http_client.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <strings.h>
+
+namespace lynx::bench
+{
+
+namespace
+{
+
+// Valor de um header (nome sem distinção de maiúsculas) dentro do bloco de headers
+auto header_value(std::string_view headers, std::string_view name) -> std::string_view
+{
+    size_t position = 0;
+    while (position < headers.size())
+    {
+        const auto end = headers.find("\r\n", position);
+        const auto line = headers.substr(position, end == std::string_view::npos ? std::string_view::npos : end - position);
+
+        if (line.size() > name.size() && line[name.size()] == ':' && strncasecmp(line.data(), name.data(), name.size()) == 0)
+        {
+            auto value = line.substr(name.size() + 1);
+            while (!value.empty() && value.front() == ' ')
+                value.remove_prefix(1);
+            return value;
+        }
+
+        if (end == std::string_view::npos)
+            break;
+        position = end + 2;
+    }
+
+    return {};
+}
+
+auto starts_with_nocase(std::string_view text, std::string_view prefix) -> bool
+{
+    return text.size() >= prefix.size() && strncasecmp(text.data(), prefix.data(), prefix.size()) == 0;
+}
+
+} // namespace
+
+HttpClient::HttpClient(uint16_t port, std::chrono::milliseconds timeout, std::string extra_headers)
+    : port_(port)
+    , timeout_(timeout)
+    , extra_headers_(std::move(extra_headers))
+{
+}
+
+HttpClient::~HttpClient()
+{
+    close();
+}
+
+auto HttpClient::connect() -> bool
+{
+    socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket_ < 0)
+        return false;
+
+    const int on = 1;
+    setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeout_.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeout_.count() % 1000) * 1000);
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(socket_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port_);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::connect(socket_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+auto HttpClient::close() -> void
+{
+    if (socket_ >= 0)
+        ::close(socket_);
+
+    socket_ = -1;
+    buffer_.clear();
+}
+
+auto HttpClient::read_more() -> bool
+{
+    char chunk[16384];
+
+    ssize_t received;
+    do
+    {
+        received = ::recv(socket_, chunk, sizeof(chunk), 0);
+    } while (received < 0 && errno == EINTR);
+
+    if (received <= 0)
+        return false;
+
+    buffer_.append(chunk, static_cast<size_t>(received));
+    return true;
+}
+
+auto HttpClient::read_response(HttpResponse &response) -> bool
+{
+    size_t header_end;
+    while ((header_end = buffer_.find("\r\n\r\n")) == std::string::npos)
+    {
+        if (!read_more())
+            return false;
+    }
+
+    const std::string_view head(buffer_.data(), header_end);
+
+    // "HTTP/1.1 200 OK"
+    const auto space = head.find(' ');
+    if (space == std::string_view::npos || std::from_chars(head.data() + space + 1, head.data() + head.size(), response.status).ec != std::errc())
+        return false;
+
+    const auto headers = head.substr(head.find("\r\n") + 2);
+    const bool keep_alive = !starts_with_nocase(header_value(headers, "Connection"), "close");
+
+    size_t position = header_end + 4;
+
+    if (const auto length = header_value(headers, "Content-Length"); !length.empty())
+    {
+        size_t size = 0;
+        std::from_chars(length.data(), length.data() + length.size(), size);
+
+        while (buffer_.size() < position + size)
+        {
+            if (!read_more())
+                return false;
+        }
+
+        response.body.assign(buffer_, position, size);
+        buffer_.erase(0, position + size);
+    }
+    else if (starts_with_nocase(header_value(headers, "Transfer-Encoding"), "chunked"))
+    {
+        response.body.clear();
+
+        for (;;)
+        {
+            size_t line_end;
+            while ((line_end = buffer_.find("\r\n", position)) == std::string::npos)
+            {
+                if (!read_more())
+                    return false;
+            }
+
+            size_t size = 0;
+            std::from_chars(buffer_.data() + position, buffer_.data() + line_end, size, 16);
+            position = line_end + 2;
+
+            while (buffer_.size() < position + size + 2)
+            {
+                if (!read_more())
+                    return false;
+            }
+
+            response.body.append(buffer_, position, size);
+            position += size + 2;
+
+            if (size == 0)
+                break;
+        }
+
+        buffer_.erase(0, position);
+    }
+    else
+    {
+        // Sem tamanho: o corpo vai até o servidor fechar
+        while (read_more())
+        {
+        }
+
+        response.body.assign(buffer_, position);
+        close();
+        return true;
+    }
+
+    if (!keep_alive)
+        close();
+
+    return true;
+}
+
+auto HttpClient::send(std::string_view method, std::string_view path, std::string_view body, std::string_view content_type,
+                      std::string_view headers) -> HttpResponse
+{
+    request_.clear();
+    request_.append(method).append(" ").append(path).append(" HTTP/1.1\r\nHost: 127.0.0.1\r\n");
+    request_.append(extra_headers_).append(headers);
+
+    if (!body.empty())
+    {
+        request_.append("Content-Type: ").append(content_type).append("\r\nContent-Length: ").append(std::to_string(body.size())).append("\r\n");
+    }
+
+    request_.append("\r\n").append(body);
+
+    // Uma nova tentativa só quando a conexão reaproveitada já tinha sido fechada pelo servidor
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        const bool reused = socket_ >= 0;
+        if (!reused && !connect())
+            return {};
+
+        size_t sent = 0;
+        while (sent < request_.size())
+        {
+            const auto written = ::send(socket_, request_.data() + sent, request_.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                break;
+
+            sent += static_cast<size_t>(written);
+        }
+
+        HttpResponse response;
+        if (sent == request_.size() && read_response(response))
+            return response;
+
+        close();
+
+        if (!reused)
+            break;
+    }
+
+    return {};
+}
+
+} // namespace lynx::bench
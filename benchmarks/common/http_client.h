@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lynx::bench
+{
+
+struct HttpResponse
+{
+    int status = 0; // 0: falha de conexão/leitura
+    std::string body;
+};
+
+/*
+ * Cliente HTTP/1.1 mínimo sobre um socket bloqueante em loopback, com keep-alive: uma requisição por
+ * vez, como um navegador numa conexão. Reconecta sozinho quando o servidor fecha a conexão.
+ */
+class HttpClient
+{
+private:
+    uint16_t port_;
+    std::chrono::milliseconds timeout_;
+    std::string extra_headers_;
+    int socket_ = -1;
+
+    std::string request_;
+    std::string buffer_; // bytes lidos e ainda não consumidos
+
+    auto connect() -> bool;
+    auto close() -> void;
+    auto read_more() -> bool;
+    auto read_response(HttpResponse &response) -> bool;
+
+public:
+    HttpClient(uint16_t port, std::chrono::milliseconds timeout, std::string extra_headers = {});
+    ~HttpClient();
+
+    HttpClient(const HttpClient &) = delete;
+    HttpClient &operator=(const HttpClient &) = delete;
+
+    /* headers: linhas "Nome: valor\r\n" só desta requisição, somadas às extra_headers da conexão */
+    auto send(std::string_view method, std::string_view path, std::string_view body = {},
+              std::string_view content_type = "application/json", std::string_view headers = {}) -> HttpResponse;
+};
+
+} // namespace lynx::bench
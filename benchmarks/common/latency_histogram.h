@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace lynx::bench
+{
+
+/*
+ * Histograma log-linear de latências em nanossegundos, no molde do HdrHistogram: valores abaixo de
+ * 128 ns têm balde próprio; acima disso cada potência de dois é dividida em 64 baldes, erro relativo
+ * de até 1/64 (~1,6%). Cobre até ~2^41 ns (~36 min); acima disso satura no último balde. Cada thread
+ * grava no seu e os histogramas são somados no fim.
+ */
+class LatencyHistogram
+{
+private:
+    static constexpr int sub_bits_ = 6;
+    static constexpr int64_t linear_limit_ = int64_t{1} << (sub_bits_ + 1); // 128
+    static constexpr int max_exponent_ = 41;
+    static constexpr size_t bucket_count_ = linear_limit_ + (max_exponent_ - sub_bits_) * (int64_t{1} << sub_bits_);
+
+    std::array<uint64_t, bucket_count_> counts_{};
+    uint64_t total_ = 0;
+    int64_t max_ = 0;
+
+    static auto index_of(int64_t value) -> size_t
+    {
+        if (value < linear_limit_)
+            return static_cast<size_t>(std::max<int64_t>(value, 0));
+
+        const int msb = std::bit_width(static_cast<uint64_t>(value)) - 1;
+        const int shift = msb - sub_bits_;
+        const auto index = linear_limit_ + static_cast<int64_t>(msb - sub_bits_ - 1) * (int64_t{1} << sub_bits_) +
+                           ((value >> shift) - (int64_t{1} << sub_bits_));
+
+        return std::min(static_cast<size_t>(index), bucket_count_ - 1);
+    }
+
+    // Maior valor que cai no balde: percentis nunca saem otimistas
+    static auto highest_of(size_t index) -> int64_t
+    {
+        if (static_cast<int64_t>(index) < linear_limit_)
+            return static_cast<int64_t>(index);
+
+        const auto offset = static_cast<int64_t>(index) - linear_limit_;
+        const int shift = static_cast<int>(offset >> sub_bits_) + 1;
+        const auto mantissa = (int64_t{1} << sub_bits_) + (offset & ((int64_t{1} << sub_bits_) - 1));
+
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+public:
+    auto record(std::chrono::nanoseconds latency) -> void
+    {
+        const auto value = latency.count();
+
+        ++counts_[index_of(value)];
+        ++total_;
+        max_ = std::max(max_, value);
+    }
+
+    auto merge(const LatencyHistogram &other) -> void
+    {
+        for (size_t i = 0; i < bucket_count_; ++i)
+            counts_[i] += other.counts_[i];
+
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    auto count() const -> uint64_t
+    {
+        return total_;
+    }
+
+    auto max() const -> std::chrono::nanoseconds
+    {
+        return std::chrono::nanoseconds(max_);
+    }
+
+    /* quantile em [0, 1]; 0 sem amostras */
+    auto percentile(double quantile) const -> std::chrono::nanoseconds
+    {
+        if (total_ == 0)
+            return std::chrono::nanoseconds(0);
+
+        const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(total_))));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count_; ++i)
+        {
+            seen += counts_[i];
+            if (seen >= target)
+                return std::chrono::nanoseconds(std::min(highest_of(i), max_));
+        }
+
+        return std::chrono::nanoseconds(max_);
+    }
+};
+
+} // namespace lynx::bench
@@ -0,0 +1,136 @@
+/*
+ * Vazão do caminho de erro de GET /api/products/<id> com produto inexistente: o caminho antigo
+ * (NotFoundError lançado no service, capturado no controller, corpo montado com ostringstream)
+ * contra o Result devolvido pelo ProductServices. Uso: error_path_bench [threads] [requisições por thread]
+ */
+
+#include "errors/http_handle_error.h"
+#include "services/product_services.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// Repositório vazio: toda busca é um 404
+class EmptyProductRepository : public lynx::repository::interface::IProductRepository
+{
+public:
+    auto create(lynx::models::Product &) -> void override
+    {
+    }
+
+    auto find_product_by_id(int) -> std::optional<lynx::models::Product> override
+    {
+        return std::nullopt;
+    }
+
+    auto find_all(const lynx::models::ProductFilters &) -> std::vector<lynx::models::Product> override
+    {
+        return {};
+    }
+
+    auto update(const int &, const std::optional<lynx::models::Product> &) -> lynx::errors::Result<void> override
+    {
+        return {};
+    }
+
+    auto remove(int) -> void override
+    {
+    }
+};
+
+// Como era o to_json do CustomError antes do Result
+auto legacy_to_json(const lynx::exceptions::CustomError &e) -> std::string
+{
+    std::ostringstream oss;
+    oss << "{"
+        << "\"error\":\"" << e.name() << "\","
+        << "\"message\":\"" << e.what() << "\","
+        << "\"statusCode\":" << static_cast<int>(e.status_code()) << "}";
+    return oss.str();
+}
+
+// Como era o ProductServices::get_product_by_id antes do Result; noinline para o throw cruzar um frame de verdade
+[[gnu::noinline]] auto legacy_get_product_by_id(lynx::repository::interface::IProductRepository &repository, int id)
+    -> lynx::models::dto::ProductResponseDTO
+{
+    auto product = repository.find_product_by_id(id);
+    if (!product)
+        throw lynx::exceptions::NotFoundError("Product not found");
+
+    return {product->id, product->name, product->category, product->price_cents, product->active, product->stock};
+}
+
+auto with_exceptions(lynx::repository::interface::IProductRepository &repository, int id) -> size_t
+{
+    try
+    {
+        return legacy_get_product_by_id(repository, id).name.size();
+    }
+    catch (const lynx::exceptions::CustomError &e)
+    {
+        return legacy_to_json(e).size();
+    }
+}
+
+auto with_result(lynx::services::ProductServices &services, int id) -> size_t
+{
+    auto product = services.get_product_by_id(id);
+    if (!product)
+        return product.error().to_json().size();
+
+    return product->name.size();
+}
+
+template <typename Handle> auto run(const char *name, unsigned threads, int requests, Handle &&handle) -> void
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&] {
+            size_t bytes = 0;
+            for (int i = 0; i < requests; ++i)
+            {
+                bytes += handle(i);
+            }
+
+            if (bytes == 0)
+                std::abort();
+        });
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto total = static_cast<double>(threads) * requests;
+
+    std::cout << name << ": " << static_cast<uint64_t>(total / elapsed) << " erros/s, " << elapsed / total * 1e9 << " ns/erro\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 1;
+    const int requests = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    auto repository = std::make_shared<EmptyProductRepository>();
+    lynx::services::ProductServices services(repository);
+
+    std::cout << threads << " thread(s), " << requests << " 404s por thread\n";
+    run("throw + ostringstream", threads, requests, [&](int id) { return with_exceptions(*repository, id); });
+    run("Result + error_json  ", threads, requests, [&](int id) { return with_result(services, id); });
+
+    return 0;
+}
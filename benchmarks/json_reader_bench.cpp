@@ -0,0 +1,111 @@
+/*
+ * Compara a leitura do corpo de criação de pedido pelo crow::json::load (caminho antigo do controller)
+ * com o JsonReader. Uso: json_reader_bench [itens] [iterações]
+ */
+
+#include "models/dtos/dto_json.h"
+#include <crow.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> allocations{0};
+
+auto build_body(size_t items) -> std::string
+{
+    lynx::models::dto::OrderCreateDTO order{42, {}};
+    order.items.reserve(items);
+
+    for (size_t i = 0; i < items; ++i)
+    {
+        order.items.push_back({static_cast<int>(i % 500 + 1), static_cast<int>(i % 7 + 1)});
+    }
+
+    utils::json::JsonWriter writer;
+    utils::json::write(writer, order);
+    return writer.take();
+}
+
+auto with_crow(const std::string &body) -> lynx::models::dto::OrderCreateDTO
+{
+    lynx::models::dto::OrderCreateDTO dto;
+
+    auto json = crow::json::load(body);
+    if (!json || !json.has("customer_id") || !json.has("items"))
+        std::abort();
+
+    dto.customer_id = json["customer_id"].i();
+    for (const auto &jitem : json["items"])
+    {
+        lynx::models::dto::OrderItemDTO item_dto;
+        item_dto.product_id = jitem["product_id"].i();
+        item_dto.quantity = jitem["quantity"].i();
+        dto.items.push_back(item_dto);
+    }
+
+    return dto;
+}
+
+auto with_reader(const std::string &body) -> lynx::models::dto::OrderCreateDTO
+{
+    return utils::json::parse<lynx::models::dto::OrderCreateDTO>(body);
+}
+
+template <typename Parse> auto run(const char *name, Parse &&parse, int iterations) -> void
+{
+    size_t items = parse().items.size();
+
+    const auto allocations_before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        items = parse().items.size();
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto per_call = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+
+    std::cout << name << ": " << per_call / 1000.0 << " us/corpo, " << (allocations.load() - allocations_before) / iterations
+              << " alocações/corpo, " << items << " itens\n";
+}
+
+} // namespace
+
+auto operator new(size_t size) -> void *
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+auto operator delete(void *p) noexcept -> void
+{
+    std::free(p);
+}
+
+auto operator delete(void *p, size_t) noexcept -> void
+{
+    std::free(p);
+}
+
+int main(int argc, char **argv)
+{
+    const size_t items = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    const auto body = build_body(items);
+
+    std::cout << items << " itens (" << body.size() << " bytes), " << iterations << " iterações\n";
+    run("crow::json::load", [&] { return with_crow(body); }, iterations);
+    run("JsonReader      ", [&] { return with_reader(body); }, iterations);
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Compara a serialização do resumo de pedidos pelo crow::json::wvalue (caminho antigo dos controllers)
+ * com o JsonWriter. Uso: json_writer_bench [linhas] [iterações]
+ */
+
+#include "models/dtos/dto_json.h"
+#include "utils/time/time_format.h"
+#include <crow.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> allocations{0};
+
+auto build_orders(size_t rows) -> std::vector<lynx::models::dto::OrderSummaryDTO>
+{
+    std::vector<lynx::models::dto::OrderSummaryDTO> orders;
+    orders.reserve(rows);
+
+    const auto now = std::chrono::system_clock::now();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        orders.push_back({id, id % 500 + 1, i % 3 == 0 ? "PAID" : "NEW", now - std::chrono::minutes(i), 1999 + 100 * static_cast<int64_t>(i % 50),
+                          i % 3 == 0 ? 1999 : 0});
+    }
+
+    return orders;
+}
+
+auto with_wvalue(const std::vector<lynx::models::dto::OrderSummaryDTO> &orders) -> std::string
+{
+    crow::json::wvalue res = crow::json::wvalue::list();
+    for (size_t i = 0; i < orders.size(); ++i)
+    {
+        const auto &order = orders[i];
+        res[i]["id"] = order.id;
+        res[i]["customer_id"] = order.customer_id;
+        res[i]["status"] = order.status;
+        res[i]["created_at"] = utils::time::format_time(order.created_at, utils::time::TimeFormat::iso8601);
+        res[i]["total_cents"] = order.total_cents;
+        res[i]["total_paid_cents"] = order.total_paid_cents;
+    }
+
+    return res.dump();
+}
+
+auto with_writer(const std::vector<lynx::models::dto::OrderSummaryDTO> &orders) -> std::string
+{
+    utils::json::JsonWriter writer(2 + orders.size() * 144);
+    utils::json::write(writer, orders);
+    return writer.take();
+}
+
+template <typename Serialize> auto run(const char *name, Serialize &&serialize, int iterations) -> void
+{
+    size_t bytes = serialize().size();
+
+    const auto allocations_before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        bytes = serialize().size();
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto per_call = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / iterations;
+
+    std::cout << name << ": " << per_call << " us/resposta, " << (allocations.load() - allocations_before) / iterations
+              << " alocações/resposta, " << bytes << " bytes\n";
+}
+
+} // namespace
+
+auto operator new(size_t size) -> void *
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+auto operator delete(void *p) noexcept -> void
+{
+    std::free(p);
+}
+
+auto operator delete(void *p, size_t) noexcept -> void
+{
+    std::free(p);
+}
+
+int main(int argc, char **argv)
+{
+    const size_t rows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    const auto orders = build_orders(rows);
+
+    std::cout << rows << " pedidos, " << iterations << " iterações\n";
+    run("crow::json::wvalue", [&] { return with_wvalue(orders); }, iterations);
+    run("JsonWriter        ", [&] { return with_writer(orders); }, iterations);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "utils/convert.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+namespace
+{
+
+constexpr std::array<const char *, 13> category_names_ = {"KITCHEN", "ELECTRONICS", "HOME", "CLEANING", "FOOD",     "BEVERAGES", "PERSONAL_CARE",
+                                                           "PETS",    "TOOLS",       "OFFICE", "TOYS",   "CLOTHING", "OTHER"};
+
+// Todas as categorias em rodízio: as do fim da cadeia de ifs custam mais
+void BM_StringToCategory(benchmark::State &state)
+{
+    const std::vector<std::string> names(category_names_.begin(), category_names_.end());
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::string_to_category(names[i++ % names.size()]));
+    }
+}
+BENCHMARK(BM_StringToCategory);
+
+void BM_CategoryToString(benchmark::State &state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::category_to_string(static_cast<lynx::models::Category>(i++ % 13)));
+    }
+}
+BENCHMARK(BM_CategoryToString);
+
+void BM_OrderStatusRoundTrip(benchmark::State &state)
+{
+    const std::array<std::string, 3> names = {"NEW", "PAID", "CANCELLED"};
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto status = utils::string_to_order_status(names[i++ % names.size()]);
+        benchmark::DoNotOptimize(utils::order_status_to_string(status));
+    }
+}
+BENCHMARK(BM_OrderStatusRoundTrip);
+
+void BM_PaymentMethodRoundTrip(benchmark::State &state)
+{
+    const std::array<std::string, 3> names = {"PIX", "CARD", "BOLETO"};
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto method = utils::string_to_payment_method(names[i++ % names.size()]);
+        benchmark::DoNotOptimize(utils::payment_method_to_string(method));
+    }
+}
+BENCHMARK(BM_PaymentMethodRoundTrip);
+
+void BM_StringToIntOrThrow(benchmark::State &state)
+{
+    const std::array<std::string, 4> texts = {"7", "1234", "98765", "2147483647"};
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::string_to_int_or_throw(texts[i++ % texts.size()]));
+    }
+}
+BENCHMARK(BM_StringToIntOrThrow);
+
+// Parâmetro de query inválido: o custo do throw/catch do caminho de erro
+void BM_StringToIntOrThrowInvalid(benchmark::State &state)
+{
+    const std::string text = "12abc";
+
+    for (auto _ : state)
+    {
+        try
+        {
+            benchmark::DoNotOptimize(utils::string_to_int_or_throw(text));
+        }
+        catch (const lynx::exceptions::BadRequestError &e)
+        {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_StringToIntOrThrowInvalid);
+
+void BM_IdsToJsonArray(benchmark::State &state)
+{
+    std::vector<int> ids(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < ids.size(); ++i)
+        ids[i] = static_cast<int>(100000 + i * 7);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::ids_to_json_array(ids));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IdsToJsonArray)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
@@ -0,0 +1,43 @@
+/*
+ * Suíte Google Benchmark dos caminhos quentes da API: conversões de utils/convert.h, utils::time,
+ * cada método dos repositórios SQLite sobre um banco temporário semeado, conversão para DTO nos
+ * services e serialização JSON das respostas típicas.
+ *
+ * Para comparar commits, grave o JSON de cada um e use o tools/compare.py do Google Benchmark:
+ *   lynx_bench --benchmark_out=antes.json --benchmark_out_format=json
+ *   compare.py benchmarks antes.json depois.json
+ */
+
+#include "bench_database.h"
+#include "lynx_git_commit.h"
+
+#include <benchmark/benchmark.h>
+
+#include <exception>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::AddCustomContext("git_commit", LYNX_GIT_COMMIT);
+
+    try
+    {
+        lynx::bench::open_temp_database();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Falha ao preparar o banco temporário: " << e.what() << "\n";
+        lynx::bench::remove_temp_database();
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    lynx::bench::remove_temp_database();
+    return 0;
+}
@@ -0,0 +1,574 @@
+/*
+ * Cada método dos repositórios SQLite contra o banco temporário semeado (bench_database.h). Os que
+ * gravam devolvem o banco ao estado do seed ao terminar, para um benchmark não mudar o volume que o
+ * próximo enxerga; preparação por iteração (linha a remover, pagamento a reabrir) fica fora do tempo
+ * medido com PauseTiming. find_all, update e remove de clientes e update e remove de pedidos ainda não têm
+ * implementação e ficam de fora.
+ */
+
+#include "bench_database.h"
+#include "repository/customer_repository.h"
+#include "repository/inventory_repository.h"
+#include "repository/order_item_repository.h"
+#include "repository/order_repository.h"
+#include "repository/payment_repository.h"
+#include "repository/product_repository.h"
+#include "utils/convert.h"
+#include "utils/time/time_format.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+namespace
+{
+
+using lynx::bench::Dataset;
+using lynx::bench::exec;
+using lynx::bench::seeded_ids;
+
+// Ids espalhados pela tabela, sem seguir a ordem de inserção
+auto spread_id(size_t i, int count) -> int
+{
+    return static_cast<int>((i * 7919) % static_cast<size_t>(count)) + 1;
+}
+
+auto first_ids(const std::vector<int> &ids, int64_t count) -> std::vector<int>
+{
+    return {ids.begin(), ids.begin() + std::min<int64_t>(count, static_cast<int64_t>(ids.size()))};
+}
+
+auto sample_order() -> lynx::models::Order
+{
+    lynx::models::Order order{};
+    order.customer_id = 42;
+    order.status = lynx::models::OrderStatus::NEW;
+    order.created_at = std::chrono::system_clock::now();
+    order.items = {{0, 0, 11, 2, 606}, {0, 0, 24, 1, 1087}, {0, 0, 37, 3, 1568}};
+    return order;
+}
+
+/* Customers */
+
+void BM_CustomerRepository_Create(benchmark::State &state)
+{
+    lynx::repository::CustomerRepository repository;
+
+    int64_t sequence = 0;
+    for (auto _ : state)
+    {
+        lynx::models::Customer customer{0, "Cliente Bench", "bench" + std::to_string(sequence++) + "@lynx.dev", std::chrono::system_clock::now()};
+        repository.create(customer);
+    }
+
+    exec("DELETE FROM customers WHERE id > " + std::to_string(Dataset::customers_));
+}
+BENCHMARK(BM_CustomerRepository_Create);
+
+void BM_CustomerRepository_FindById(benchmark::State &state)
+{
+    lynx::repository::CustomerRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_by_id(spread_id(i++, Dataset::customers_)));
+    }
+}
+BENCHMARK(BM_CustomerRepository_FindById);
+
+void BM_CustomerRepository_FindByEmail(benchmark::State &state)
+{
+    lynx::repository::CustomerRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_by_email("cliente" + std::to_string(spread_id(i++, Dataset::customers_)) + "@lynx.dev"));
+    }
+}
+BENCHMARK(BM_CustomerRepository_FindByEmail);
+
+/* Products */
+
+void BM_ProductRepository_Create(benchmark::State &state)
+{
+    lynx::repository::ProductRepository repository;
+
+    for (auto _ : state)
+    {
+        lynx::models::Product product{0, "Produto Bench", lynx::models::Category::TOOLS, 4990, true, 10};
+        repository.create(product);
+    }
+
+    exec("DELETE FROM products WHERE id > " + std::to_string(Dataset::products_));
+}
+BENCHMARK(BM_ProductRepository_Create);
+
+void BM_ProductRepository_FindById(benchmark::State &state)
+{
+    lynx::repository::ProductRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_product_by_id(spread_id(i++, Dataset::products_)));
+    }
+}
+BENCHMARK(BM_ProductRepository_FindById);
+
+// 0: sem filtro (todo o catálogo); 1: categoria + ativos; 2: faixa de preço
+void BM_ProductRepository_FindAll(benchmark::State &state)
+{
+    lynx::repository::ProductRepository repository;
+
+    lynx::models::ProductFilters filters;
+    if (state.range(0) == 1)
+    {
+        filters.category = lynx::models::Category::ELECTRONICS;
+        filters.active = true;
+    }
+    else if (state.range(0) == 2)
+    {
+        filters.min_price_cents = 10000;
+        filters.max_price_cents = 15000;
+    }
+
+    size_t rows = 0;
+    for (auto _ : state)
+    {
+        const auto products = repository.find_all(filters);
+        rows = products.size();
+        benchmark::DoNotOptimize(products.data());
+    }
+
+    state.counters["rows"] = static_cast<double>(rows);
+}
+BENCHMARK(BM_ProductRepository_FindAll)->ArgName("filter")->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+
+// Regrava os mesmos valores: o custo do UPDATE sem mudar o estado
+void BM_ProductRepository_Update(benchmark::State &state)
+{
+    lynx::repository::ProductRepository repository;
+
+    std::vector<std::optional<lynx::models::Product>> products;
+    for (size_t i = 0; i < 256; ++i)
+        products.push_back(repository.find_product_by_id(spread_id(i, Dataset::products_)));
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto &product = products[i++ % products.size()];
+        benchmark::DoNotOptimize(repository.update(product->id, product).has_value());
+    }
+}
+BENCHMARK(BM_ProductRepository_Update);
+
+void BM_ProductRepository_Remove(benchmark::State &state)
+{
+    lynx::repository::ProductRepository repository;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        lynx::models::Product product{0, "Produto Bench", lynx::models::Category::TOOLS, 4990, true, 10};
+        repository.create(product);
+        state.ResumeTiming();
+
+        repository.remove(product.id);
+    }
+}
+BENCHMARK(BM_ProductRepository_Remove);
+
+/* Orders */
+
+void BM_OrderRepository_Create(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    for (auto _ : state)
+    {
+        auto order = sample_order();
+        repository.create(order);
+    }
+
+    exec("DELETE FROM order_items WHERE order_id > " + std::to_string(Dataset::orders_) + ";" +
+         "DELETE FROM orders WHERE id > " + std::to_string(Dataset::orders_) + ";");
+}
+BENCHMARK(BM_OrderRepository_Create);
+
+void BM_OrderRepository_FindById(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_by_id(spread_id(i++, Dataset::orders_)));
+    }
+}
+BENCHMARK(BM_OrderRepository_FindById);
+
+void BM_OrderRepository_FindByIdWithCustomer(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_by_id_with_customer(spread_id(i++, Dataset::orders_)));
+    }
+}
+BENCHMARK(BM_OrderRepository_FindByIdWithCustomer);
+
+void BM_OrderRepository_FindAll(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_all());
+    }
+
+    state.SetItemsProcessed(state.iterations() * Dataset::orders_);
+}
+BENCHMARK(BM_OrderRepository_FindAll)->Unit(benchmark::kMillisecond);
+
+void BM_OrderRepository_FindPendingDeadlines(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_pending_deadlines());
+    }
+}
+BENCHMARK(BM_OrderRepository_FindPendingDeadlines)->Unit(benchmark::kMicrosecond);
+
+// Regrava o status atual (NEW) de pedidos em aberto
+void BM_OrderRepository_UpdateStatus(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+    const auto &ids = seeded_ids().new_orders;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.update_status(ids[i++ % ids.size()], lynx::models::OrderStatus::NEW).has_value());
+    }
+}
+BENCHMARK(BM_OrderRepository_UpdateStatus);
+
+// Lote de pedidos quitados que viram PAID; cada iteração começa com eles de volta em NEW
+void BM_OrderRepository_MarkSettledAsPaid(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    const auto ids = first_ids(seeded_ids().settled_orders, state.range(0));
+    const auto reopen = "UPDATE orders SET status = 'NEW' WHERE id IN (SELECT value FROM json_each('" + utils::ids_to_json_array(ids) + "'))";
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        exec(reopen);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(repository.mark_settled_as_paid(ids));
+    }
+
+    exec(reopen);
+}
+BENCHMARK(BM_OrderRepository_MarkSettledAsPaid)->Arg(1)->Arg(64);
+
+void BM_OrderRepository_CancelExpired(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    const auto ids = first_ids(seeded_ids().new_orders, state.range(0));
+    const auto reopen = "UPDATE orders SET status = 'NEW' WHERE id IN (SELECT value FROM json_each('" + utils::ids_to_json_array(ids) + "'))";
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        exec(reopen);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(repository.cancel_expired(ids, std::chrono::system_clock::now()));
+    }
+
+    exec(reopen);
+}
+BENCHMARK(BM_OrderRepository_CancelExpired)->Arg(1)->Arg(64);
+
+void BM_OrderRepository_FindItemsByOrderId(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_items_by_order_id(spread_id(i++, Dataset::orders_)));
+    }
+}
+BENCHMARK(BM_OrderRepository_FindItemsByOrderId);
+
+void BM_OrderRepository_SumItemsTotalByOrder(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.sum_items_total_by_order(spread_id(i++, Dataset::orders_)));
+    }
+}
+BENCHMARK(BM_OrderRepository_SumItemsTotalByOrder);
+
+// 0: sem filtro; 1: por status; 2: por cliente. Todas com o limite padrão da listagem (100)
+void BM_OrderRepository_FindAllSummary(benchmark::State &state)
+{
+    lynx::repository::OrderRepository repository;
+
+    std::optional<std::string> status;
+    std::optional<int> customer_id;
+    if (state.range(0) == 1)
+        status = "PAID";
+    else if (state.range(0) == 2)
+        customer_id = 42;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_all_summary(status, customer_id, 100));
+    }
+}
+BENCHMARK(BM_OrderRepository_FindAllSummary)->ArgName("filter")->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+
+/* Order items */
+
+void BM_OrderItemRepository_Create(benchmark::State &state)
+{
+    lynx::repository::OrderItemRepository repository;
+
+    for (auto _ : state)
+    {
+        repository.create({0, 1, 11, 1, 606});
+    }
+
+    exec("DELETE FROM order_items WHERE id > " + std::to_string(Dataset::orders_ * Dataset::items_per_order_));
+}
+BENCHMARK(BM_OrderItemRepository_Create);
+
+void BM_OrderItemRepository_FindByOrderId(benchmark::State &state)
+{
+    lynx::repository::OrderItemRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        int order_id = spread_id(i++, Dataset::orders_);
+        benchmark::DoNotOptimize(repository.find_by_order_id(order_id));
+    }
+}
+BENCHMARK(BM_OrderItemRepository_FindByOrderId);
+
+/* Payments */
+
+void BM_PaymentRepository_Create(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+
+    int64_t payments = 0;
+    for (auto _ : state)
+    {
+        lynx::models::Payment payment{0, 42, lynx::models::PaymentMethod::PIX, 4990, std::nullopt};
+        repository.create(payment);
+        ++payments;
+    }
+
+    exec("DELETE FROM payments WHERE id IN (SELECT id FROM payments ORDER BY id DESC LIMIT " + std::to_string(payments) + ")");
+}
+BENCHMARK(BM_PaymentRepository_Create);
+
+void BM_PaymentRepository_FindById(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+    const auto &ids = seeded_ids().open_payments;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_by_id(ids[(i++ * 7919) % ids.size()]));
+    }
+}
+BENCHMARK(BM_PaymentRepository_FindById);
+
+// 0: primeira página sem filtro; 1: por método e período; 2: por pedido
+void BM_PaymentRepository_FindAll(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+
+    lynx::models::PaymentFilters filters;
+    if (state.range(0) == 1)
+    {
+        const auto now = std::chrono::system_clock::now();
+        filters.method = lynx::models::PaymentMethod::CARD;
+        filters.paid_from = now - std::chrono::hours(72);
+        filters.paid_to = now;
+    }
+    else if (state.range(0) == 2)
+    {
+        filters.order_id = 3000;
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_all(filters));
+    }
+}
+BENCHMARK(BM_PaymentRepository_FindAll)->ArgName("filter")->DenseRange(0, 2)->Unit(benchmark::kMicrosecond);
+
+void BM_PaymentRepository_SumByOrder(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.sum_by_order(spread_id(i++, Dataset::orders_)));
+    }
+}
+BENCHMARK(BM_PaymentRepository_SumByOrder);
+
+void BM_PaymentRepository_MarkAsPaid(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+    const auto &ids = seeded_ids().open_payments;
+    const auto paid_at = utils::time::format_time(std::chrono::system_clock::now(), utils::time::TimeFormat::sql);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        repository.mark_as_paid(ids[i++ % ids.size()], paid_at);
+    }
+
+    exec("UPDATE payments SET paid_at = NULL WHERE id IN (SELECT value FROM json_each('" + utils::ids_to_json_array(ids) + "'))");
+}
+BENCHMARK(BM_PaymentRepository_MarkAsPaid);
+
+// Lote de confirmações do arquivo de conciliação; os pagamentos voltam a ficar em aberto antes de cada iteração
+void BM_PaymentRepository_MarkAsPaidBatch(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+
+    const auto ids = first_ids(seeded_ids().open_payments, state.range(0));
+    const auto paid_at = utils::time::format_time(std::chrono::system_clock::now(), utils::time::TimeFormat::sql);
+    const auto reopen = "UPDATE payments SET paid_at = NULL WHERE id IN (SELECT value FROM json_each('" + utils::ids_to_json_array(ids) + "'))";
+
+    std::vector<lynx::models::PaymentConfirmation> confirmations;
+    for (const int id : ids)
+        confirmations.push_back({id, paid_at});
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        exec(reopen);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(repository.mark_as_paid_batch(confirmations));
+    }
+
+    exec(reopen);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PaymentRepository_MarkAsPaidBatch)->Arg(1)->Arg(64)->Arg(512);
+
+void BM_PaymentRepository_Update(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+    const auto &ids = seeded_ids().open_payments;
+
+    std::vector<lynx::models::Payment> payments;
+    for (size_t i = 0; i < 256; ++i)
+        payments.push_back(*repository.find_by_id(ids[(i * 7919) % ids.size()]));
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto &payment = payments[i++ % payments.size()];
+        repository.update(payment.id, payment);
+    }
+}
+BENCHMARK(BM_PaymentRepository_Update);
+
+void BM_PaymentRepository_Remove(benchmark::State &state)
+{
+    lynx::repository::PaymentRepository repository;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        lynx::models::Payment payment{0, 42, lynx::models::PaymentMethod::PIX, 4990, std::nullopt};
+        repository.create(payment);
+        state.ResumeTiming();
+
+        repository.remove(payment.id);
+    }
+}
+BENCHMARK(BM_PaymentRepository_Remove);
+
+/* Inventory */
+
+void BM_InventoryRepository_FindStock(benchmark::State &state)
+{
+    lynx::repository::InventoryRepository repository;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_stock(spread_id(i++, Dataset::products_)));
+    }
+}
+BENCHMARK(BM_InventoryRepository_FindStock);
+
+void BM_InventoryRepository_FindAllStock(benchmark::State &state)
+{
+    lynx::repository::InventoryRepository repository;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.find_all_stock());
+    }
+
+    state.SetItemsProcessed(state.iterations() * Dataset::products_);
+}
+BENCHMARK(BM_InventoryRepository_FindAllStock)->Unit(benchmark::kMicrosecond);
+
+void BM_InventoryRepository_SumItemsByOrders(benchmark::State &state)
+{
+    lynx::repository::InventoryRepository repository;
+    const auto ids = first_ids(seeded_ids().new_orders, state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(repository.sum_items_by_orders(ids));
+    }
+}
+BENCHMARK(BM_InventoryRepository_SumItemsByOrders)->Arg(1)->Arg(64);
+
+// Ciclo do write-back sem vendas novas desde o checkpoint, devolvendo estoque de pedidos cancelados
+void BM_InventoryRepository_WriteBack(benchmark::State &state)
+{
+    lynx::repository::InventoryRepository repository;
+
+    std::vector<lynx::models::StockDelta> restocks;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        restocks.push_back({spread_id(static_cast<size_t>(i), Dataset::products_), 0});
+
+    for (auto _ : state)
+    {
+        repository.write_back(restocks);
+    }
+}
+BENCHMARK(BM_InventoryRepository_WriteBack)->Arg(0)->Arg(16);
+
+} // namespace
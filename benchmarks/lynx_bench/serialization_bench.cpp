@@ -0,0 +1,167 @@
+/*
+ * Serialização JSON das respostas típicas pelo JsonWriter, com a mesma reserva de buffer usada nos
+ * controllers: listagem de produtos, resumo de pedidos, detalhe de pedido, clientes e página de pagamentos.
+ * A listagem de produtos também é medida pelo ProductFragmentStore, com todos os fragmentos já prontos.
+ */
+
+#include "cache/product_fragment_store.h"
+#include "models/dtos/dto_json.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+using Clock = std::chrono::system_clock;
+
+const auto base_time_ = Clock::from_time_t(1'700'000'000);
+
+auto build_products(size_t count) -> std::vector<lynx::models::dto::ProductResponseDTO>
+{
+    std::vector<lynx::models::dto::ProductResponseDTO> products;
+    products.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        products.push_back({id, "Produto " + std::to_string(id), static_cast<lynx::models::Category>(i % 13), 199 + id * 37 % 50000, i % 10 != 0,
+                            100 + id % 400});
+    }
+    return products;
+}
+
+auto build_summaries(size_t count) -> std::vector<lynx::models::dto::OrderSummaryDTO>
+{
+    std::vector<lynx::models::dto::OrderSummaryDTO> orders;
+    orders.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        orders.push_back({id, id % 1000 + 1, i % 3 == 0 ? "PAID" : "NEW", base_time_ - std::chrono::minutes(id), 1999 + 100 * static_cast<int64_t>(i % 50),
+                          i % 3 == 0 ? 1999 : 0});
+    }
+    return orders;
+}
+
+auto build_customers(size_t count) -> std::vector<lynx::models::dto::CustomerResponseDTO>
+{
+    std::vector<lynx::models::dto::CustomerResponseDTO> customers;
+    customers.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        customers.push_back({id, "Cliente " + std::to_string(id), "cliente" + std::to_string(id) + "@lynx.dev", base_time_ - std::chrono::hours(id)});
+    }
+    return customers;
+}
+
+void BM_SerializeProducts(benchmark::State &state)
+{
+    const auto products = build_products(static_cast<size_t>(state.range(0)));
+
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        utils::json::JsonWriter writer(2 + products.size() * 112);
+        utils::json::write(writer, products);
+        bytes = writer.buffer().size();
+        benchmark::DoNotOptimize(writer.take());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_SerializeProducts)->Arg(1)->Arg(100)->Arg(5000)->Arg(50000);
+
+// Mesmo corpo que BM_SerializeProducts, montado com os fragmentos gerados antes do laço
+void BM_SerializeProductsFragments(benchmark::State &state)
+{
+    const auto products = build_products(static_cast<size_t>(state.range(0)));
+
+    lynx::cache::ProductFragmentStore fragments;
+    fragments.to_json(products);
+
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        auto body = fragments.to_json(products);
+        bytes = body.size();
+        benchmark::DoNotOptimize(body);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_SerializeProductsFragments)->Arg(1)->Arg(100)->Arg(5000)->Arg(50000);
+
+void BM_SerializeOrderSummary(benchmark::State &state)
+{
+    const auto orders = build_summaries(static_cast<size_t>(state.range(0)));
+
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        utils::json::JsonWriter writer(2 + orders.size() * 144);
+        utils::json::write(writer, orders);
+        bytes = writer.buffer().size();
+        benchmark::DoNotOptimize(writer.take());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_SerializeOrderSummary)->Arg(100)->Arg(1000);
+
+void BM_SerializeOrderDetails(benchmark::State &state)
+{
+    lynx::models::dto::OrderDetailsResponseDTO order{4711, 42, "NEW", base_time_, {}, 0};
+    for (int k = 0; k < 3; ++k)
+    {
+        const int product_id = 11 + k * 13;
+        order.items.push_back({product_id, "Produto " + std::to_string(product_id), k + 1, 606 + k * 481, (k + 1) * (606 + k * 481)});
+        order.total_cents += order.items.back().subtotal_cents;
+    }
+
+    for (auto _ : state)
+    {
+        utils::json::JsonWriter writer(160 + order.items.size() * 128);
+        utils::json::write(writer, order);
+        benchmark::DoNotOptimize(writer.take());
+    }
+}
+BENCHMARK(BM_SerializeOrderDetails);
+
+void BM_SerializeCustomers(benchmark::State &state)
+{
+    const auto customers = build_customers(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        utils::json::JsonWriter writer(2 + customers.size() * 128);
+        utils::json::write(writer, customers);
+        benchmark::DoNotOptimize(writer.take());
+    }
+}
+BENCHMARK(BM_SerializeCustomers)->Arg(1)->Arg(1000);
+
+void BM_SerializePaymentPage(benchmark::State &state)
+{
+    std::vector<lynx::models::dto::PaymentResponseDTO> payments;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        std::optional<Clock::time_point> paid_at;
+        if (i % 3 != 0)
+            paid_at = base_time_ - std::chrono::minutes(id);
+
+        payments.push_back({id, id, static_cast<lynx::models::PaymentMethod>(i % 3), 1999 + id % 5000, paid_at});
+    }
+
+    for (auto _ : state)
+    {
+        utils::json::JsonWriter writer(32 + payments.size() * 112);
+        writer.begin_object().key("data");
+        utils::json::write(writer, payments);
+        writer.key("next_cursor").null().end_object();
+        benchmark::DoNotOptimize(writer.take());
+    }
+}
+BENCHMARK(BM_SerializePaymentPage)->Arg(100)->Arg(1000);
+
+} // namespace
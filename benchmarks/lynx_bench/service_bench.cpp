@@ -0,0 +1,326 @@
+/*
+ * Conversão modelo -> DTO nos services, isolada do SQL: os repositórios são trocados por versões em
+ * memória que devolvem listas prontas, no tamanho das respostas reais. Os métodos que os services
+ * medidos não chamam ficam vazios.
+ */
+
+#include "services/customer_services.h"
+#include "services/order_services.h"
+#include "services/payment_services.h"
+#include "services/product_services.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+using Clock = std::chrono::system_clock;
+
+const auto base_time_ = Clock::from_time_t(1'700'000'000);
+
+class MemoryProductRepository final : public lynx::repository::interface::IProductRepository
+{
+private:
+    std::vector<lynx::models::Product> products_;
+
+public:
+    explicit MemoryProductRepository(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = static_cast<int>(i + 1);
+            products_.push_back({id, "Produto " + std::to_string(id), static_cast<lynx::models::Category>(i % 13), 199 + id * 37 % 50000,
+                                 i % 10 != 0, 100 + id % 400});
+        }
+    }
+
+    auto create(lynx::models::Product &) -> void override
+    {
+    }
+
+    auto find_product_by_id(int id) -> std::optional<lynx::models::Product> override
+    {
+        return products_[static_cast<size_t>(id - 1) % products_.size()];
+    }
+
+    auto find_all(const lynx::models::ProductFilters &) -> std::vector<lynx::models::Product> override
+    {
+        return products_;
+    }
+
+    auto update(const int &, const std::optional<lynx::models::Product> &) -> lynx::errors::Result<void> override
+    {
+        return {};
+    }
+
+    auto remove(int) -> void override
+    {
+    }
+};
+
+class MemoryCustomerRepository final : public lynx::repository::interface::ICustomerRepository
+{
+private:
+    std::vector<lynx::models::Customer> customers_;
+
+public:
+    explicit MemoryCustomerRepository(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = static_cast<int>(i + 1);
+            customers_.push_back({id, "Cliente " + std::to_string(id), "cliente" + std::to_string(id) + "@lynx.dev", base_time_ - std::chrono::hours(id)});
+        }
+    }
+
+    auto create(lynx::models::Customer &) -> void override
+    {
+    }
+
+    auto find_by_id(int id) -> std::optional<lynx::models::Customer> override
+    {
+        return customers_[static_cast<size_t>(id - 1) % customers_.size()];
+    }
+
+    auto find_by_email(const std::string &) -> std::optional<lynx::models::Customer> override
+    {
+        return customers_.front();
+    }
+
+    auto find_all() -> std::vector<lynx::models::Customer> override
+    {
+        return customers_;
+    }
+
+    auto update(const int &, const lynx::models::Customer &) -> void override
+    {
+    }
+
+    auto remove(int) -> void override
+    {
+    }
+};
+
+class MemoryOrderRepository final : public lynx::repository::interface::IOrderRepository
+{
+private:
+    std::vector<lynx::models::OrderSummary> summaries_;
+
+public:
+    explicit MemoryOrderRepository(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = static_cast<int>(i + 1);
+            summaries_.push_back({id, id % 1000 + 1, static_cast<lynx::models::OrderStatus>(i % 3), base_time_ - std::chrono::minutes(id),
+                                  1999 + 100 * static_cast<int64_t>(i % 50), i % 3 == 1 ? 1999 : 0});
+        }
+    }
+
+    auto create(lynx::models::Order &) -> void override
+    {
+    }
+
+    auto find_by_id(int) -> std::optional<lynx::models::Order> override
+    {
+        return std::nullopt;
+    }
+
+    auto find_all() -> std::vector<lynx::models::Order> override
+    {
+        return {};
+    }
+
+    auto find_by_id_with_customer(int) -> std::optional<lynx::models::Order> override
+    {
+        return std::nullopt;
+    }
+
+    auto find_pending_deadlines() -> std::vector<lynx::models::PendingOrder> override
+    {
+        return {};
+    }
+
+    auto update(const int &, const lynx::models::Order &) -> void override
+    {
+    }
+
+    auto update_status(int, const lynx::models::OrderStatus &) -> lynx::errors::Result<void> override
+    {
+        return {};
+    }
+
+    auto mark_settled_as_paid(const std::vector<int> &) -> std::vector<int> override
+    {
+        return {};
+    }
+
+    auto cancel_expired(const std::vector<int> &, const Clock::time_point &) -> std::vector<int> override
+    {
+        return {};
+    }
+
+    auto remove(int) -> void override
+    {
+    }
+
+    auto find_items_by_order_id(int) -> std::vector<lynx::models::OrderItem> override
+    {
+        return {};
+    }
+
+    auto sum_items_total_by_order(int) -> int64_t override
+    {
+        return 0;
+    }
+
+    auto find_all_summary(const std::optional<std::string> &, const std::optional<int> &, const std::optional<int> &limit)
+        -> std::vector<lynx::models::OrderSummary> override
+    {
+        const auto rows = std::min(summaries_.size(), static_cast<size_t>(limit.value_or(static_cast<int>(summaries_.size()))));
+        return {summaries_.begin(), summaries_.begin() + static_cast<std::ptrdiff_t>(rows)};
+    }
+};
+
+class MemoryPaymentRepository final : public lynx::repository::interface::IPaymentRepository
+{
+private:
+    std::vector<lynx::models::Payment> payments_;
+
+public:
+    explicit MemoryPaymentRepository(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto id = static_cast<int>(i + 1);
+            std::optional<Clock::time_point> paid_at;
+            if (i % 3 != 0)
+                paid_at = base_time_ - std::chrono::minutes(id);
+
+            payments_.push_back({id, id, static_cast<lynx::models::PaymentMethod>(i % 3), 1999 + id % 5000, paid_at});
+        }
+    }
+
+    auto create(lynx::models::Payment &) -> void override
+    {
+    }
+
+    auto find_by_id(int) -> std::optional<lynx::models::Payment> override
+    {
+        return std::nullopt;
+    }
+
+    // O service já pede uma linha além da página para saber se existe a próxima
+    auto find_all(const lynx::models::PaymentFilters &filters) -> std::vector<lynx::models::Payment> override
+    {
+        const auto rows = std::min(payments_.size(), static_cast<size_t>(filters.limit));
+        return {payments_.begin(), payments_.begin() + static_cast<std::ptrdiff_t>(rows)};
+    }
+
+    auto sum_by_order(int) -> int override
+    {
+        return 0;
+    }
+
+    auto mark_as_paid(int, const std::string &) -> void override
+    {
+    }
+
+    auto mark_as_paid_batch(const std::vector<lynx::models::PaymentConfirmation> &) -> std::vector<lynx::models::PaymentConfirmationResult> override
+    {
+        return {};
+    }
+
+    auto update(const int &, const lynx::models::Payment &) -> void override
+    {
+    }
+
+    auto remove(int) -> void override
+    {
+    }
+};
+
+void BM_ProductServices_GetById(benchmark::State &state)
+{
+    lynx::services::ProductServices service(std::make_shared<MemoryProductRepository>(5000));
+
+    int id = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_product_by_id(++id).has_value());
+    }
+}
+BENCHMARK(BM_ProductServices_GetById);
+
+void BM_ProductServices_GetAll(benchmark::State &state)
+{
+    lynx::services::ProductServices service(std::make_shared<MemoryProductRepository>(static_cast<size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_all_products());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProductServices_GetAll)->Arg(100)->Arg(5000);
+
+void BM_CustomerServices_GetById(benchmark::State &state)
+{
+    lynx::services::CustomerServices service(std::make_shared<MemoryCustomerRepository>(1000));
+
+    int id = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_customer_by_id(++id).has_value());
+    }
+}
+BENCHMARK(BM_CustomerServices_GetById);
+
+void BM_CustomerServices_GetAll(benchmark::State &state)
+{
+    lynx::services::CustomerServices service(std::make_shared<MemoryCustomerRepository>(1000));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_all_customers());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_CustomerServices_GetAll);
+
+// Só o resumo: ledger, expiração, estoque e cache de detalhes não participam desse caminho
+void BM_OrderServices_GetAllSummary(benchmark::State &state)
+{
+    lynx::services::OrderServices service(std::make_shared<MemoryOrderRepository>(20000), std::make_shared<MemoryProductRepository>(1),
+                                          std::make_shared<MemoryCustomerRepository>(1), nullptr, nullptr, nullptr, nullptr);
+
+    const std::optional<int> limit = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_all_orders_summary(std::nullopt, std::nullopt, limit));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OrderServices_GetAllSummary)->Arg(100)->Arg(1000);
+
+void BM_PaymentServices_GetAllPayments(benchmark::State &state)
+{
+    lynx::services::PaymentServices service(std::make_shared<MemoryPaymentRepository>(5000), nullptr, nullptr);
+
+    lynx::models::PaymentFilters filters;
+    filters.limit = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(service.get_all_payments(filters).has_value());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PaymentServices_GetAllPayments)->Arg(100)->Arg(500);
+
+} // namespace
@@ -0,0 +1,90 @@
+#include "utils/time/time_format.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::system_clock;
+
+// Horários separados por um minuto, como numa listagem de pedidos: exercita o cache de data/segundo
+auto sample_times(size_t count) -> std::vector<Clock::time_point>
+{
+    const auto start = Clock::from_time_t(1'700'000'000);
+
+    std::vector<Clock::time_point> times;
+    times.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        times.push_back(start - std::chrono::minutes(i));
+
+    return times;
+}
+
+void BM_FormatTime(benchmark::State &state)
+{
+    const auto format = static_cast<utils::time::TimeFormat>(state.range(0));
+    const auto times = sample_times(4096);
+
+    char buffer[utils::time::max_time_length_];
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::time::format_time(times[i++ % times.size()], format, buffer));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_FormatTime)
+    ->ArgName("format")
+    ->Arg(static_cast<int>(utils::time::TimeFormat::sql))
+    ->Arg(static_cast<int>(utils::time::TimeFormat::iso8601))
+    ->Arg(static_cast<int>(utils::time::TimeFormat::iso8601_millis));
+
+void BM_FormatTimeString(benchmark::State &state)
+{
+    const auto times = sample_times(4096);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::time::format_time(times[i++ % times.size()], utils::time::TimeFormat::iso8601));
+    }
+}
+BENCHMARK(BM_FormatTimeString);
+
+void BM_ParseTime(benchmark::State &state)
+{
+    const auto format = static_cast<utils::time::TimeFormat>(state.range(0));
+
+    std::vector<std::string> texts;
+    for (const auto &tp : sample_times(4096))
+        texts.push_back(utils::time::format_time(tp, format));
+
+    Clock::time_point tp;
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::time::parse_time(texts[i++ % texts.size()], tp));
+    }
+}
+BENCHMARK(BM_ParseTime)
+    ->ArgName("format")
+    ->Arg(static_cast<int>(utils::time::TimeFormat::sql))
+    ->Arg(static_cast<int>(utils::time::TimeFormat::iso8601_millis));
+
+void BM_ParseTimeWithOffset(benchmark::State &state)
+{
+    const std::string text = "2024-03-15T09:30:00.125-03:00";
+    Clock::time_point tp;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::time::parse_time(text, tp));
+    }
+}
+BENCHMARK(BM_ParseTimeWithOffset);
+
+} // namespace
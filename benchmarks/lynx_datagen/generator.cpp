@@ -0,0 +1,237 @@
+#include "generator.h"
+#include "utils/time/time_format.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace lynx::datagen
+{
+
+namespace
+{
+
+constexpr std::array<std::string_view, 13> categories_ = {"KITCHEN", "ELECTRONICS", "HOME", "CLEANING", "FOOD",     "BEVERAGES", "PERSONAL_CARE",
+                                                           "PETS",    "TOOLS",       "OFFICE", "TOYS",   "CLOTHING", "OTHER"};
+
+// Tabelas como streams independentes do mesmo seed
+enum Stream : uint64_t
+{
+    customer_stream = 1,
+    product_stream,
+    price_stream,
+    order_stream,
+    popularity_stream
+};
+
+constexpr auto splitmix(uint64_t x) -> uint64_t
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// SplitMix64 com estado derivado de (seed, stream, id): barato de criar por linha
+class Random
+{
+private:
+    uint64_t state_;
+
+public:
+    Random(uint64_t seed, Stream stream, int64_t id)
+        : state_(splitmix(seed ^ splitmix(static_cast<uint64_t>(stream) << 56 ^ static_cast<uint64_t>(id))))
+    {
+    }
+
+    auto next() -> uint64_t
+    {
+        state_ += 0x9E3779B97F4A7C15ULL;
+        return splitmix(state_);
+    }
+
+    auto below(int64_t n) -> int64_t
+    {
+        return static_cast<int64_t>(next() % static_cast<uint64_t>(n));
+    }
+
+    auto unit() -> double
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+};
+
+using Clock = std::chrono::system_clock;
+
+// Fim fixo da janela: o mesmo seed gera o mesmo arquivo em qualquer dia
+const Clock::time_point end_ = std::chrono::sys_days(std::chrono::year(2025) / 1 / 1);
+
+auto sql_time(Clock::time_point tp) -> std::string
+{
+    char buffer[utils::time::max_time_length_];
+    return std::string(buffer, utils::time::format_time(tp, utils::time::TimeFormat::sql, buffer));
+}
+
+auto payment_method(Random &random) -> std::string_view
+{
+    const auto roll = random.below(100);
+    return roll < 45 ? "PIX" : roll < 85 ? "CARD" : "BOLETO";
+}
+
+} // namespace
+
+ZipfSampler::ZipfSampler(int64_t n, double exponent, uint64_t seed)
+    : cdf_(static_cast<size_t>(n))
+{
+    double sum = 0;
+    for (int64_t k = 0; k < n; ++k)
+    {
+        sum += exponent == 0 ? 1.0 : 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+        cdf_[static_cast<size_t>(k)] = sum;
+    }
+
+    for (auto &value : cdf_)
+        value /= sum;
+
+    Random random(seed, popularity_stream, 0);
+    offset_ = random.below(n);
+    stride_ = random.below(n) | 1;
+    while (std::gcd(stride_, n) != 1)
+        stride_ += 2;
+}
+
+auto ZipfSampler::sample(double u) const -> int64_t
+{
+    const auto n = static_cast<int64_t>(cdf_.size());
+    const auto rank = std::min<int64_t>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin(), n - 1);
+
+    return (rank * stride_ + offset_) % n + 1;
+}
+
+Generator::Generator(const Scale &scale)
+    : scale_(scale)
+    , products_(scale.products, scale.zipf, scale.seed)
+{
+}
+
+auto Generator::product_price(int64_t product_id) const -> int64_t
+{
+    return 199 + Random(scale_.seed, price_stream, product_id).below(50000);
+}
+
+auto Generator::customers(int64_t first, int64_t last) const -> std::vector<CustomerRow>
+{
+    const auto window = std::chrono::hours(24) * scale_.days;
+
+    std::vector<CustomerRow> rows;
+    rows.reserve(static_cast<size_t>(last - first + 1));
+
+    for (int64_t id = first; id <= last; ++id)
+    {
+        Random random(scale_.seed, customer_stream, id);
+
+        // Cadastros espalhados pela janela anterior à dos pedidos
+        const auto created_at = end_ - 2 * window + std::chrono::seconds(random.below(std::chrono::seconds(window).count()));
+
+        rows.push_back({id, "Cliente " + std::to_string(id), "cliente" + std::to_string(id) + "@lynx.dev", sql_time(created_at)});
+    }
+
+    return rows;
+}
+
+auto Generator::products(int64_t first, int64_t last) const -> std::vector<ProductRow>
+{
+    std::vector<ProductRow> rows;
+    rows.reserve(static_cast<size_t>(last - first + 1));
+
+    for (int64_t id = first; id <= last; ++id)
+    {
+        Random random(scale_.seed, product_stream, id);
+
+        rows.push_back({id, "Produto " + std::to_string(id), categories_[static_cast<size_t>(random.below(categories_.size()))],
+                        product_price(id), random.below(10) != 0, 1000 + random.below(9000)});
+    }
+
+    return rows;
+}
+
+auto Generator::orders(int64_t first, int64_t last) const -> OrderChunk
+{
+    using std::chrono::minutes;
+    using std::chrono::seconds;
+
+    const auto window = seconds(std::chrono::hours(24) * scale_.days).count();
+
+    OrderChunk chunk;
+    chunk.orders.reserve(static_cast<size_t>(last - first + 1));
+    chunk.items.reserve(static_cast<size_t>(last - first + 1) * static_cast<size_t>(scale_.max_items + 1) / 2);
+    chunk.payments.reserve(static_cast<size_t>(last - first + 1));
+
+    for (int64_t id = first; id <= last; ++id)
+    {
+        Random random(scale_.seed, order_stream, id);
+
+        // Ids crescem com created_at, como num banco que recebeu os pedidos em ordem
+        const auto created_at = end_ - seconds(window) + seconds((id - 1) * window / scale_.orders);
+        const auto customer_id = 1 + random.below(scale_.customers);
+
+        int64_t total = 0;
+        const auto items = 1 + random.below(scale_.max_items);
+        for (int64_t k = 0; k < items; ++k)
+        {
+            const auto product_id = products_.sample(random.unit());
+            const auto quantity = 1 + random.below(3);
+            const auto price = product_price(product_id);
+
+            chunk.items.push_back({id, product_id, quantity, price});
+            total += quantity * price;
+        }
+
+        const auto paid_at = sql_time(created_at + minutes(1 + random.below(120)));
+        const auto roll = random.below(100);
+
+        std::string_view status = "NEW";
+        if (roll < 8)
+        {
+            status = "CANCELLED";
+        }
+        else if (roll < 60)
+        {
+            // Pago, às vezes em duas parcelas
+            status = "PAID";
+            if (random.below(4) == 0)
+            {
+                const auto first_part = total * (30 + random.below(41)) / 100;
+                chunk.payments.push_back({id, payment_method(random), first_part, paid_at});
+                chunk.payments.push_back({id, payment_method(random), total - first_part, paid_at});
+            }
+            else
+            {
+                chunk.payments.push_back({id, payment_method(random), total, paid_at});
+            }
+        }
+        else if (roll < 72)
+        {
+            // Pagamento parcial confirmado
+            chunk.payments.push_back({id, payment_method(random), total * (10 + random.below(81)) / 100, paid_at});
+        }
+        else if (roll < 80)
+        {
+            // Quitado, esperando o mark_settled_as_paid
+            chunk.payments.push_back({id, payment_method(random), total, paid_at});
+        }
+        else if (roll < 90)
+        {
+            // Pagamento em aberto (paid_at nulo)
+            chunk.payments.push_back({id, payment_method(random), total, {}});
+        }
+
+        chunk.orders.push_back({id, customer_id, status, sql_time(created_at)});
+    }
+
+    return chunk;
+}
+
+} // namespace lynx::datagen
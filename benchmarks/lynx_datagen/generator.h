@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Linhas do dataset sintético. Cada linha é função só de (seed, tabela, id): um chunk gera igual em
+ * qualquer thread e em qualquer ordem, e o arquivo final não depende de quantas threads geraram.
+ */
+
+namespace lynx::datagen
+{
+
+struct Scale
+{
+    int64_t customers = 100000;
+    int64_t products = 20000;
+    int64_t orders = 1000000;
+    int max_items = 5;   // itens por pedido: 1..max_items
+    double zipf = 1.0;   // expoente da popularidade dos produtos (0 = uniforme)
+    int days = 365;      // janela de created_at dos pedidos, terminando em 2025-01-01
+    uint64_t seed = 42;
+};
+
+struct CustomerRow
+{
+    int64_t id;
+    std::string name;
+    std::string email;
+    std::string created_at;
+};
+
+struct ProductRow
+{
+    int64_t id;
+    std::string name;
+    std::string_view category;
+    int64_t price_cents;
+    bool active;
+    int64_t stock;
+};
+
+struct OrderRow
+{
+    int64_t id;
+    int64_t customer_id;
+    std::string_view status;
+    std::string created_at;
+};
+
+struct ItemRow
+{
+    int64_t order_id;
+    int64_t product_id;
+    int64_t quantity;
+    int64_t unit_price_cents;
+};
+
+struct PaymentRow
+{
+    int64_t order_id;
+    std::string_view method;
+    int64_t amount_cents;
+    std::string paid_at; // vazio: pagamento em aberto (NULL)
+};
+
+struct OrderChunk
+{
+    std::vector<OrderRow> orders;
+    std::vector<ItemRow> items;
+    std::vector<PaymentRow> payments;
+};
+
+/* Popularidade Zipf(s) sobre n produtos: o posto k sai com probabilidade proporcional a 1 / k^s */
+class ZipfSampler
+{
+private:
+    std::vector<double> cdf_;
+    // Permutação posto -> id (posto * stride + offset), para os populares não serem sempre os primeiros ids
+    int64_t stride_;
+    int64_t offset_;
+
+public:
+    ZipfSampler(int64_t n, double exponent, uint64_t seed);
+
+    /* u em [0, 1) */
+    auto sample(double u) const -> int64_t;
+};
+
+class Generator
+{
+private:
+    Scale scale_;
+    ZipfSampler products_;
+
+public:
+    explicit Generator(const Scale &scale);
+
+    auto product_price(int64_t product_id) const -> int64_t;
+
+    /* Ids [first, last], inclusive */
+    auto customers(int64_t first, int64_t last) const -> std::vector<CustomerRow>;
+    auto products(int64_t first, int64_t last) const -> std::vector<ProductRow>;
+    auto orders(int64_t first, int64_t last) const -> OrderChunk;
+};
+
+} // namespace lynx::datagen
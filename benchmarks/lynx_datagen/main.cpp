@@ -0,0 +1,436 @@
+/*
+ * Gerador do dataset sintético para testes de escala: clientes, produtos com popularidade Zipf,
+ * pedidos com 1..N itens e pagamentos (parcelados, parciais, quitados sem baixa e em aberto).
+ * Mesmo seed e mesma escala geram o mesmo banco, com qualquer número de threads.
+ *
+ *   lynx_datagen --out lynx_10m.db --orders 10000000 --customers 1000000 --products 100000
+ *   lynx_loadgen --database lynx_10m.db ...
+ *
+ * As threads geram chunks de linhas e uma única conexão grava cada chunk numa transação, na ordem dos
+ * ids. O schema vem de docker/sqlite/init.sql; os índices são criados só depois da carga.
+ */
+
+#include "database/migrations.h"
+#include "generator.h"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace lynx;
+
+namespace
+{
+
+struct Options
+{
+    datagen::Scale scale;
+    std::string out;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int64_t chunk = 50000;
+    bool force = false;
+};
+
+class Database
+{
+private:
+    sqlite3 *connection_ = nullptr;
+
+public:
+    explicit Database(const std::string &path)
+    {
+        if (sqlite3_open(path.c_str(), &connection_) != SQLITE_OK)
+            throw std::runtime_error("Falha ao abrir " + path + ": " + sqlite3_errmsg(connection_));
+    }
+
+    ~Database()
+    {
+        sqlite3_close(connection_);
+    }
+
+    Database(const Database &) = delete;
+    Database &operator=(const Database &) = delete;
+
+    auto get() const -> sqlite3 *
+    {
+        return connection_;
+    }
+
+    auto exec(const std::string &sql) const -> void
+    {
+        char *error = nullptr;
+        if (sqlite3_exec(connection_, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+        {
+            const std::string message = error != nullptr ? error : "sqlite3_exec";
+            sqlite3_free(error);
+            throw std::runtime_error(message);
+        }
+    }
+};
+
+// Os textos vêm do chunk, que vive até o fim da transação: bind sem cópia
+class Statement
+{
+private:
+    sqlite3 *connection_;
+    sqlite3_stmt *stmt_ = nullptr;
+
+public:
+    Statement(const Database &database, const char *sql)
+        : connection_(database.get())
+    {
+        if (sqlite3_prepare_v2(connection_, sql, -1, &stmt_, nullptr) != SQLITE_OK)
+            throw std::runtime_error(sqlite3_errmsg(connection_));
+    }
+
+    ~Statement()
+    {
+        sqlite3_finalize(stmt_);
+    }
+
+    Statement(const Statement &) = delete;
+    Statement &operator=(const Statement &) = delete;
+
+    auto bind(int index, int64_t value) -> Statement &
+    {
+        sqlite3_bind_int64(stmt_, index, value);
+        return *this;
+    }
+
+    auto bind(int index, std::string_view value) -> Statement &
+    {
+        if (value.empty())
+            sqlite3_bind_null(stmt_, index);
+        else
+            sqlite3_bind_text(stmt_, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+        return *this;
+    }
+
+    auto run() -> void
+    {
+        if (sqlite3_step(stmt_) != SQLITE_DONE)
+            throw std::runtime_error(sqlite3_errmsg(connection_));
+
+        sqlite3_reset(stmt_);
+    }
+};
+
+/*
+ * Gera os chunks [0, chunks) em paralelo e entrega cada um a write na ordem. No máximo 2 chunks por
+ * thread ficam prontos esperando o escritor, para a memória não crescer quando o disco é o gargalo.
+ */
+template <typename Chunk>
+auto pipeline(int threads, int64_t chunks, const std::function<Chunk(int64_t)> &generate, const std::function<void(Chunk &)> &write) -> void
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<int64_t, Chunk> ready;
+    std::atomic<int64_t> next{0};
+    int64_t written = 0;
+    bool failed = false;
+
+    const int64_t max_ahead = 2 * static_cast<int64_t>(threads);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&] {
+            for (int64_t index = next++; index < chunks; index = next++)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    changed.wait(lock, [&] { return failed || index < written + max_ahead; });
+                    if (failed)
+                        return;
+                }
+
+                auto chunk = generate(index);
+
+                std::lock_guard lock(mutex);
+                ready.emplace(index, std::move(chunk));
+                changed.notify_all();
+            }
+        });
+    }
+
+    try
+    {
+        while (written < chunks)
+        {
+            Chunk chunk;
+            {
+                std::unique_lock lock(mutex);
+                changed.wait(lock, [&] { return ready.contains(written); });
+
+                auto node = ready.extract(written);
+                chunk = std::move(node.mapped());
+            }
+
+            write(chunk);
+
+            std::lock_guard lock(mutex);
+            ++written;
+            changed.notify_all();
+        }
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard lock(mutex);
+            failed = true;
+            changed.notify_all();
+        }
+        for (auto &worker : workers)
+            worker.join();
+        throw;
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+// init.sql dividido em tabelas e índices, pelo comentário "-- Indexes"
+auto load_schema() -> std::pair<std::string, std::string>
+{
+    std::ifstream file(LYNX_SCHEMA_PATH);
+    if (!file)
+        throw std::runtime_error("Schema não encontrado: " LYNX_SCHEMA_PATH);
+
+    std::stringstream content;
+    content << file.rdbuf();
+    const auto schema = content.str();
+
+    const auto split = schema.find("-- Indexes");
+    if (split == std::string::npos)
+        return {schema, {}};
+
+    return {schema.substr(0, split), schema.substr(split)};
+}
+
+auto progress(std::string_view table, int64_t rows, std::chrono::steady_clock::time_point start) -> void
+{
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  %-12.*s %12lld linhas %8.1f s %12.0f linhas/s\n", static_cast<int>(table.size()), table.data(), static_cast<long long>(rows), seconds,
+                seconds > 0 ? static_cast<double>(rows) / seconds : 0.0);
+    std::fflush(stdout);
+}
+
+auto chunk_count(int64_t rows, int64_t chunk) -> int64_t
+{
+    return (rows + chunk - 1) / chunk;
+}
+
+auto generate(const Options &options, const std::string &path) -> void
+{
+    const auto &scale = options.scale;
+    const datagen::Generator generator(scale);
+    const Database database(path);
+
+    // Carga em massa: sem journal nem fsync (o arquivo só vale se a geração terminar), cache grande e travas exclusivas
+    database.exec("PRAGMA page_size = 8192;"
+                  "PRAGMA journal_mode = OFF;"
+                  "PRAGMA synchronous = OFF;"
+                  "PRAGMA locking_mode = EXCLUSIVE;"
+                  "PRAGMA temp_store = MEMORY;"
+                  "PRAGMA cache_size = -524288;");
+
+    const auto [tables, indexes] = load_schema();
+    database.exec(tables);
+    lynx::database::mark_migrations_applied(database.get()); // o gerador já escreve as datas em UTC
+    database.exec("PRAGMA foreign_keys = OFF;");
+
+    const auto chunked = [&](std::string_view table, int64_t rows, auto generate_chunk, auto write_chunk) {
+        using Chunk = decltype(generate_chunk(int64_t{0}, int64_t{0}));
+
+        const auto start = std::chrono::steady_clock::now();
+        int64_t done = 0;
+        int64_t written = 0;
+
+        pipeline<Chunk>(
+            options.threads, chunk_count(rows, options.chunk),
+            [&](int64_t index) {
+                const auto first = index * options.chunk + 1;
+                return generate_chunk(first, std::min(rows, first + options.chunk - 1));
+            },
+            [&](Chunk &chunk) {
+                database.exec("BEGIN;");
+                done += write_chunk(chunk);
+                database.exec("COMMIT;");
+
+                if (++written % 20 == 0 && done < rows)
+                    progress(table, done, start);
+            });
+
+        progress(table, done, start);
+    };
+
+    Statement customer(database, "INSERT INTO customers (id, name, email, created_at) VALUES (?, ?, ?, ?)");
+    chunked(
+        "customers", scale.customers, [&](int64_t first, int64_t last) { return generator.customers(first, last); },
+        [&](std::vector<datagen::CustomerRow> &rows) {
+            for (const auto &row : rows)
+                customer.bind(1, row.id).bind(2, row.name).bind(3, row.email).bind(4, row.created_at).run();
+            return static_cast<int64_t>(rows.size());
+        });
+
+    Statement product(database, "INSERT INTO products (id, name, category, price_cents, active, stock) VALUES (?, ?, ?, ?, ?, ?)");
+    chunked(
+        "products", scale.products, [&](int64_t first, int64_t last) { return generator.products(first, last); },
+        [&](std::vector<datagen::ProductRow> &rows) {
+            for (const auto &row : rows)
+            {
+                product.bind(1, row.id).bind(2, row.name).bind(3, row.category).bind(4, row.price_cents).bind(5, int64_t{row.active}).bind(6, row.stock).run();
+            }
+            return static_cast<int64_t>(rows.size());
+        });
+
+    Statement order(database, "INSERT INTO orders (id, customer_id, status, created_at) VALUES (?, ?, ?, ?)");
+    Statement item(database, "INSERT INTO order_items (order_id, product_id, quantity, unit_price_cents) VALUES (?, ?, ?, ?)");
+    Statement payment(database, "INSERT INTO payments (order_id, method, amount_cents, paid_at) VALUES (?, ?, ?, ?)");
+    chunked(
+        "orders", scale.orders, [&](int64_t first, int64_t last) { return generator.orders(first, last); },
+        [&](datagen::OrderChunk &chunk) {
+            for (const auto &row : chunk.orders)
+                order.bind(1, row.id).bind(2, row.customer_id).bind(3, row.status).bind(4, row.created_at).run();
+
+            for (const auto &row : chunk.items)
+                item.bind(1, row.order_id).bind(2, row.product_id).bind(3, row.quantity).bind(4, row.unit_price_cents).run();
+
+            for (const auto &row : chunk.payments)
+                payment.bind(1, row.order_id).bind(2, row.method).bind(3, row.amount_cents).bind(4, row.paid_at).run();
+
+            return static_cast<int64_t>(chunk.orders.size());
+        });
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // O write-back do estoque parte do histórico já gravado, como num banco em produção
+    database.exec("UPDATE inventory_checkpoint SET last_order_item_id = (SELECT COALESCE(MAX(id), 0) FROM order_items) WHERE id = 1;");
+    database.exec(indexes);
+    database.exec("ANALYZE;");
+    database.exec("PRAGMA journal_mode = DELETE;");
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  índices e ANALYZE em %.1f s\n", seconds);
+}
+
+template <typename T> auto parse_number(std::string_view text, T &out) -> bool
+{
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+auto usage() -> void
+{
+    std::cerr << "uso: lynx_datagen --out arquivo.db [--customers N] [--products N] [--orders N] [--max-items N]\n"
+                 "                  [--zipf s] [--days N] [--seed N] [--threads N] [--chunk N] [--force]\n";
+}
+
+auto parse_options(int argc, char **argv, Options &options) -> bool
+{
+    auto &scale = options.scale;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view flag = argv[i];
+
+        if (flag == "--force")
+        {
+            options.force = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+            return false;
+        const std::string_view value = argv[++i];
+
+        bool ok = true;
+        if (flag == "--out")
+            options.out = value;
+        else if (flag == "--customers")
+            ok = parse_number(value, scale.customers) && scale.customers > 0;
+        else if (flag == "--products")
+            ok = parse_number(value, scale.products) && scale.products > 0;
+        else if (flag == "--orders")
+            ok = parse_number(value, scale.orders) && scale.orders >= 0;
+        else if (flag == "--max-items")
+            ok = parse_number(value, scale.max_items) && scale.max_items > 0;
+        else if (flag == "--zipf")
+            ok = parse_number(value, scale.zipf) && scale.zipf >= 0;
+        else if (flag == "--days")
+            ok = parse_number(value, scale.days) && scale.days > 0;
+        else if (flag == "--seed")
+            ok = parse_number(value, scale.seed);
+        else if (flag == "--threads")
+            ok = parse_number(value, options.threads) && options.threads > 0;
+        else if (flag == "--chunk")
+            ok = parse_number(value, options.chunk) && options.chunk > 0;
+        else
+            ok = false;
+
+        if (!ok)
+            return false;
+    }
+
+    return !options.out.empty();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        usage();
+        return 1;
+    }
+
+    namespace fs = std::filesystem;
+
+    if (fs::exists(options.out) && !options.force)
+    {
+        std::cerr << options.out << " já existe (use --force para sobrescrever)\n";
+        return 1;
+    }
+
+    // Gera num arquivo ao lado e só renomeia no fim: um arquivo com o nome final está sempre completo
+    const auto partial = options.out + ".partial";
+    std::error_code ignored;
+    fs::remove(partial, ignored);
+
+    const auto &scale = options.scale;
+    std::printf("seed %llu: %lld clientes, %lld produtos (zipf %.2f), %lld pedidos com 1..%d itens, %d threads\n",
+                static_cast<unsigned long long>(scale.seed), static_cast<long long>(scale.customers), static_cast<long long>(scale.products),
+                scale.zipf, static_cast<long long>(scale.orders), scale.max_items, options.threads);
+
+    try
+    {
+        generate(options, partial);
+        fs::rename(partial, options.out);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        fs::remove(partial, ignored);
+        return 1;
+    }
+
+    std::printf("%s\n", options.out.c_str());
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "load_runner.h"
+#include "http_client.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace lynx::loadgen
+{
+
+using Clock = std::chrono::steady_clock;
+
+auto RouteResult::merge(const RouteResult &other) -> void
+{
+    latency.merge(other.latency);
+    ok += other.ok;
+    client_error += other.client_error;
+    shed += other.shed;
+    server_error += other.server_error;
+    failed += other.failed;
+}
+
+auto RouteResult::total() const -> uint64_t
+{
+    return ok + client_error + shed + server_error + failed;
+}
+
+auto LoadResult::overall() const -> RouteResult
+{
+    RouteResult sum;
+    for (const auto &route : routes)
+        sum.merge(route);
+
+    return sum;
+}
+
+namespace
+{
+
+struct Connection
+{
+    std::array<RouteResult, route_count_> routes;
+    Clock::time_point finished_at;
+};
+
+auto run_connection(const LoadConfig &config, const Targets &targets, int index, Clock::time_point start,
+                    Connection &connection) -> void
+{
+    const auto measure_from = start + config.warmup;
+    const auto end = measure_from + config.duration;
+
+    // Cada conexão carrega rate / connections; a primeira requisição é escalonada para não saírem todas juntas
+    const double mean_interval = static_cast<double>(config.connections) / config.rate;
+
+    std::mt19937_64 random(config.seed * 7919 + static_cast<uint64_t>(index));
+    std::exponential_distribution<double> poisson_gap(1.0 / mean_interval);
+
+    Workload workload(config.mix, targets, config.seed + static_cast<uint64_t>(index));
+    bench::HttpClient client(config.port, config.timeout, config.gzip ? "Accept-Encoding: gzip\r\n" : "");
+
+    const auto gap = [&] {
+        const double seconds = config.poisson ? poisson_gap(random) : mean_interval;
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    auto intended = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(mean_interval * index / config.connections));
+
+    while (intended < end)
+    {
+        std::this_thread::sleep_until(intended);
+
+        const auto request = workload.next();
+        const auto response = client.send(request.method, request.path, request.body);
+        const auto completed = Clock::now();
+
+        if (request.route == Route::orders_create && response.status == 201)
+            workload.on_order_created(response.body);
+
+        if (intended >= measure_from)
+        {
+            auto &route = connection.routes[static_cast<size_t>(request.route)];
+
+            if (response.status == 0)
+                ++route.failed;
+            else if (response.status < 400)
+                ++route.ok;
+            else if (response.status == 503)
+                ++route.shed;
+            else if (response.status < 500)
+                ++route.client_error;
+            else
+                ++route.server_error;
+
+            if (response.status != 0)
+                route.latency.record(completed - intended);
+        }
+
+        intended += gap();
+    }
+
+    connection.finished_at = Clock::now();
+}
+
+} // namespace
+
+auto run_load(const LoadConfig &config, const Targets &targets) -> LoadResult
+{
+    std::vector<Connection> connections(static_cast<size_t>(config.connections));
+
+    // Margem para todas as threads estarem de pé antes do primeiro envio agendado
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+
+    std::vector<std::thread> workers;
+    workers.reserve(connections.size());
+    for (int i = 0; i < config.connections; ++i)
+    {
+        workers.emplace_back(run_connection, std::cref(config), std::cref(targets), i, start, std::ref(connections[static_cast<size_t>(i)]));
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    LoadResult result;
+    auto finished = start + config.warmup;
+    for (const auto &connection : connections)
+    {
+        for (size_t i = 0; i < route_count_; ++i)
+            result.routes[i].merge(connection.routes[i]);
+
+        finished = std::max(finished, connection.finished_at);
+    }
+
+    // Atrás da agenda, a última resposta chega depois do fim previsto: a vazão é medida até ela
+    result.elapsed_seconds = std::chrono::duration<double>(finished - (start + config.warmup)).count();
+    return result;
+}
+
+} // namespace lynx::loadgen
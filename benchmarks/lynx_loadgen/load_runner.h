@@ -0,0 +1,57 @@
+#pragma once
+
+#include "latency_histogram.h"
+#include "workload.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace lynx::loadgen
+{
+
+struct LoadConfig
+{
+    uint16_t port = 18080;
+    double rate = 1000;     // requisições por segundo, somando todas as conexões
+    int connections = 32;
+    std::chrono::seconds warmup{2};
+    std::chrono::seconds duration{10};
+    bool poisson = true;    // chegadas de Poisson; false: intervalos fixos
+    bool gzip = false;      // envia Accept-Encoding: gzip
+    std::chrono::milliseconds timeout{10000};
+    WorkloadMix mix;
+    uint64_t seed = 42;
+};
+
+struct RouteResult
+{
+    bench::LatencyHistogram latency;
+    uint64_t ok = 0;          // 2xx
+    uint64_t client_error = 0; // 4xx (estoque esgotado, pagamento acima do total...)
+    uint64_t shed = 0;         // 503 da admissão
+    uint64_t server_error = 0; // demais 5xx
+    uint64_t failed = 0;       // conexão recusada, timeout ou resposta inválida
+
+    auto merge(const RouteResult &other) -> void;
+    auto total() const -> uint64_t;
+};
+
+struct LoadResult
+{
+    std::array<RouteResult, route_count_> routes;
+    double elapsed_seconds = 0;
+
+    auto overall() const -> RouteResult;
+};
+
+/*
+ * Carga em malha aberta: cada conexão tem uma agenda de envios fixada de antemão (taxa / conexões por
+ * conexão) e a latência é medida a partir do horário agendado, não do envio real. Quando o servidor
+ * atrasa, as requisições seguintes saem atrasadas e esse tempo de fila entra na latência, em vez de
+ * sumir da amostra (coordinated omission). Só entram no resultado as agendadas depois do aquecimento.
+ */
+auto run_load(const LoadConfig &config, const Targets &targets) -> LoadResult;
+
+} // namespace lynx::loadgen
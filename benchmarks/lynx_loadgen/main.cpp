@@ -0,0 +1,432 @@
+/*
+ * Gerador de carga HTTP em processo: sobe a API (app::Application) numa porta de loopback sobre o banco
+ * temporário do lynx_bench e a dispara em malha aberta a partir de várias conexões, com o mix de rotas
+ * de workload.h. Para cada combinação de --threads x --rate imprime os percentis por rota e, no fim,
+ * a curva de escala. O estado do banco acumula entre cenários (pedidos e pagamentos criados ficam).
+ *
+ *   lynx_loadgen --threads 1,2,4,8 --rate 2000 --duration 20 --connections 64
+ *   lynx_loadgen --threads 4 --rate 500,1000,2000,4000 --json escala.json
+ *
+ * Com --database a carga roda sobre um banco existente (ex.: gerado pelo lynx_datagen), que é alterado.
+ */
+
+#include "application.h"
+#include "bench_database.h"
+#include "database/SQLite_database.h"
+#include "load_runner.h"
+#include "lynx_git_commit.h"
+#include "utils/json_writer.h"
+
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lynx;
+
+namespace
+{
+
+struct Options
+{
+    std::vector<int> threads = {1, 2, 4};
+    std::vector<double> rates = {1000};
+    loadgen::LoadConfig load;
+    std::string database_path; // vazio: banco temporário semeado pelo bench_database
+    std::string json_path;
+};
+
+struct Scenario
+{
+    int threads;
+    double rate;
+    loadgen::LoadResult result;
+};
+
+template <typename T> auto parse_list(std::string_view text, std::vector<T> &out) -> bool
+{
+    out.clear();
+    while (!text.empty())
+    {
+        const auto comma = text.find(',');
+        const auto item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        T value{};
+        const auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), value);
+        if (ec != std::errc() || end != item.data() + item.size() || value <= 0)
+            return false;
+
+        out.push_back(value);
+    }
+    return !out.empty();
+}
+
+template <typename T> auto parse_number(std::string_view text, T &out) -> bool
+{
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+auto usage() -> void
+{
+    std::cerr << "uso: lynx_loadgen [--threads 1,2,4] [--rate 1000[,2000]] [--duration s] [--warmup s]\n"
+                 "                  [--connections N] [--port P] [--arrival poisson|uniform] [--gzip]\n"
+                 "                  [--mix products.list=25,orders.create=12,...] [--database arquivo.db]\n"
+                 "                  [--json arquivo]\n";
+}
+
+auto parse_options(int argc, char **argv, Options &options) -> bool
+{
+    auto &load = options.load;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view flag = argv[i];
+
+        if (flag == "--gzip")
+        {
+            load.gzip = true;
+            continue;
+        }
+
+        if (i + 1 == argc)
+            return false;
+        const std::string_view value = argv[++i];
+
+        int number = 0;
+        if (flag == "--threads")
+        {
+            if (!parse_list(value, options.threads))
+                return false;
+        }
+        else if (flag == "--rate")
+        {
+            if (!parse_list(value, options.rates))
+                return false;
+        }
+        else if (flag == "--duration" || flag == "--warmup")
+        {
+            // Aquecimento pode ser zero; a medição não
+            if (!parse_number(value, number) || number < (flag == "--duration" ? 1 : 0))
+                return false;
+            (flag == "--duration" ? load.duration : load.warmup) = std::chrono::seconds(number);
+        }
+        else if (flag == "--connections")
+        {
+            if (!parse_number(value, load.connections) || load.connections <= 0)
+                return false;
+        }
+        else if (flag == "--port")
+        {
+            if (!parse_number(value, number) || number <= 0 || number > 65535)
+                return false;
+            load.port = static_cast<uint16_t>(number);
+        }
+        else if (flag == "--arrival")
+        {
+            if (value != "poisson" && value != "uniform")
+                return false;
+            load.poisson = value == "poisson";
+        }
+        else if (flag == "--mix")
+        {
+            if (!load.mix.parse(value))
+                return false;
+        }
+        else if (flag == "--database")
+        {
+            options.database_path = value;
+        }
+        else if (flag == "--json")
+        {
+            options.json_path = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Mesma montagem do main da API, com log baixo para não competir com a carga
+auto application_config(const Options &options, int threads) -> app::ApplicationConfig
+{
+    app::ApplicationConfig config;
+
+    config.server.port = options.load.port;
+    config.server.threads = threads;
+    config.server.log_level = "warning";
+    config.server.compression_level = 6;
+    config.server.compression_min_bytes = 1024;
+
+    config.admission.read.initial_limit = 32;
+    config.admission.write.initial_limit = 8;
+    config.admission.retry_after = std::chrono::seconds(1);
+
+    config.profiler.slow_threshold = std::chrono::milliseconds(50);
+    config.inventory.flush_interval = std::chrono::milliseconds(500);
+
+    // Os pedidos NEW do seed são os alvos de pagamento antes de cada conexão criar os seus
+    config.expiry.enabled = false;
+
+    return config;
+}
+
+auto to_ms(std::chrono::nanoseconds latency) -> double
+{
+    return std::chrono::duration<double, std::milli>(latency).count();
+}
+
+auto print_row(std::string_view name, const loadgen::RouteResult &route, double elapsed) -> void
+{
+    const auto &latency = route.latency;
+
+    std::printf("  %-26.*s %8llu %9.1f %7llu %6llu %6llu %6llu %6llu %9.2f %9.2f %9.2f %9.2f %9.2f\n", static_cast<int>(name.size()), name.data(),
+                static_cast<unsigned long long>(route.total()), elapsed > 0 ? static_cast<double>(route.total()) / elapsed : 0.0,
+                static_cast<unsigned long long>(route.ok), static_cast<unsigned long long>(route.client_error),
+                static_cast<unsigned long long>(route.shed), static_cast<unsigned long long>(route.server_error),
+                static_cast<unsigned long long>(route.failed), to_ms(latency.percentile(0.50)), to_ms(latency.percentile(0.90)),
+                to_ms(latency.percentile(0.99)), to_ms(latency.percentile(0.999)), to_ms(latency.max()));
+}
+
+auto print_scenario(const Scenario &scenario) -> void
+{
+    const auto &result = scenario.result;
+
+    std::printf("\nthreads=%d rate=%.0f/s (%.1f s medidos)\n", scenario.threads, scenario.rate, result.elapsed_seconds);
+    std::printf("  %-26s %8s %9s %7s %6s %6s %6s %6s %9s %9s %9s %9s %9s\n", "rota", "reqs", "req/s", "2xx", "4xx", "503", "5xx", "falha",
+                "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms");
+
+    for (size_t i = 0; i < loadgen::route_count_; ++i)
+    {
+        if (result.routes[i].total() > 0)
+            print_row(loadgen::route_names_[i], result.routes[i], result.elapsed_seconds);
+    }
+
+    print_row("total", result.overall(), result.elapsed_seconds);
+}
+
+auto error_ratio(const loadgen::RouteResult &route) -> double
+{
+    const auto total = route.total();
+    return total == 0 ? 0.0 : 100.0 * static_cast<double>(total - route.ok - route.client_error) / static_cast<double>(total);
+}
+
+auto print_scaling(const std::vector<Scenario> &scenarios) -> void
+{
+    std::printf("\ncurva de escala\n");
+    std::printf("  %7s %10s %10s %9s %9s %9s %8s\n", "threads", "alvo/s", "obtido/s", "p50 ms", "p99 ms", "p99.9 ms", "erro %");
+
+    for (const auto &scenario : scenarios)
+    {
+        const auto overall = scenario.result.overall();
+        const auto achieved = scenario.result.elapsed_seconds > 0 ? static_cast<double>(overall.total()) / scenario.result.elapsed_seconds : 0.0;
+
+        std::printf("  %7d %10.0f %10.1f %9.2f %9.2f %9.2f %8.2f\n", scenario.threads, scenario.rate, achieved,
+                    to_ms(overall.latency.percentile(0.50)), to_ms(overall.latency.percentile(0.99)),
+                    to_ms(overall.latency.percentile(0.999)), error_ratio(overall));
+    }
+}
+
+auto write_route(utils::json::JsonWriter &writer, const loadgen::RouteResult &route, double elapsed) -> void
+{
+    const auto &latency = route.latency;
+
+    writer.begin_object();
+    writer.key("requests").value(static_cast<int64_t>(route.total()));
+    writer.key("rps").value(elapsed > 0 ? static_cast<double>(route.total()) / elapsed : 0.0);
+    writer.key("status_2xx").value(static_cast<int64_t>(route.ok));
+    writer.key("status_4xx").value(static_cast<int64_t>(route.client_error));
+    writer.key("status_503").value(static_cast<int64_t>(route.shed));
+    writer.key("status_5xx").value(static_cast<int64_t>(route.server_error));
+    writer.key("failed").value(static_cast<int64_t>(route.failed));
+    writer.key("p50_ns").value(static_cast<int64_t>(latency.percentile(0.50).count()));
+    writer.key("p90_ns").value(static_cast<int64_t>(latency.percentile(0.90).count()));
+    writer.key("p99_ns").value(static_cast<int64_t>(latency.percentile(0.99).count()));
+    writer.key("p999_ns").value(static_cast<int64_t>(latency.percentile(0.999).count()));
+    writer.key("max_ns").value(static_cast<int64_t>(latency.max().count()));
+    writer.end_object();
+}
+
+auto write_json(const Options &options, const std::vector<Scenario> &scenarios) -> bool
+{
+    utils::json::JsonWriter writer;
+
+    writer.begin_object();
+    writer.key("git_commit").value(std::string_view(LYNX_GIT_COMMIT));
+    writer.key("connections").value(static_cast<int64_t>(options.load.connections));
+    writer.key("duration_s").value(static_cast<int64_t>(options.load.duration.count()));
+    writer.key("warmup_s").value(static_cast<int64_t>(options.load.warmup.count()));
+    writer.key("arrival").value(std::string_view(options.load.poisson ? "poisson" : "uniform"));
+    writer.key("gzip").value(options.load.gzip);
+    writer.key("mix").value(std::string_view(options.load.mix.describe()));
+
+    writer.key("scenarios").begin_array();
+    for (const auto &scenario : scenarios)
+    {
+        const auto &result = scenario.result;
+
+        writer.begin_object();
+        writer.key("threads").value(static_cast<int64_t>(scenario.threads));
+        writer.key("target_rps").value(scenario.rate);
+        writer.key("elapsed_s").value(result.elapsed_seconds);
+
+        writer.key("overall");
+        write_route(writer, result.overall(), result.elapsed_seconds);
+
+        writer.key("routes").begin_object();
+        for (size_t i = 0; i < loadgen::route_count_; ++i)
+        {
+            writer.key(loadgen::route_keys_[i]);
+            write_route(writer, result.routes[i], result.elapsed_seconds);
+        }
+        writer.end_object();
+
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.end_object();
+
+    std::ofstream out(options.json_path);
+    out << writer.buffer() << '\n';
+    return static_cast<bool>(out);
+}
+
+auto query_ids(const std::string &sql) -> std::vector<int>
+{
+    auto *connection = database::SQLiteDatabase::get_instance().get_connection();
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(connection, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(connection));
+
+    std::vector<int> ids;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        ids.push_back(sqlite3_column_int(stmt, 0));
+
+    sqlite3_finalize(stmt);
+    return ids;
+}
+
+// Faixas de ids do banco escolhido; os pedidos NEW mais recentes recebem os primeiros pagamentos
+auto load_targets(const Options &options) -> loadgen::Targets
+{
+    loadgen::Targets targets;
+
+    if (options.database_path.empty())
+    {
+        bench::open_temp_database();
+
+        targets.customers = bench::Dataset::customers_;
+        targets.products = bench::Dataset::products_;
+        targets.orders = bench::Dataset::orders_;
+        targets.open_orders = bench::seeded_ids().new_orders;
+        return targets;
+    }
+
+    if (!std::filesystem::exists(options.database_path))
+        throw std::runtime_error("Banco não encontrado: " + options.database_path);
+
+    database::SQLiteDatabase::set_path(options.database_path);
+
+    const auto max_id = [](const char *table) {
+        const auto ids = query_ids(std::string("SELECT COALESCE(MAX(id), 0) FROM ") + table);
+        return ids.empty() ? 0 : ids.front();
+    };
+
+    targets.customers = max_id("customers");
+    targets.products = max_id("products");
+    targets.orders = max_id("orders");
+    targets.open_orders = query_ids("SELECT id FROM orders WHERE status = 'NEW' ORDER BY id DESC LIMIT 10000");
+
+    if (targets.customers == 0 || targets.products == 0 || targets.orders == 0)
+        throw std::runtime_error("Banco sem clientes, produtos ou pedidos: " + options.database_path);
+
+    return targets;
+}
+
+auto run_scenario(const Options &options, const loadgen::Targets &targets, int threads, double rate) -> loadgen::LoadResult
+{
+    app::Application application(application_config(options, threads));
+
+    std::exception_ptr failure;
+    std::thread server([&] {
+        try
+        {
+            application.run();
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+    });
+
+    application.wait_until_ready();
+
+    auto load = options.load;
+    load.rate = rate;
+    const auto result = loadgen::run_load(load, targets);
+
+    application.stop();
+    server.join();
+
+    if (failure)
+        std::rethrow_exception(failure);
+
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        const auto targets = load_targets(options);
+
+        std::printf("mix: %s\nconexões: %d, aquecimento %llds, medição %llds, chegadas %s%s\n", options.load.mix.describe().c_str(),
+                    options.load.connections, static_cast<long long>(options.load.warmup.count()),
+                    static_cast<long long>(options.load.duration.count()), options.load.poisson ? "poisson" : "uniformes",
+                    options.load.gzip ? ", gzip" : "");
+
+        std::vector<Scenario> scenarios;
+        for (const auto threads : options.threads)
+        {
+            for (const auto rate : options.rates)
+            {
+                scenarios.push_back({threads, rate, run_scenario(options, targets, threads, rate)});
+                print_scenario(scenarios.back());
+            }
+        }
+
+        print_scaling(scenarios);
+
+        if (!options.json_path.empty() && !write_json(options, scenarios))
+            std::cerr << "Falha ao gravar " << options.json_path << "\n";
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        bench::remove_temp_database();
+        return 1;
+    }
+
+    bench::remove_temp_database();
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "workload.h"
+
+#include <charconv>
+
+namespace lynx::loadgen
+{
+
+namespace
+{
+
+constexpr std::array<std::string_view, 13> categories_ = {"KITCHEN", "ELECTRONICS", "HOME", "CLEANING", "FOOD",     "BEVERAGES", "PERSONAL_CARE",
+                                                           "PETS",    "TOOLS",       "OFFICE", "TOYS",   "CLOTHING", "OTHER"};
+
+constexpr std::array<std::string_view, 3> methods_ = {"PIX", "CARD", "BOLETO"};
+
+// Pedidos recentes guardados por conexão para receber pagamentos
+constexpr size_t max_created_orders_ = 64;
+
+} // namespace
+
+auto WorkloadMix::parse(std::string_view spec) -> bool
+{
+    while (!spec.empty())
+    {
+        const auto comma = spec.find(',');
+        const auto entry = spec.substr(0, comma);
+        spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+
+        const auto equals = entry.find('=');
+        if (equals == std::string_view::npos)
+            return false;
+
+        const auto key = entry.substr(0, equals);
+        const auto value = entry.substr(equals + 1);
+
+        size_t route = 0;
+        while (route < route_count_ && route_keys_[route] != key)
+            ++route;
+
+        uint32_t weight = 0;
+        if (route == route_count_ || std::from_chars(value.data(), value.data() + value.size(), weight).ec != std::errc())
+            return false;
+
+        weights[route] = weight;
+    }
+
+    for (const auto weight : weights)
+    {
+        if (weight > 0)
+            return true;
+    }
+    return false;
+}
+
+auto WorkloadMix::describe() const -> std::string
+{
+    std::string out;
+    for (size_t i = 0; i < route_count_; ++i)
+    {
+        if (!out.empty())
+            out += ',';
+        out.append(route_keys_[i]).append("=").append(std::to_string(weights[i]));
+    }
+    return out;
+}
+
+Workload::Workload(const WorkloadMix &mix, const Targets &targets, uint64_t seed)
+    : random_(seed)
+    , pick_route_(mix.weights.begin(), mix.weights.end())
+    , targets_(targets)
+{
+    created_orders_.reserve(max_created_orders_);
+}
+
+auto Workload::random_id(int count) -> int
+{
+    return static_cast<int>(random_() % static_cast<uint64_t>(count)) + 1;
+}
+
+auto Workload::next() -> Request
+{
+    const auto route = static_cast<Route>(pick_route_(random_));
+
+    Request request{route, "GET", {}, {}};
+
+    switch (route)
+    {
+    case Route::products_list:
+        request.path = "/api/products?active=true&category=" + std::string(categories_[random_() % categories_.size()]);
+        break;
+    case Route::products_get:
+        request.path = "/api/products/" + std::to_string(random_id(targets_.products));
+        break;
+    case Route::customers_get:
+        request.path = "/api/customers/" + std::to_string(random_id(targets_.customers));
+        break;
+    case Route::orders_get:
+        request.path = "/api/orders/" + std::to_string(random_id(targets_.orders));
+        break;
+    case Route::orders_create:
+    {
+        request.method = "POST";
+        request.path = "/api/orders";
+        request.body = "{\"customer_id\":" + std::to_string(random_id(targets_.customers)) + ",\"items\":[";
+
+        const auto items = 1 + random_() % 3;
+        for (uint64_t i = 0; i < items; ++i)
+        {
+            if (i > 0)
+                request.body += ',';
+            request.body += "{\"product_id\":" + std::to_string(random_id(targets_.products)) +
+                            ",\"quantity\":" + std::to_string(1 + random_() % 2) + "}";
+        }
+        request.body += "]}";
+        break;
+    }
+    case Route::orders_summary:
+        request.path = random_() % 2 == 0 ? "/api/orders/summary?limit=100"
+                                          : "/api/orders/summary?limit=100&customer_id=" + std::to_string(random_id(targets_.customers));
+        break;
+    case Route::payments_create:
+    {
+        int order_id;
+        if (!created_orders_.empty())
+            order_id = created_orders_[random_() % created_orders_.size()];
+        else if (!targets_.open_orders.empty())
+            order_id = targets_.open_orders[random_() % targets_.open_orders.size()];
+        else
+            order_id = random_id(targets_.orders);
+
+        request.method = "POST";
+        request.path = "/api/payments";
+        request.body = "{\"order_id\":" + std::to_string(order_id) + ",\"method\":\"" + std::string(methods_[random_() % methods_.size()]) +
+                       "\",\"amount_cents\":100}";
+        break;
+    }
+    case Route::payments_list:
+        request.path = "/api/payments?limit=50&method=" + std::string(methods_[random_() % methods_.size()]);
+        break;
+    }
+
+    return request;
+}
+
+auto Workload::on_order_created(std::string_view response_body) -> void
+{
+    constexpr std::string_view key = "\"order_id\":";
+
+    const auto position = response_body.find(key);
+    if (position == std::string_view::npos)
+        return;
+
+    int order_id = 0;
+    const auto *begin = response_body.data() + position + key.size();
+    if (std::from_chars(begin, response_body.data() + response_body.size(), order_id).ec != std::errc())
+        return;
+
+    if (created_orders_.size() == max_created_orders_)
+        created_orders_.erase(created_orders_.begin());
+
+    created_orders_.push_back(order_id);
+}
+
+} // namespace lynx::loadgen
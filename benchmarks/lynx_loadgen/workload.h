@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lynx::loadgen
+{
+
+/* Rotas exercitadas; o nome é o rótulo do histograma no relatório */
+enum class Route
+{
+    products_list,
+    products_get,
+    customers_get,
+    orders_get,
+    orders_create,
+    orders_summary,
+    payments_create,
+    payments_list
+};
+
+inline constexpr size_t route_count_ = 8;
+
+inline constexpr std::array<std::string_view, route_count_> route_names_ = {
+    "GET /api/products",        "GET /api/products/<id>", "GET /api/customers/<id>", "GET /api/orders/<id>",
+    "POST /api/orders",         "GET /api/orders/summary", "POST /api/payments",     "GET /api/payments"};
+
+// Nomes curtos aceitos em --mix
+inline constexpr std::array<std::string_view, route_count_> route_keys_ = {
+    "products.list", "products.get", "customers.get", "orders.get", "orders.create", "orders.summary", "payments.create", "payments.list"};
+
+/*
+ * Pesos padrão: navegação no catálogo domina, depois consulta de pedidos, criação de pedidos e pagamentos
+ * e, por último, os relatórios de resumo, que varrem tabelas.
+ */
+struct WorkloadMix
+{
+    std::array<uint32_t, route_count_> weights = {25, 25, 5, 10, 12, 8, 10, 5};
+
+    /* "products.list=40,orders.create=20": rotas citadas trocam de peso, as demais ficam como estão */
+    auto parse(std::string_view spec) -> bool;
+    auto describe() const -> std::string;
+};
+
+/* Ids existentes no banco alvo: faixas de clientes, produtos e pedidos e pedidos NEW que aceitam pagamento */
+struct Targets
+{
+    int customers = 0;
+    int products = 0;
+    int orders = 0;
+    std::vector<int> open_orders;
+};
+
+struct Request
+{
+    Route route;
+    std::string_view method;
+    std::string path;
+    std::string body;
+};
+
+/*
+ * Sorteia a próxima requisição de uma conexão. Ids vêm das faixas de Targets; pagamentos vão para
+ * pedidos que a própria conexão criou (ou, antes do primeiro, para um pedido NEW já existente).
+ */
+class Workload
+{
+private:
+    std::mt19937_64 random_;
+    std::discrete_distribution<size_t> pick_route_;
+    const Targets &targets_;
+    std::vector<int> created_orders_;
+
+    auto random_id(int count) -> int;
+
+public:
+    Workload(const WorkloadMix &mix, const Targets &targets, uint64_t seed);
+
+    auto next() -> Request;
+
+    /* Id do pedido criado, lido da resposta do POST /api/orders */
+    auto on_order_created(std::string_view response_body) -> void;
+};
+
+} // namespace lynx::loadgen
@@ -0,0 +1,461 @@
+/*
+ * Regressão de planos de consulta: executa cada método dos repositórios SQLite (e cada combinação de
+ * filtros das queries montadas em runtime) sobre o banco temporário do lynx_bench, captura os SQLs
+ * emitidos pelo QueryProfiler e roda EXPLAIN QUERY PLAN em cada um.
+ *
+ * Falha quando um plano faz SCAN de uma tabela de negócio ou usa USE TEMP B-TREE sem uma permissão
+ * explícita no caso (com o motivo), ou quando algum plano difere do snapshot em plans.snapshot.
+ *
+ *   lynx_plans            confere contra o snapshot
+ *   lynx_plans --update   regrava o snapshot depois de revisar a mudança
+ *
+ * Os planos dependem da versão do SQLite e das estatísticas do ANALYZE feito no seed.
+ */
+
+#include "bench_database.h"
+#include "database/SQLite_database.h"
+#include "database/query_profiler.h"
+#include "repository/customer_repository.h"
+#include "repository/inventory_repository.h"
+#include "repository/order_item_repository.h"
+#include "repository/order_repository.h"
+#include "repository/payment_repository.h"
+#include "repository/product_repository.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace lynx;
+
+namespace
+{
+
+// Tabelas que crescem com o uso; inventory_checkpoint tem uma linha só
+const std::set<std::string> large_tables_ = {"customers", "products", "orders", "order_items", "payments"};
+
+/* Achado tolerado num caso: "SCAN <tabela>" ou "USE TEMP B-TREE FOR <...>", com o motivo */
+struct Allowance
+{
+    std::string finding;
+    std::string reason;
+};
+
+struct Case
+{
+    std::string name;
+    std::function<void()> run;
+    std::vector<Allowance> allowed{};
+};
+
+struct Statement
+{
+    std::string sql;
+    std::vector<std::string> plan;
+};
+
+auto connection() -> sqlite3 *
+{
+    return database::SQLiteDatabase::get_instance().get_connection();
+}
+
+// Transações e afins não têm plano
+auto is_query(const std::string &sql) -> bool
+{
+    static const std::regex query("^\\s*(SELECT|INSERT|UPDATE|DELETE|WITH)\\b", std::regex::icase);
+    return std::regex_search(sql, query);
+}
+
+/* Plano em árvore, um nó por linha, indentado pela profundidade */
+auto explain(const std::string &sql) -> std::vector<std::string>
+{
+    sqlite3_stmt *stmt = nullptr;
+    const auto query = "EXPLAIN QUERY PLAN " + sql;
+    if (sqlite3_prepare_v2(connection(), query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        return {std::string("EXPLAIN falhou: ") + sqlite3_errmsg(connection())};
+
+    std::map<int, int> depth;
+    std::vector<std::string> plan;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const int id = sqlite3_column_int(stmt, 0);
+        const int parent = sqlite3_column_int(stmt, 1);
+        const auto level = depth[id] = parent == 0 ? 0 : depth[parent] + 1;
+
+        plan.push_back(std::string(static_cast<size_t>(level) * 2, ' ') + reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3)));
+    }
+
+    sqlite3_finalize(stmt);
+    return plan;
+}
+
+// Apelidos do SQL ("FROM orders o", "JOIN payments AS p") para o nome da tabela
+auto table_aliases(const std::string &sql) -> std::map<std::string, std::string>
+{
+    static const std::regex source("\\b(?:FROM|JOIN|UPDATE)\\s+(\\w+)(?:\\s+(?:AS\\s+)?(\\w+))?", std::regex::icase);
+    static const std::set<std::string> keywords = {"WHERE", "LEFT", "INNER", "JOIN", "ON", "GROUP", "ORDER", "LIMIT", "SET", "AS"};
+
+    std::map<std::string, std::string> aliases;
+    for (auto it = std::sregex_iterator(sql.begin(), sql.end(), source); it != std::sregex_iterator(); ++it)
+    {
+        const auto table = (*it)[1].str();
+        aliases[table] = table;
+
+        auto alias = (*it)[2].str();
+        std::string upper = alias;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        if (!alias.empty() && !keywords.contains(upper))
+            aliases[alias] = table;
+    }
+
+    return aliases;
+}
+
+/* "SCAN orders" para varreduras de tabelas grandes e "USE TEMP B-TREE FOR ..." como vêm no plano */
+auto findings(const Statement &statement) -> std::vector<std::string>
+{
+    static const std::regex scan("^\\s*SCAN (\\w+)");
+    static const std::regex temp_btree("^\\s*(USE TEMP B-TREE FOR .*)$");
+
+    const auto aliases = table_aliases(statement.sql);
+
+    std::vector<std::string> out;
+    for (const auto &line : statement.plan)
+    {
+        std::smatch match;
+        if (std::regex_search(line, match, scan))
+        {
+            const auto alias = aliases.find(match[1].str());
+            const auto table = alias == aliases.end() ? match[1].str() : alias->second;
+            if (large_tables_.contains(table))
+                out.push_back("SCAN " + table);
+        }
+        else if (std::regex_search(line, match, temp_btree))
+        {
+            out.push_back(match[1].str());
+        }
+    }
+
+    return out;
+}
+
+/* Nome do caso com os filtros presentes: find_all{category,active} */
+auto with_filters(const std::string &name, const std::vector<std::pair<std::string_view, bool>> &filters) -> std::string
+{
+    std::string out = name + "{";
+    bool first = true;
+    for (const auto &[filter, present] : filters)
+    {
+        if (!present)
+            continue;
+        if (!first)
+            out += ',';
+        out += filter;
+        first = false;
+    }
+    return out + "}";
+}
+
+auto cases() -> std::vector<Case>
+{
+    using namespace std::chrono;
+
+    static repository::ProductRepository products;
+    static repository::CustomerRepository customers;
+    static repository::OrderRepository orders;
+    static repository::OrderItemRepository order_items;
+    static repository::PaymentRepository payments;
+    static repository::InventoryRepository inventory;
+
+    const auto &ids = bench::seeded_ids();
+    const int new_order = ids.new_orders.front();
+    const int settled_order = ids.settled_orders.front();
+    const int open_payment = ids.open_payments.front();
+    const auto now = system_clock::now();
+
+    std::vector<Case> out;
+
+    // Produtos
+    out.push_back({"product.create", [] {
+                       models::Product product{0, "Plano", models::Category::TOOLS, 990, true, 10};
+                       products.create(product);
+                   }});
+    out.push_back({"product.find_by_id", [] { products.find_product_by_id(1); }});
+    out.push_back({"product.update", [] { (void)products.update(1, models::Product{1, "Plano", models::Category::TOOLS, 990, true, 10}); }});
+    out.push_back({"product.remove", [] { products.remove(999999); }});
+
+    for (int mask = 0; mask < 16; ++mask)
+    {
+        models::ProductFilters filters;
+        if (mask & 1)
+            filters.category = models::Category::KITCHEN;
+        if (mask & 2)
+            filters.active = true;
+        if (mask & 4)
+            filters.min_price_cents = 1000;
+        if (mask & 8)
+            filters.max_price_cents = 5000;
+
+        Case c{with_filters("product.find_all", {{"category", mask & 1}, {"active", mask & 2}, {"min_price", mask & 4}, {"max_price", mask & 8}}),
+               [filters] { products.find_all(filters); }};
+
+        // Sem categoria não há filtro seletivo: ativo e faixa de preço pegam boa parte do catálogo
+        if (!(mask & 1))
+            c.allowed.push_back({"SCAN products", "sem categoria o filtro não é seletivo"});
+
+        out.push_back(std::move(c));
+    }
+
+    // Clientes
+    out.push_back({"customer.create", [] {
+                       models::Customer customer{0, "Plano", "plano@lynx.dev", system_clock::now()};
+                       customers.create(customer);
+                   }});
+    out.push_back({"customer.find_by_id", [] { customers.find_by_id(1); }});
+    out.push_back({"customer.find_by_email", [] { customers.find_by_email("cliente1@lynx.dev"); }});
+
+    // Pedidos
+    out.push_back({"order.create", [] {
+                       models::Order order{};
+                       order.customer_id = 1;
+                       order.status = models::OrderStatus::NEW;
+                       order.created_at = system_clock::now();
+                       order.items.push_back({0, 0, 1, 1, 199});
+                       orders.create(order);
+                   }});
+    out.push_back({"order.find_by_id", [] { orders.find_by_id(1); }});
+    out.push_back({"order.find_by_id_with_customer", [] { orders.find_by_id_with_customer(1); }});
+    out.push_back({"order.find_all", [] { orders.find_all(); }, {{"SCAN orders", "lista todos os pedidos, sem filtro"}}});
+    out.push_back({"order.find_pending_deadlines", [] { orders.find_pending_deadlines(); }});
+    out.push_back({"order.update_status", [new_order] { (void)orders.update_status(new_order, models::OrderStatus::NEW); }});
+    out.push_back({"order.mark_settled_as_paid", [settled_order] { orders.mark_settled_as_paid({settled_order}); }});
+    out.push_back({"order.cancel_expired", [new_order, now] { orders.cancel_expired({new_order}, now - hours(24 * 365 * 100)); }});
+    out.push_back({"order.find_items_by_order_id", [] { orders.find_items_by_order_id(1); }});
+    out.push_back({"order.sum_items_total_by_order", [] { orders.sum_items_total_by_order(1); }});
+
+    for (int mask = 0; mask < 8; ++mask)
+    {
+        const auto status = mask & 1 ? std::optional<std::string>("NEW") : std::nullopt;
+        const auto customer_id = mask & 2 ? std::optional<int>(1) : std::nullopt;
+        const auto limit = mask & 4 ? std::optional<int>(100) : std::nullopt;
+
+        Case c{with_filters("order.find_all_summary", {{"status", mask & 1}, {"customer_id", mask & 2}, {"limit", mask & 4}}),
+               [=] { orders.find_all_summary(status, customer_id, limit); }};
+
+        // Sem filtro o índice de created_at só dá a ordem; a varredura é o próprio relatório
+        if (!(mask & 3))
+            c.allowed.push_back({"SCAN orders", "sem filtro: percorre created_at em ordem"});
+
+        out.push_back(std::move(c));
+    }
+
+    // Itens
+    out.push_back({"order_item.create", [] { order_items.create({0, 1, 1, 1, 199}); }});
+    out.push_back({"order_item.find_by_order_id", [] {
+                       int order_id = 1;
+                       order_items.find_by_order_id(order_id);
+                   }});
+
+    // Pagamentos
+    out.push_back({"payment.create", [new_order] {
+                       models::Payment payment{0, new_order, models::PaymentMethod::PIX, 100, std::nullopt};
+                       payments.create(payment);
+                   }});
+    out.push_back({"payment.find_by_id", [] { payments.find_by_id(1); }});
+    out.push_back({"payment.sum_by_order", [] { payments.sum_by_order(1); }});
+    out.push_back({"payment.update", [new_order] { payments.update(1, {1, new_order, models::PaymentMethod::PIX, 100, std::nullopt}); }});
+    out.push_back({"payment.mark_as_paid", [open_payment] { payments.mark_as_paid(open_payment, "2024-01-01 00:00:00"); }});
+    out.push_back({"payment.mark_as_paid_batch", [open_payment] {
+                       // O segundo já está pago: exercita o SELECT de fallback
+                       payments.mark_as_paid_batch({{open_payment, "2024-01-01 00:00:00"}, {open_payment, "2024-01-01 00:00:00"}});
+                   }});
+    out.push_back({"payment.remove", [] { payments.remove(999999); }});
+
+    for (int mask = 0; mask < 48; ++mask)
+    {
+        const int after = mask / 16; // 0: sem cursor, 1: só id, 2: (paid_at, id)
+
+        models::PaymentFilters filters;
+        if (mask & 1)
+            filters.order_id = 1;
+        if (mask & 2)
+            filters.method = models::PaymentMethod::PIX;
+        if (mask & 4)
+            filters.paid_from = now - hours(24 * 30);
+        if (mask & 8)
+            filters.paid_to = now;
+        if (after == 1)
+            filters.after = models::PaymentCursor{100, std::nullopt};
+        if (after == 2)
+            filters.after = models::PaymentCursor{100, now - hours(24 * 60)};
+
+        // O service recusa cursor de uma paginação usado na outra
+        if (after != 0 && (after == 2) != filters.pages_by_paid_at())
+            continue;
+
+        Case c{with_filters("payment.find_all", {{"order_id", mask & 1},
+                                                 {"method", mask & 2},
+                                                 {"paid_from", mask & 4},
+                                                 {"paid_to", mask & 8},
+                                                 {"after_id", after == 1},
+                                                 {"after_paid_at", after == 2}}),
+               [filters] { payments.find_all(filters); }};
+
+        // Listagem sem filtro pagina pela chave primária: o LIMIT para a varredura na primeira página
+        if (!(mask & 15) && after == 0)
+            c.allowed.push_back({"SCAN payments", "primeira página sem filtro, em ordem de id com LIMIT"});
+
+        // Com order_id o índice já restringe aos poucos pagamentos do pedido; ordená-los é trivial
+        if (mask & 1)
+            c.allowed.push_back({"USE TEMP B-TREE FOR ORDER BY", "ordena só os pagamentos de um pedido"});
+
+        out.push_back(std::move(c));
+    }
+
+    // Estoque
+    out.push_back({"inventory.find_stock", [] { inventory.find_stock(1); }});
+    out.push_back({"inventory.find_all_stock", [] { inventory.find_all_stock(); }, {{"SCAN products", "carga do estoque inteiro na subida"}}});
+    out.push_back({"inventory.sum_items_by_orders", [] { inventory.sum_items_by_orders({1, 2, 3}); },
+                   {{"USE TEMP B-TREE FOR GROUP BY", "agrupa só os itens do lote de pedidos"}}});
+    out.push_back({"inventory.write_back", [] { inventory.write_back({{1, 1}}); }});
+    out.push_back({"inventory.adjust_stock", [] { inventory.adjust_stock(1, 1); }});
+
+    return out;
+}
+
+auto render(const std::string &name, const std::vector<Statement> &statements) -> std::string
+{
+    std::string out = "## " + name + "\n";
+    for (const auto &statement : statements)
+    {
+        out += statement.sql + "\n";
+        for (const auto &line : statement.plan)
+            out += "  " + line + "\n";
+    }
+    return out;
+}
+
+/* Seções "## nome" do snapshot */
+auto read_snapshot(const std::string &path) -> std::map<std::string, std::string>
+{
+    std::ifstream file(path);
+    std::map<std::string, std::string> sections;
+
+    std::string line;
+    std::string current;
+    while (std::getline(file, line))
+    {
+        if (line.starts_with("## "))
+            current = line.substr(3);
+
+        if (!current.empty())
+            sections[current] += line + "\n";
+    }
+
+    return sections;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const bool update = argc > 1 && std::string_view(argv[1]) == "--update";
+
+    try
+    {
+        bench::open_temp_database();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Falha ao preparar o banco temporário: " << e.what() << "\n";
+        bench::remove_temp_database();
+        return 1;
+    }
+
+    database::QueryProfilerConfig config;
+    config.slow_threshold = std::chrono::hours(1);
+    database::QueryProfiler profiler(config);
+    profiler.attach(connection());
+
+    const auto expected = read_snapshot(LYNX_PLANS_SNAPSHOT);
+
+    std::string snapshot;
+    int failures = 0;
+
+    const auto fail = [&](const std::string &name, const std::string &message) {
+        std::cerr << "FALHA " << name << ": " << message << "\n";
+        ++failures;
+    };
+
+    for (const auto &c : cases())
+    {
+        profiler.reset();
+        try
+        {
+            c.run();
+        }
+        catch (const std::exception &e)
+        {
+            // Erro de negócio (404, 400...) ainda emite o SQL; só interessa o plano
+            (void)e;
+        }
+
+        std::vector<Statement> statements;
+        for (const auto &stats : profiler.snapshot())
+        {
+            if (is_query(stats.sql))
+                statements.push_back({stats.sql, explain(stats.sql)});
+        }
+        std::sort(statements.begin(), statements.end(), [](const Statement &a, const Statement &b) { return a.sql < b.sql; });
+
+        if (statements.empty())
+            fail(c.name, "nenhum SQL emitido; o caso não exercita mais o repositório");
+
+        for (const auto &statement : statements)
+        {
+            for (const auto &finding : findings(statement))
+            {
+                const auto allowed = std::find_if(c.allowed.begin(), c.allowed.end(), [&](const Allowance &a) { return a.finding == finding; });
+                if (allowed == c.allowed.end())
+                    fail(c.name, finding + " em: " + statement.sql);
+            }
+        }
+
+        const auto rendered = render(c.name, statements);
+        snapshot += rendered + "\n";
+
+        if (update)
+            continue;
+
+        const auto it = expected.find(c.name);
+        if (it == expected.end())
+            fail(c.name, "ausente do snapshot (rode com --update)");
+        else if (it->second != rendered + "\n")
+            fail(c.name, "plano mudou\n--- snapshot\n" + it->second + "--- atual\n" + rendered);
+    }
+
+    profiler.stop();
+    bench::remove_temp_database();
+
+    if (update)
+    {
+        std::ofstream(LYNX_PLANS_SNAPSHOT) << snapshot;
+        std::cout << "snapshot gravado em " << LYNX_PLANS_SNAPSHOT << "\n";
+    }
+
+    if (failures > 0)
+    {
+        std::cerr << failures << " falha(s)\n";
+        return 1;
+    }
+
+    std::cout << "planos conferidos\n";
+    return 0;
+}
@@ -0,0 +1,383 @@
+/*
+ * Replay de tráfego capturado (capture::TrafficRecorder) contra uma instância de teste, em geral o
+ * crow_api subido sobre uma cópia do banco de onde a captura saiu. Reproduz as requisições no ritmo
+ * original ou acelerado e compara, por rota, o status gravado com o recebido. O banco da instância é
+ * alterado pelas requisições de escrita.
+ *
+ *   lynx_replay --file capture.ndjson --port 8000 --json base.json
+ *   lynx_replay --file capture.ndjson --speed 4 --connections 32 --baseline base.json --max-p99-regression 1.5 --max-mismatch 1
+ *
+ * As duas latências da tabela são métricas diferentes e não se comparam entre si: a gravada é o tempo
+ * no servidor, sem rede nem fila; a do replay é medida no cliente em loopback, a partir do horário
+ * agendado, e inclui a fila do cliente quando as conexões não dão conta da agenda (ver "atraso
+ * máximo"). O limite de latência compara replay com replay: o p99 no cliente deste replay contra o de
+ * um --json anterior da mesma captura, com a mesma velocidade e conexões.
+ *
+ * Sai com 2 quando um limite de --max-p99-regression ou --max-mismatch é ultrapassado.
+ */
+
+#include "replay_runner.h"
+#include "utils/json_reader.h"
+#include "utils/json_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lynx;
+
+namespace
+{
+
+struct Options
+{
+    std::string file_path;
+    replay::ReplayConfig replay;
+    std::string baseline_path;     // --json de um replay anterior da mesma captura
+    double max_p99_regression = 0; // p99 no cliente / p99 no cliente da baseline; 0: sem limite
+    double max_mismatch = -1;      // % de status divergentes; negativo: sem limite
+    std::string json_path;
+};
+
+// Só o que o limite de latência lê de um --json anterior; as outras chaves são puladas
+struct BaselineLatency
+{
+    int64_t p99_ns = 0;
+};
+
+struct BaselineRoute
+{
+    BaselineLatency replayed_client;
+};
+
+struct Baseline
+{
+    BaselineRoute overall;
+};
+
+} // namespace
+
+template <> struct utils::json::JsonFields<BaselineLatency>
+{
+    static constexpr auto fields_ = std::make_tuple(field("p99_ns", &BaselineLatency::p99_ns));
+};
+
+template <> struct utils::json::JsonFields<BaselineRoute>
+{
+    static constexpr auto fields_ = std::make_tuple(field("replayed_client", &BaselineRoute::replayed_client));
+};
+
+template <> struct utils::json::JsonFields<Baseline>
+{
+    static constexpr auto fields_ = std::make_tuple(field("overall", &Baseline::overall));
+};
+
+namespace
+{
+
+struct Capture
+{
+    std::vector<capture::CapturedRequest> requests;
+    uint64_t truncated = 0; // corpo cortado na captura: não dá para reproduzir
+};
+
+template <typename T> auto parse_number(std::string_view text, T &out) -> bool
+{
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc() && end == text.data() + text.size();
+}
+
+auto usage() -> void
+{
+    std::cerr << "uso: lynx_replay --file capture.ndjson [--port P] [--speed x] [--connections N]\n"
+                 "                 [--baseline base.json --max-p99-regression r] [--max-mismatch %] [--json arquivo]\n";
+}
+
+auto parse_options(int argc, char **argv, Options &options) -> bool
+{
+    auto &replay = options.replay;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string_view flag = argv[i];
+        const std::string_view value = argv[i + 1];
+
+        int number = 0;
+        if (flag == "--file")
+        {
+            options.file_path = value;
+        }
+        else if (flag == "--port")
+        {
+            if (!parse_number(value, number) || number <= 0 || number > 65535)
+                return false;
+            replay.port = static_cast<uint16_t>(number);
+        }
+        else if (flag == "--speed")
+        {
+            if (!parse_number(value, replay.speed) || replay.speed <= 0)
+                return false;
+        }
+        else if (flag == "--connections")
+        {
+            if (!parse_number(value, replay.connections) || replay.connections <= 0)
+                return false;
+        }
+        else if (flag == "--baseline")
+        {
+            options.baseline_path = value;
+        }
+        else if (flag == "--max-p99-regression")
+        {
+            if (!parse_number(value, options.max_p99_regression) || options.max_p99_regression <= 0)
+                return false;
+        }
+        else if (flag == "--max-mismatch")
+        {
+            if (!parse_number(value, options.max_mismatch) || options.max_mismatch < 0)
+                return false;
+        }
+        else if (flag == "--json")
+        {
+            options.json_path = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (options.max_p99_regression > 0 && options.baseline_path.empty())
+        return false;
+
+    return argc % 2 == 1 && !options.file_path.empty();
+}
+
+auto load_capture(const std::string &path) -> Capture
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Arquivo de captura não encontrado: " + path);
+
+    Capture capture;
+    std::string line;
+    for (size_t number = 1; std::getline(in, line); ++number)
+    {
+        if (line.empty())
+            continue;
+
+        try
+        {
+            auto request = capture::parse_ndjson(line);
+
+            if (request.body_truncated)
+                ++capture.truncated;
+            else
+                capture.requests.push_back(std::move(request));
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error(path + ":" + std::to_string(number) + ": " + e.what());
+        }
+    }
+
+    // Threads do servidor gravam em lotes: a ordem do arquivo é só aproximada
+    std::stable_sort(capture.requests.begin(), capture.requests.end(),
+                     [](const auto &a, const auto &b) { return a.received_at_us < b.received_at_us; });
+
+    return capture;
+}
+
+auto to_ms(std::chrono::nanoseconds latency) -> double
+{
+    return std::chrono::duration<double, std::milli>(latency).count();
+}
+
+/* p99 no cliente do total de um --json anterior */
+auto load_baseline_p99(const std::string &path) -> std::chrono::nanoseconds
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Baseline não encontrada: " + path);
+
+    const std::string body((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    try
+    {
+        const auto baseline = utils::json::parse<Baseline>(body);
+        return std::chrono::nanoseconds(baseline.overall.replayed_client.p99_ns);
+    }
+    catch (const std::exception &e)
+    {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+auto mismatch_ratio(const replay::RouteComparison &route) -> double
+{
+    return route.requests == 0 ? 0.0 : 100.0 * static_cast<double>(route.status_mismatch + route.failed) / static_cast<double>(route.requests);
+}
+
+auto print_row(std::string_view name, const replay::RouteComparison &route) -> void
+{
+    std::printf("  %-32.*s %7llu %7llu %7llu %6llu | %9.2f %9.2f | %9.2f %9.2f\n", static_cast<int>(name.size()), name.data(),
+                static_cast<unsigned long long>(route.requests), static_cast<unsigned long long>(route.status_match),
+                static_cast<unsigned long long>(route.status_mismatch), static_cast<unsigned long long>(route.failed),
+                to_ms(route.recorded.percentile(0.50)), to_ms(route.recorded.percentile(0.99)), to_ms(route.replayed.percentile(0.50)),
+                to_ms(route.replayed.percentile(0.99)));
+}
+
+auto print_result(const replay::ReplayResult &result) -> void
+{
+    // Servidor (gravado) e cliente (replay) em blocos separados: medem coisas diferentes
+    std::printf("\n  %-32s %7s %7s %7s %6s | %-19s | %-19s\n", "", "", "", "", "", "servidor, gravado", "cliente, replay");
+    std::printf("  %-32s %7s %7s %7s %6s | %9s %9s | %9s %9s\n", "rota", "reqs", "status=", "status≠", "falha", "p50 ms", "p99 ms", "p50 ms",
+                "p99 ms");
+
+    for (const auto &[key, route] : result.routes)
+        print_row(key, route);
+
+    print_row("total", result.overall());
+
+    std::printf("\nstatus gravado -> replay\n");
+    for (const auto &[pair, count] : result.statuses)
+    {
+        const auto &[recorded, replayed] = pair;
+        std::printf("  %3d -> %-5s %8llu%s\n", recorded, replayed == 0 ? "falha" : std::to_string(replayed).c_str(),
+                    static_cast<unsigned long long>(count), recorded == replayed ? "" : "  divergente");
+    }
+}
+
+auto write_route(utils::json::JsonWriter &writer, const replay::RouteComparison &route) -> void
+{
+    writer.begin_object();
+    writer.key("requests").value(static_cast<int64_t>(route.requests));
+    writer.key("status_match").value(static_cast<int64_t>(route.status_match));
+    writer.key("status_mismatch").value(static_cast<int64_t>(route.status_mismatch));
+    writer.key("failed").value(static_cast<int64_t>(route.failed));
+
+    for (const auto &[name, latency] : {std::pair{"recorded_server", &route.recorded}, std::pair{"replayed_client", &route.replayed}})
+    {
+        writer.key(name).begin_object();
+        writer.key("p50_ns").value(static_cast<int64_t>(latency->percentile(0.50).count()));
+        writer.key("p90_ns").value(static_cast<int64_t>(latency->percentile(0.90).count()));
+        writer.key("p99_ns").value(static_cast<int64_t>(latency->percentile(0.99).count()));
+        writer.key("max_ns").value(static_cast<int64_t>(latency->max().count()));
+        writer.end_object();
+    }
+
+    writer.end_object();
+}
+
+auto write_json(const Options &options, const Capture &capture, const replay::ReplayResult &result) -> bool
+{
+    utils::json::JsonWriter writer;
+
+    writer.begin_object();
+    writer.key("file").value(std::string_view(options.file_path));
+    writer.key("speed").value(options.replay.speed);
+    writer.key("connections").value(static_cast<int64_t>(options.replay.connections));
+    writer.key("skipped_truncated").value(static_cast<int64_t>(capture.truncated));
+    writer.key("recorded_s").value(result.recorded_seconds);
+    writer.key("elapsed_s").value(result.elapsed_seconds);
+    writer.key("max_lag_ns").value(static_cast<int64_t>(result.max_lag.count()));
+
+    writer.key("overall");
+    write_route(writer, result.overall());
+
+    writer.key("routes").begin_object();
+    for (const auto &[key, route] : result.routes)
+    {
+        writer.key(key);
+        write_route(writer, route);
+    }
+    writer.end_object();
+
+    writer.key("statuses").begin_array();
+    for (const auto &[pair, count] : result.statuses)
+    {
+        writer.begin_object();
+        writer.key("recorded").value(static_cast<int64_t>(pair.first));
+        writer.key("replayed").value(static_cast<int64_t>(pair.second));
+        writer.key("count").value(static_cast<int64_t>(count));
+        writer.end_object();
+    }
+    writer.end_array();
+    writer.end_object();
+
+    std::ofstream out(options.json_path);
+    out << writer.buffer() << '\n';
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        const auto baseline_p99 = options.baseline_path.empty() ? std::chrono::nanoseconds(0) : load_baseline_p99(options.baseline_path);
+
+        const auto capture = load_capture(options.file_path);
+        if (capture.requests.empty())
+            throw std::runtime_error("Nenhuma requisição reproduzível em " + options.file_path);
+
+        std::printf("%zu requisições (%llu com corpo cortado ignoradas), velocidade %.2gx, %d conexões, porta %u\n",
+                    capture.requests.size(), static_cast<unsigned long long>(capture.truncated), options.replay.speed,
+                    options.replay.connections, static_cast<unsigned>(options.replay.port));
+
+        const auto result = replay::run_replay(options.replay, capture.requests);
+
+        std::printf("captura de %.1f s reproduzida em %.1f s, atraso máximo %.2f ms\n", result.recorded_seconds, result.elapsed_seconds,
+                    to_ms(result.max_lag));
+        print_result(result);
+
+        if (!options.json_path.empty() && !write_json(options, capture, result))
+            std::cerr << "Falha ao gravar " << options.json_path << "\n";
+
+        const auto overall = result.overall();
+        bool regressed = false;
+
+        if (!options.baseline_path.empty())
+        {
+            const auto p99 = overall.replayed.percentile(0.99);
+            const auto regression = baseline_p99.count() > 0 ? static_cast<double>(p99.count()) / static_cast<double>(baseline_p99.count()) : 0.0;
+
+            std::printf("\np99 no cliente: %.2f ms, baseline %.2f ms (%.2fx)\n", to_ms(p99), to_ms(baseline_p99), regression);
+
+            if (options.max_p99_regression > 0 && regression > options.max_p99_regression)
+            {
+                std::printf("REGRESSÃO: p99 no cliente %.2fx o da baseline (limite %.2fx)\n", regression, options.max_p99_regression);
+                regressed = true;
+            }
+        }
+
+        if (options.max_mismatch >= 0 && mismatch_ratio(overall) > options.max_mismatch)
+        {
+            std::printf("\nREGRESSÃO: %.2f%% das respostas com status divergente ou falha (limite %.2f%%)\n", mismatch_ratio(overall),
+                        options.max_mismatch);
+            regressed = true;
+        }
+
+        return regressed ? 2 : 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
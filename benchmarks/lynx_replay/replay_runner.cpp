@@ -0,0 +1,166 @@
+#include "replay_runner.h"
+#include "http_client.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace lynx::replay
+{
+
+using Clock = std::chrono::steady_clock;
+
+auto RouteComparison::merge(const RouteComparison &other) -> void
+{
+    recorded.merge(other.recorded);
+    replayed.merge(other.replayed);
+    requests += other.requests;
+    status_match += other.status_match;
+    status_mismatch += other.status_mismatch;
+    failed += other.failed;
+}
+
+auto ReplayResult::overall() const -> RouteComparison
+{
+    RouteComparison sum;
+    for (const auto &[key, route] : routes)
+        sum.merge(route);
+
+    return sum;
+}
+
+auto route_key(std::string_view method, std::string_view path) -> std::string
+{
+    std::string key(method);
+    key += ' ';
+
+    while (!path.empty())
+    {
+        const auto slash = path.find('/', 1);
+        const auto segment = path.substr(0, slash);
+        path = slash == std::string_view::npos ? std::string_view{} : path.substr(slash);
+
+        const bool numeric = segment.size() > 1 && std::all_of(segment.begin() + 1, segment.end(), [](char c) { return c >= '0' && c <= '9'; });
+        key += numeric ? std::string_view("/{id}") : segment;
+    }
+
+    return key;
+}
+
+namespace
+{
+
+struct Connection
+{
+    std::map<std::string, RouteComparison> routes;
+    std::map<std::pair<int, int>, uint64_t> statuses;
+    Clock::duration max_lag{0};
+    Clock::time_point finished_at;
+};
+
+auto offset_of(const capture::CapturedRequest &request, int64_t first_us, double speed) -> Clock::duration
+{
+    const auto seconds = static_cast<double>(request.received_at_us - first_us) / 1e6 / speed;
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+auto run_connection(const ReplayConfig &config, const std::vector<capture::CapturedRequest> &requests, const std::vector<std::string> &keys,
+                    size_t index, Clock::time_point start, Connection &connection) -> void
+{
+    bench::HttpClient client(config.port, config.timeout);
+
+    const auto first_us = requests.front().received_at_us;
+    std::string target;
+    std::string headers;
+
+    for (auto i = index; i < requests.size(); i += static_cast<size_t>(config.connections))
+    {
+        const auto &request = requests[i];
+        const auto intended = start + offset_of(request, first_us, config.speed);
+
+        std::this_thread::sleep_until(intended);
+        connection.max_lag = std::max(connection.max_lag, Clock::now() - intended);
+
+        target = request.path;
+        if (!request.query.empty())
+            target.append("?").append(request.query);
+
+        // Accept e Accept-Encoding decidem MessagePack e compressão: sem eles o replay mediria outra resposta
+        headers.clear();
+        if (!request.accept.empty())
+            headers.append("Accept: ").append(request.accept).append("\r\n");
+        if (!request.accept_encoding.empty())
+            headers.append("Accept-Encoding: ").append(request.accept_encoding).append("\r\n");
+
+        const auto content_type = request.content_type.empty() ? std::string_view("application/json") : std::string_view(request.content_type);
+        const auto response = client.send(request.method, target, request.body, content_type, headers);
+        const auto completed = Clock::now();
+
+        auto &route = connection.routes[keys[i]];
+        ++route.requests;
+        ++connection.statuses[{request.status, response.status}];
+
+        if (response.status == 0)
+        {
+            ++route.failed;
+            continue;
+        }
+
+        ++(response.status == request.status ? route.status_match : route.status_mismatch);
+        route.replayed.record(completed - intended);
+    }
+
+    connection.finished_at = Clock::now();
+}
+
+} // namespace
+
+auto run_replay(const ReplayConfig &config, const std::vector<capture::CapturedRequest> &requests) -> ReplayResult
+{
+    ReplayResult result;
+    if (requests.empty())
+        return result;
+
+    std::vector<std::string> keys;
+    keys.reserve(requests.size());
+    for (const auto &request : requests)
+    {
+        keys.push_back(route_key(request.method, request.path));
+        result.routes[keys.back()].recorded.record(std::chrono::microseconds(request.duration_us));
+    }
+
+    result.recorded_seconds = static_cast<double>(requests.back().received_at_us - requests.front().received_at_us) / 1e6;
+
+    const auto connection_count = std::min(static_cast<size_t>(config.connections), requests.size());
+    std::vector<Connection> connections(connection_count);
+
+    // Margem para todas as threads estarem de pé antes do primeiro envio agendado
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+
+    std::vector<std::thread> workers;
+    workers.reserve(connection_count);
+    for (size_t i = 0; i < connection_count; ++i)
+    {
+        workers.emplace_back(run_connection, std::cref(config), std::cref(requests), std::cref(keys), i, start, std::ref(connections[i]));
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    auto finished = start;
+    for (const auto &connection : connections)
+    {
+        for (const auto &[key, route] : connection.routes)
+            result.routes[key].merge(route);
+
+        for (const auto &[pair, count] : connection.statuses)
+            result.statuses[pair] += count;
+
+        result.max_lag = std::max(result.max_lag, std::chrono::duration_cast<std::chrono::nanoseconds>(connection.max_lag));
+        finished = std::max(finished, connection.finished_at);
+    }
+
+    result.elapsed_seconds = std::chrono::duration<double>(finished - start).count();
+    return result;
+}
+
+} // namespace lynx::replay
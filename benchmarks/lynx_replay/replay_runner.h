@@ -0,0 +1,58 @@
+#pragma once
+
+#include "capture/traffic_recorder.h"
+#include "latency_histogram.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace lynx::replay
+{
+
+struct ReplayConfig
+{
+    uint16_t port = 8000;
+    double speed = 1;    // 1: ritmo original; 10: dez vezes mais rápido
+    int connections = 16;
+    std::chrono::milliseconds timeout{10000};
+};
+
+struct RouteComparison
+{
+    bench::LatencyHistogram recorded; // duration_us da captura, medido no servidor
+    bench::LatencyHistogram replayed; // do horário agendado até a resposta, no cliente
+    uint64_t requests = 0;
+    uint64_t status_match = 0;
+    uint64_t status_mismatch = 0;
+    uint64_t failed = 0; // conexão recusada, timeout ou resposta inválida
+
+    auto merge(const RouteComparison &other) -> void;
+};
+
+struct ReplayResult
+{
+    std::map<std::string, RouteComparison> routes;          // "GET /api/orders/{id}"
+    std::map<std::pair<int, int>, uint64_t> statuses;       // (gravado, replay) -> requisições; replay 0 é falha
+    double recorded_seconds = 0;                            // janela da captura
+    double elapsed_seconds = 0;
+    std::chrono::nanoseconds max_lag{0}; // maior atraso de um envio sobre a agenda: conexões de menos
+
+    auto overall() const -> RouteComparison;
+};
+
+/* Método e caminho com os segmentos numéricos trocados por {id}, para agrupar a mesma rota */
+auto route_key(std::string_view method, std::string_view path) -> std::string;
+
+/*
+ * Reproduz as requisições (ordenadas por received_at_us) na agenda original dividida por speed, em
+ * malha aberta como o lynx_loadgen: a requisição i sai pela conexão i % connections e a latência conta
+ * a partir do horário agendado, então fila no cliente aparece como latência, não some.
+ */
+auto run_replay(const ReplayConfig &config, const std::vector<capture::CapturedRequest> &requests) -> ReplayResult;
+
+} // namespace lynx::replay
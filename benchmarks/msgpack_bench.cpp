@@ -0,0 +1,130 @@
+/*
+ * Tamanho e vazão de codificação/decodificação em JSON e MessagePack para as respostas de
+ * /api/orders/summary e /api/products e para o corpo de criação de pedido.
+ * Uso: msgpack_bench [linhas] [iterações]
+ */
+
+#include "models/dtos/dto_msgpack.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+using namespace lynx::models;
+
+template <typename Run> auto time_per_call(int iterations, Run &&run) -> double
+{
+    size_t sink = run();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        sink += run();
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (sink == 0)
+        std::abort();
+
+    return elapsed / iterations;
+}
+
+template <typename T> auto encode_json(const T &value, size_t reserve) -> std::string
+{
+    utils::json::JsonWriter writer(reserve);
+    utils::json::write(writer, value);
+    return writer.take();
+}
+
+template <typename T> auto encode_msgpack(const T &value, size_t reserve) -> std::string
+{
+    utils::msgpack::MsgPackWriter writer(reserve);
+    utils::msgpack::write(writer, value);
+    return writer.take();
+}
+
+template <typename T> auto decode_json(std::string_view body) -> T
+{
+    utils::json::JsonReader reader(body, utils::json::ReaderLimits{1 << 20});
+    T value{};
+    utils::json::read(reader, value);
+    reader.finish();
+    return value;
+}
+
+template <typename T> auto decode_msgpack(std::string_view body) -> T
+{
+    utils::msgpack::MsgPackReader reader(body, utils::json::ReaderLimits{1 << 20});
+    T value{};
+    utils::json::read(reader, value);
+    reader.finish();
+    return value;
+}
+
+auto report(const char *name, size_t json_bytes, size_t msgpack_bytes, double json_us, double msgpack_us) -> void
+{
+    std::cout << name << "\n"
+              << "  JSON:        " << json_bytes << " bytes, " << json_us << " us, " << json_bytes / json_us << " MB/s\n"
+              << "  MessagePack: " << msgpack_bytes << " bytes (" << 100.0 * msgpack_bytes / json_bytes << "%), " << msgpack_us << " us, "
+              << msgpack_bytes / msgpack_us << " MB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t rows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    const auto now = std::chrono::system_clock::from_time_t(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+
+    std::vector<dto::OrderSummaryDTO> orders;
+    std::vector<dto::ProductResponseDTO> products;
+    dto::OrderCreateDTO order_body{42, {}};
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto id = static_cast<int>(i + 1);
+        orders.push_back({id, id % 500 + 1, i % 3 == 0 ? "PAID" : "NEW", now - std::chrono::minutes(i), 1999 + 100 * static_cast<int64_t>(i % 50),
+                          i % 3 == 0 ? 1999 : 0});
+        products.push_back({id, "Produto " + std::to_string(id), static_cast<Category>(i % 13), 990 + static_cast<int>(i % 400) * 25, i % 7 != 0,
+                            static_cast<int>(i % 120)});
+        if (i < 1000)
+            order_body.items.push_back({id % 500 + 1, static_cast<int>(i % 7 + 1)});
+    }
+
+    std::cout << rows << " linhas, " << iterations << " iterações\n\n";
+
+    {
+        const auto json = encode_json(orders, 2 + rows * 144);
+        const auto packed = encode_msgpack(orders, 5 + rows * 96);
+        report("Codificar /api/orders/summary", json.size(), packed.size(),
+               time_per_call(iterations, [&] { return encode_json(orders, 2 + rows * 144).size(); }),
+               time_per_call(iterations, [&] { return encode_msgpack(orders, 5 + rows * 96).size(); }));
+    }
+
+    {
+        const auto json = encode_json(products, 2 + rows * 112);
+        const auto packed = encode_msgpack(products, 5 + rows * 80);
+        report("Codificar /api/products", json.size(), packed.size(),
+               time_per_call(iterations, [&] { return encode_json(products, 2 + rows * 112).size(); }),
+               time_per_call(iterations, [&] { return encode_msgpack(products, 5 + rows * 80).size(); }));
+
+        report("Decodificar /api/products", json.size(), packed.size(),
+               time_per_call(iterations, [&] { return decode_json<std::vector<dto::ProductResponseDTO>>(json).size(); }),
+               time_per_call(iterations, [&] { return decode_msgpack<std::vector<dto::ProductResponseDTO>>(packed).size(); }));
+    }
+
+    {
+        const auto json = encode_json(order_body, 0);
+        const auto packed = encode_msgpack(order_body, 0);
+        report("Decodificar corpo de POST /api/orders", json.size(), packed.size(),
+               time_per_call(iterations * 20, [&] { return decode_json<dto::OrderCreateDTO>(json).items.size(); }),
+               time_per_call(iterations * 20, [&] { return decode_msgpack<dto::OrderCreateDTO>(packed).items.size(); }));
+    }
+
+    return 0;
+}
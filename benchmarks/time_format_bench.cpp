@@ -0,0 +1,124 @@
+/*
+ * Formatação e leitura de horários: o caminho antigo (localtime_r + put_time num stringstream,
+ * get_time + mktime na volta) contra utils::time::format_time/parse_time, em uma thread e escalando
+ * de 1 até o número de threads pedido. Os horários andam um minuto por linha, como numa listagem.
+ * Uso: time_format_bench [threads máximas] [horários por thread]
+ */
+
+#include "utils/time/time_format.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::system_clock;
+
+// Como era o utils::time::time_point_to_string
+auto legacy_format(const Clock::time_point &tp) -> std::string
+{
+    auto tt = Clock::to_time_t(tp);
+    std::tm tm{};
+    localtime_r(&tt, &tm);
+
+    std::stringstream ss;
+    ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    return ss.str();
+}
+
+// Como era o utils::time::string_to_time_point
+auto legacy_parse(const std::string &s) -> Clock::time_point
+{
+    std::tm tm{};
+    std::istringstream ss(s);
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    return Clock::from_time_t(std::mktime(&tm));
+}
+
+auto sample_times(int count) -> std::vector<Clock::time_point>
+{
+    const auto start = Clock::from_time_t(1'700'000'000);
+
+    std::vector<Clock::time_point> times;
+    times.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        times.push_back(start - std::chrono::minutes(i));
+    }
+    return times;
+}
+
+// Nanossegundos por chamada com `threads` threads rodando work(índice) sobre `count` itens cada
+template <typename Work> auto run(unsigned threads, int count, Work &&work) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&] {
+            size_t sink = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                sink += work(i);
+            }
+
+            if (sink == 0)
+                std::abort();
+        });
+    }
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(threads) * count);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 8;
+    const int count = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    const auto times = sample_times(count);
+
+    std::vector<std::string> texts;
+    texts.reserve(count);
+    for (const auto &tp : times)
+    {
+        texts.push_back(utils::time::format_time(tp, utils::time::TimeFormat::sql));
+    }
+
+    const auto format_legacy = [&](int i) { return legacy_format(times[i]).size(); };
+    const auto format_new = [&](int i) {
+        char buffer[utils::time::max_time_length_];
+        return utils::time::format_time(times[i], utils::time::TimeFormat::iso8601, buffer);
+    };
+    const auto parse_legacy = [&](int i) { return static_cast<size_t>(legacy_parse(texts[i]).time_since_epoch().count() & 1) + 1; };
+    const auto parse_new = [&](int i) {
+        Clock::time_point tp;
+        return static_cast<size_t>(utils::time::parse_time(texts[i], tp));
+    };
+
+    std::cout << count << " horários por thread; tempo de parede / chamadas totais, em ns (escala ideal cai pela metade a cada linha)\n\n";
+    std::cout << "threads  formatar(antigo)  formatar(novo)  ler(antigo)  ler(novo)\n";
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+    {
+        std::cout << std::setw(7) << threads << std::setw(18) << run(threads, count, format_legacy) << std::setw(16) << run(threads, count, format_new)
+                  << std::setw(13) << run(threads, count, parse_legacy) << std::setw(11) << run(threads, count, parse_new) << "\n";
+    }
+
+    return 0;
+}
@@ -13,7 +13,8 @@ CREATE TABLE IF NOT EXISTS products (
   name TEXT NOT NULL,
   category TEXT NOT NULL,
   price_cents INTEGER NOT NULL CHECK (price_cents >= 0),
-  active INTEGER NOT NULL DEFAULT 1
+  active INTEGER NOT NULL DEFAULT 1,
+  stock INTEGER -- NULL: estoque não controlado, o produto nunca esgota
 );
 
 CREATE TABLE IF NOT EXISTS orders (
@@ -42,3 +43,32 @@ CREATE TABLE IF NOT EXISTS payments (
   paid_at TIMESTAMP,
   FOREIGN KEY (order_id) REFERENCES orders(id)
 );
+
+-- Último order_item já descontado de products.stock pelo write-back do estoque
+CREATE TABLE IF NOT EXISTS inventory_checkpoint (
+  id INTEGER PRIMARY KEY CHECK (id = 1),
+  last_order_item_id INTEGER NOT NULL
+);
+
+INSERT OR IGNORE INTO inventory_checkpoint (id, last_order_item_id)
+VALUES (1, (SELECT COALESCE(MAX(id), 0) FROM order_items));
+
+-- Migrações aplicadas na subida (src/database/migrations.cpp). Este script também roda sobre bancos
+-- antigos a cada "docker compose up", então não registra migração nenhuma: quem decide é a aplicação
+CREATE TABLE IF NOT EXISTS schema_migrations (
+  name TEXT PRIMARY KEY,
+  applied_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
+);
+
+
+-- Indexes
+CREATE INDEX IF NOT EXISTS idx_order_items_order_id ON order_items(order_id);
+CREATE INDEX IF NOT EXISTS idx_payments_order_id ON payments(order_id);
+CREATE INDEX IF NOT EXISTS idx_payments_method ON payments(method);
+CREATE INDEX IF NOT EXISTS idx_payments_paid_at ON payments(paid_at);
+CREATE INDEX IF NOT EXISTS idx_payments_method_paid_at ON payments(method, paid_at);
+CREATE INDEX IF NOT EXISTS idx_orders_status_created_at ON orders(status, created_at);
+CREATE INDEX IF NOT EXISTS idx_orders_created_at ON orders(created_at);
+CREATE INDEX IF NOT EXISTS idx_orders_customer_id_created_at ON orders(customer_id, created_at);
+CREATE INDEX IF NOT EXISTS idx_products_category_active ON products(category, active);
+CREATE INDEX IF NOT EXISTS idx_order_items_product_id ON order_items(product_id);
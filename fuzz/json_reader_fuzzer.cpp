@@ -0,0 +1,75 @@
+/*
+ * Alvo libFuzzer do JsonReader: todo corpo aleatório precisa terminar em DTO válido ou em CustomError,
+ * e um DTO lido precisa sobreviver à volta escrita → leitura sem mudar.
+ * Uso: json_reader_fuzzer fuzz/corpus/json_reader
+ */
+
+#include "models/dtos/dto_json.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+auto same(const lynx::models::dto::OrderCreateDTO &a, const lynx::models::dto::OrderCreateDTO &b) -> bool
+{
+    if (a.customer_id != b.customer_id || a.items.size() != b.items.size())
+        return false;
+
+    for (size_t i = 0; i < a.items.size(); ++i)
+    {
+        if (a.items[i].product_id != b.items[i].product_id || a.items[i].quantity != b.items[i].quantity)
+            return false;
+    }
+
+    return true;
+}
+
+auto same(const lynx::models::dto::CustomerCreateDTO &a, const lynx::models::dto::CustomerCreateDTO &b) -> bool
+{
+    return a.name == b.name && a.email == b.email;
+}
+
+template <typename T> auto round_trip(std::string_view body) -> void
+{
+    T parsed;
+    try
+    {
+        parsed = utils::json::parse<T>(body);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+        return;
+    }
+
+    utils::json::JsonWriter writer;
+    utils::json::write(writer, parsed);
+
+    if (!same(parsed, utils::json::parse<T>(writer.buffer())))
+        std::abort();
+}
+
+template <typename T> auto parse_only(std::string_view body) -> void
+{
+    try
+    {
+        utils::json::parse<T>(body);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const std::string_view body(reinterpret_cast<const char *>(data), size);
+
+    round_trip<lynx::models::dto::OrderCreateDTO>(body);
+    round_trip<lynx::models::dto::CustomerCreateDTO>(body);
+    parse_only<lynx::models::dto::PaymentCreateDTO>(body);
+    parse_only<lynx::models::dto::ProductCreateDTO>(body);
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "admission/concurrency_limiter.h"
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace lynx::admission
+{
+
+struct AdmissionConfig
+{
+    // GET passa pelo limite de leitura, o resto pelo de escrita (o SQLite serializa as escritas)
+    LimiterConfig read;
+    LimiterConfig write{.initial_limit = 8, .min_limit = 2, .max_limit = 64};
+
+    std::chrono::seconds retry_after{1};
+};
+
+/*
+ * Controle de admissão na frente da camada de dados: classifica a requisição (leitura/escrita e
+ * prioridade pela rota) e decide pelo limitador correspondente. /metrics nunca é limitado.
+ */
+class AdmissionControl
+{
+private:
+    AdmissionConfig config_;
+    ConcurrencyLimiter read_;
+    ConcurrencyLimiter write_;
+
+public:
+    explicit AdmissionControl(const AdmissionConfig &config = AdmissionConfig());
+
+    /* nullptr para rotas isentas */
+    auto limiter_for(std::string_view method, std::string_view url) -> ConcurrencyLimiter *;
+
+    static auto priority_for(std::string_view url) -> Priority;
+
+    auto retry_after() const -> std::chrono::seconds;
+
+    /* Estado dos limitadores no formato de texto do Prometheus, para um coletor do MetricsRegistry */
+    auto render(std::string &out) const -> void;
+};
+
+} // namespace lynx::admission
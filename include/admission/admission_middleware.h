@@ -0,0 +1,34 @@
+#pragma once
+
+#include "admission/admission_control.h"
+#include <chrono>
+#include <crow.h>
+#include <memory>
+
+namespace lynx::admission
+{
+
+/*
+ * Middleware do Crow que reserva uma vaga no limitador antes do handler e a devolve com a latência
+ * no fim. Sem vaga, responde 503 com Retry-After sem chegar ao handler. Sem AdmissionControl
+ * configurado (set_control) não faz nada.
+ */
+struct AdmissionMiddleware
+{
+    struct context
+    {
+        ConcurrencyLimiter *limiter = nullptr;
+        int64_t in_flight = 0;
+        std::chrono::steady_clock::time_point started_at;
+    };
+
+    auto set_control(std::shared_ptr<AdmissionControl> control) -> void;
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+
+private:
+    std::shared_ptr<AdmissionControl> control_;
+};
+
+} // namespace lynx::admission
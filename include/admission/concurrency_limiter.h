@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace lynx::admission
+{
+
+/* Ordem de descarte: low sai primeiro, critical (pagamentos) por último */
+enum class Priority
+{
+    low,
+    normal,
+    critical
+};
+
+struct LimiterConfig
+{
+    double initial_limit = 20;
+    double min_limit = 4;
+    double max_limit = 200;
+
+    // Latência até tolerance × a referência sem fila ainda não reduz o limite
+    double tolerance = 1.5;
+    double smoothing = 0.2;
+    size_t short_window = 10;      // amostras na média curta de latência
+    size_t baseline_window = 1000; // amostras por janela do mínimo; a referência é o menor das duas últimas
+
+    // Fração do limite que cada prioridade pode ocupar; o que sobra fica reservado às de cima
+    double low_share = 0.75;
+    double normal_share = 0.9;
+};
+
+struct LimiterStats
+{
+    int64_t limit = 0;
+    int64_t in_flight = 0;
+    double baseline_rtt_micros = 0;
+    double rtt_micros = 0;
+    std::array<uint64_t, 3> admitted{};
+    std::array<uint64_t, 3> rejected{};
+};
+
+/*
+ * Limite de concorrência adaptativo por gradiente (no estilo do concurrency-limits da Netflix): a
+ * menor latência recente é a referência sem fila e a média curta das amostras é comparada com ela.
+ * Acima de tolerance × referência o limite encolhe na proporção (até metade); abaixo, cresce √limite.
+ * A referência vem de janelas deslizantes para acompanhar mudanças reais do banco (tabelas crescendo).
+ *
+ * A admissão é um CAS no contador em voo, sem trava. A atualização do limite usa try_lock: sob
+ * disputa a amostra é descartada em vez de enfileirar as threads.
+ */
+class ConcurrencyLimiter
+{
+private:
+    LimiterConfig config_;
+
+    std::atomic<int64_t> in_flight_{0};
+    std::atomic<int64_t> limit_;
+
+    std::array<std::atomic<uint64_t>, 3> admitted_{};
+    std::array<std::atomic<uint64_t>, 3> rejected_{};
+
+    mutable std::mutex update_mutex_;
+    double estimated_limit_;
+    double rtt_micros_ = 0;
+    double window_min_micros_ = 0;
+    double previous_min_micros_ = 0;
+    size_t samples_ = 0;
+
+    auto allowed_for(Priority priority) const -> int64_t;
+
+public:
+    explicit ConcurrencyLimiter(const LimiterConfig &config = LimiterConfig());
+
+    /* Reserva uma vaga; false se a prioridade já ocupou sua fração do limite. Devolve em in_flight o valor após reservar */
+    auto try_acquire(Priority priority, int64_t &in_flight) -> bool;
+
+    /* Libera a vaga e usa a latência como amostra; in_flight é o valor devolvido por try_acquire */
+    auto release(std::chrono::nanoseconds latency, int64_t in_flight) -> void;
+
+    auto stats() const -> LimiterStats;
+};
+
+} // namespace lynx::admission
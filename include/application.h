@@ -0,0 +1,59 @@
+#pragma once
+
+#include "admission/admission_control.h"
+#include "cache/order_details_cache.h"
+#include "cache/product_fragment_store.h"
+#include "capture/traffic_recorder.h"
+#include "database/query_cache.h"
+#include "database/query_profiler.h"
+#include "inventory/stock_inventory.h"
+#include "repository/decorators/repository_coalescing.h"
+#include "server.h"
+#include "services/order_expiry_services.h"
+
+#include <memory>
+
+namespace lynx::app
+{
+
+struct ApplicationConfig
+{
+    server::ServerConfig server;
+    admission::AdmissionConfig admission;
+    database::QueryProfilerConfig profiler;
+    database::QueryCacheConfig query_cache;
+    repository::decorators::CoalescingConfig coalescing;
+    cache::OrderDetailsCacheConfig order_details_cache;
+    cache::ProductFragmentConfig product_fragments;
+    inventory::InventoryConfig inventory;
+    services::OrderExpiryConfig expiry;
+    capture::CaptureConfig capture;
+};
+
+/*
+ * A API montada como em produção: repositórios instrumentados, ledger, estoque, expiração, services,
+ * controllers e coletores de /metrics. Usada pelo main e pelo lynx_loadgen, que sobe e derruba uma
+ * instância por cenário no mesmo processo.
+ */
+class Application
+{
+private:
+    std::unique_ptr<server::Server> server_;
+    std::shared_ptr<database::QueryProfiler> query_profiler_;
+    std::shared_ptr<database::QueryCache> query_cache_;
+    std::shared_ptr<capture::TrafficRecorder> traffic_recorder_;
+    std::shared_ptr<inventory::StockInventory> stock_inventory_;
+    std::shared_ptr<services::OrderExpiryServices> order_expiry_service_;
+
+public:
+    explicit Application(const ApplicationConfig &config);
+
+    /* Sobe os serviços de fundo e o servidor; bloqueia até stop() e então encerra os serviços de fundo */
+    auto run() -> void;
+
+    /* Para outra thread: espera o servidor aceitar conexões */
+    auto wait_until_ready() -> void;
+    auto stop() -> void;
+};
+
+} // namespace lynx::app
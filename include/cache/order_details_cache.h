@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace lynx::cache
+{
+
+struct OrderDetailsCacheConfig
+{
+    bool enabled = true;
+    size_t max_bytes = 32 * 1024 * 1024; // corpos guardados mais o custo fixo por entrada, dividido entre os shards
+    size_t shards = 16;
+};
+
+/* Codificação do corpo guardado; cada pedido pode ter as duas */
+enum class Encoding : uint8_t
+{
+    json,
+    msgpack
+};
+
+struct OrderDetailsCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidations = 0; // pedidos removidos por escrita (status, pagamento) ou por invalidate_all
+    uint64_t evicted = 0;       // removidos pelo limite de memória
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+};
+
+/*
+ * Corpos já serializados de GET /api/orders/<id>, por pedido e codificação.
+ *
+ * Só pedidos PAID ou CANCELLED entram (quem chama decide): itens e status não mudam mais, então um hit
+ * é uma busca no shard e a cópia do corpo para a resposta. As escritas que mexem no detalhe chamam
+ * invalidate (status, pagamento) ou invalidate_all (nome de produto). Cada shard tem uma geração que
+ * sobe a cada invalidação; quem monta o corpo tira a geração ANTES de ler o banco e store() recusa o
+ * corpo se ela mudou no meio, para uma invalidação concorrente nunca ser desfeita por um corpo antigo.
+ */
+class OrderDetailsCache
+{
+private:
+    // Nós do mapa e do LRU e o shared_ptr do corpo
+    static constexpr size_t entry_overhead_ = 128;
+
+    struct Entry
+    {
+        std::shared_ptr<const std::string> body;
+        std::list<uint64_t>::iterator lru; // a frente é a mais recente
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+        std::list<uint64_t> lru;
+        size_t bytes = 0;
+        std::atomic<uint64_t> generation{0};
+    };
+
+    OrderDetailsCacheConfig config_;
+    size_t shard_budget_;
+    std::unique_ptr<Shard[]> shards_;
+
+    alignas(64) std::atomic<uint64_t> hits_{0};
+    alignas(64) std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> evicted_{0};
+
+    // As duas codificações do pedido caem no mesmo shard: invalidate trava um só
+    auto shard_for(int order_id) -> Shard &;
+    auto erase(Shard &shard, std::unordered_map<uint64_t, Entry>::iterator it) -> void;
+
+public:
+    explicit OrderDetailsCache(const OrderDetailsCacheConfig &config = OrderDetailsCacheConfig());
+
+    OrderDetailsCache(const OrderDetailsCache &) = delete;
+    OrderDetailsCache &operator=(const OrderDetailsCache &) = delete;
+
+    auto enabled() const -> bool;
+
+    /* nullptr: ausente (ou cache desligado) */
+    auto find(int order_id, Encoding encoding) -> std::shared_ptr<const std::string>;
+
+    /* Tirar antes de ler o banco; o valor vai para store() */
+    auto generation(int order_id) -> uint64_t;
+    auto store(int order_id, Encoding encoding, uint64_t generation, std::string body) -> void;
+
+    auto invalidate(int order_id) -> void;
+    auto invalidate_all() -> void;
+
+    auto stats() -> OrderDetailsCacheStats;
+    auto render(std::string &out) -> void;
+};
+
+} // namespace lynx::cache
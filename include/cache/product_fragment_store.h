@@ -0,0 +1,89 @@
+#pragma once
+
+#include "models/dtos/dto_product.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::cache
+{
+
+struct ProductFragmentConfig
+{
+    bool enabled = true;         // desligado: cada produto é escrito pelo JsonWriter, sem guardar nada
+    size_t max_entries = 100000; // fragmentos guardados, dividido entre os shards
+};
+
+struct ProductFragmentStats
+{
+    uint64_t reused = 0;   // fragmento pronto copiado para a resposta
+    uint64_t rendered = 0; // produto novo ou alterado: objeto reescrito pelo JsonWriter
+    uint64_t evicted = 0;  // removidos pelo limite de entradas ou por produto inexistente
+    uint64_t entries = 0;
+};
+
+/*
+ * JSON pré-renderizado de cada produto ({"id":..,"name":..,...}), pelo mesmo JsonFields das respostas.
+ *
+ * O fragmento guarda junto o DTO de onde saiu; na próxima resposta ele é reaproveitado se o DTO lido
+ * for igual (comparação de cinco inteiros e do nome) e reescrito se não for. Assim qualquer escrita
+ * (update, write-back de estoque, outro processo) aparece na resposta seguinte sem invalidação
+ * explícita. Uma listagem vira cópia de fragmentos para um buffer só, sem formatar campo nenhum.
+ * Cada shard guarda no máximo max_entries / 64 fragmentos e descarta o menos usado; o fragmento de um
+ * produto que deixou de existir sai no primeiro GET que responde 404 para ele (forget).
+ */
+class ProductFragmentStore
+{
+private:
+    static constexpr size_t shard_count_ = 64;
+
+    struct Fragment
+    {
+        models::dto::ProductResponseDTO source;
+        std::string json;
+        std::list<int>::iterator lru; // a frente é o mais recente
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<int, Fragment> entries;
+        std::list<int> lru;
+    };
+
+    ProductFragmentConfig config_;
+    size_t shard_capacity_;
+    std::array<Shard, shard_count_> shards_;
+
+    alignas(64) std::atomic<uint64_t> reused_{0};
+    alignas(64) std::atomic<uint64_t> rendered_{0};
+    std::atomic<uint64_t> evicted_{0};
+
+    auto shard_for(int product_id) -> Shard &;
+
+public:
+    explicit ProductFragmentStore(const ProductFragmentConfig &config = ProductFragmentConfig());
+
+    ProductFragmentStore(const ProductFragmentStore &) = delete;
+    ProductFragmentStore &operator=(const ProductFragmentStore &) = delete;
+
+    /* Anexa o objeto JSON do produto a out */
+    auto append(std::string &out, const models::dto::ProductResponseDTO &product) -> void;
+
+    /* Corpo de GET /api/products/<id> e do array da listagem */
+    auto to_json(const models::dto::ProductResponseDTO &product) -> std::string;
+    auto to_json(const std::vector<models::dto::ProductResponseDTO> &products) -> std::string;
+
+    /* Descarta o fragmento do produto (GET respondeu 404) */
+    auto forget(int product_id) -> void;
+
+    auto stats() -> ProductFragmentStats;
+    auto render(std::string &out) -> void;
+};
+
+} // namespace lynx::cache
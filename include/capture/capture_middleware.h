@@ -0,0 +1,34 @@
+#pragma once
+
+#include "capture/traffic_recorder.h"
+#include <chrono>
+#include <crow.h>
+#include <memory>
+
+namespace lynx::capture
+{
+
+/*
+ * Middleware do Crow que entrega as requisições amostradas ao TrafficRecorder, com o status e o
+ * tempo da resposta. Fica logo depois do CORS para ver também os 503 da admissão. Sem recorder
+ * configurado (set_recorder) não faz nada.
+ */
+struct CaptureMiddleware
+{
+    struct context
+    {
+        bool sampled = false;
+        int64_t received_at_us = 0;
+        std::chrono::steady_clock::time_point started_at;
+    };
+
+    auto set_recorder(std::shared_ptr<TrafficRecorder> recorder) -> void;
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+
+private:
+    std::shared_ptr<TrafficRecorder> recorder_;
+};
+
+} // namespace lynx::capture
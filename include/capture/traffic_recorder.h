@@ -0,0 +1,115 @@
+#pragma once
+
+#include "utils/json_reader.h"
+#include "utils/json_writer.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace lynx::capture
+{
+
+struct CaptureConfig
+{
+    bool enabled = false;
+    std::string path = "capture.ndjson";                          // aberto em append
+    uint32_t sample_every = 100;                                  // 1 em cada N requisições, por thread; 1 grava todas
+    size_t max_body_bytes = 16 * 1024;                            // corpos maiores são cortados e marcados
+    size_t max_pending = 8192;                                    // fila da escrita; o excedente é descartado e contado
+    std::vector<std::string> prefixes = {"/api/"};                // só o tráfego da API
+    std::vector<std::string> excluded_prefixes = {"/api/admin"};  // rotas de operação não entram no replay
+};
+
+/* Uma linha do NDJSON: a requisição como chegou e o que o servidor respondeu */
+struct CapturedRequest
+{
+    int64_t received_at_us = 0; // system_clock, µs desde a época; o replay usa as diferenças
+    std::string method;
+    std::string path;
+    std::string query; // sem o '?'
+    std::string content_type;
+    std::string accept;
+    std::string accept_encoding;
+    std::string body;
+    bool body_base64 = false; // corpo MessagePack, codificado para a linha continuar JSON válido
+    bool body_truncated = false;
+    int status = 0;
+    int64_t duration_us = 0;
+    int64_t response_bytes = 0; // já comprimido, quando a resposta foi comprimida
+};
+
+/*
+ * Gravador de tráfego amostrado. O middleware decide com sample() e entrega a requisição copiada em
+ * record(); a codificação e a escrita do arquivo rodam numa thread própria, fora da requisição. Fila
+ * cheia descarta e conta, nunca segura o handler.
+ */
+class TrafficRecorder
+{
+private:
+    CaptureConfig config_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<CapturedRequest> queue_;
+    bool stopping_ = false;
+    std::thread worker_;
+    std::ofstream file_;
+
+    uint64_t recorded_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t written_ = 0;
+    uint64_t truncated_ = 0;
+
+    auto run() -> void;
+
+public:
+    explicit TrafficRecorder(const CaptureConfig &config = CaptureConfig());
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder &) = delete;
+    TrafficRecorder &operator=(const TrafficRecorder &) = delete;
+
+    /* Abre o arquivo (lança se não conseguir) e sobe a thread de escrita */
+    auto start() -> void;
+    auto stop() -> void; // grava o que está na fila e fecha o arquivo
+
+    auto config() const -> const CaptureConfig &;
+
+    /* Na thread da requisição, sem travar: rota elegível e vez desta thread na amostragem */
+    auto sample(std::string_view path) const -> bool;
+    auto record(CapturedRequest &&request) -> void;
+
+    auto render(std::string &out) -> void;
+};
+
+/* Linha do NDJSON, sem o '\n'; corpo MessagePack vai em base64 */
+auto to_ndjson(CapturedRequest request, utils::json::JsonWriter &writer) -> void;
+
+/* Lança BadRequestError na linha inválida; o corpo volta decodificado */
+auto parse_ndjson(std::string_view line) -> CapturedRequest;
+
+} // namespace lynx::capture
+
+namespace utils::json
+{
+
+template <> struct JsonFields<lynx::capture::CapturedRequest>
+{
+    using T = lynx::capture::CapturedRequest;
+
+    static constexpr auto fields_ =
+        std::make_tuple(field("received_at_us", &T::received_at_us), field("method", &T::method), field("path", &T::path),
+                        field("query", &T::query, Presence::optional), field("content_type", &T::content_type, Presence::optional),
+                        field("accept", &T::accept, Presence::optional), field("accept_encoding", &T::accept_encoding, Presence::optional),
+                        field("body", &T::body, Presence::optional), field("body_base64", &T::body_base64, Presence::optional),
+                        field("body_truncated", &T::body_truncated, Presence::optional), field("status", &T::status),
+                        field("duration_us", &T::duration_us), field("response_bytes", &T::response_bytes, Presence::optional));
+};
+
+} // namespace utils::json
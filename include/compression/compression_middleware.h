@@ -0,0 +1,36 @@
+#pragma once
+
+#include "compression/response_compressor.h"
+#include <crow.h>
+#include <cstddef>
+
+namespace lynx::compression
+{
+
+struct CompressionConfig
+{
+    bool enabled = true;
+    int level = 6;           // 1 (rápido) a 9 (menor); o zstd usa a mesma escala
+    size_t min_bytes = 1024; // abaixo disso o cabeçalho gzip e a latência não compensam
+};
+
+/*
+ * Comprime o corpo já montado conforme o Accept-Encoding da requisição. Só atua em JSON, MessagePack
+ * e texto acima de min_bytes, sem Content-Encoding prévio, e mantém o corpo original se não encolher.
+ */
+struct CompressionMiddleware
+{
+    struct context
+    {
+    };
+
+    auto configure(const CompressionConfig &config) -> void;
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+
+private:
+    CompressionConfig config_;
+};
+
+} // namespace lynx::compression
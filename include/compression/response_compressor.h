@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/*
+ * Compressão do corpo das respostas (gzip, deflate e, com LYNX_WITH_ZSTD, zstd). Cada thread guarda
+ * um contexto por codificação e só o reinicia entre respostas, sem pagar a alocação das tabelas do
+ * deflate (~256 KB) a cada requisição.
+ */
+
+namespace lynx::compression
+{
+
+enum class Encoding
+{
+    identity,
+    gzip,
+    deflate,
+    zstd
+};
+
+auto encoding_name(Encoding encoding) -> std::string_view;
+
+/*
+ * Escolhe a codificação pelo Accept-Encoding: maior q vence, empate prefere zstd > gzip > deflate,
+ * "q=0" recusa e "*" vale para as não citadas. Sem nenhuma aceitável devolve identity.
+ */
+auto negotiate_encoding(std::string_view accept_encoding) -> Encoding;
+
+/*
+ * Compressão incremental sobre o contexto da thread: write() pode ser chamado a cada pedaço de um
+ * corpo produzido aos poucos e finish() fecha o stream. Um compressor ativo por codificação e por
+ * thread; não passar entre threads.
+ */
+class StreamCompressor
+{
+private:
+    Encoding encoding_;
+
+public:
+    StreamCompressor(Encoding encoding, int level);
+
+    StreamCompressor(const StreamCompressor &) = delete;
+    auto operator=(const StreamCompressor &) -> StreamCompressor & = delete;
+
+    auto write(std::string_view chunk, std::string &out) -> void;
+    auto finish(std::string &out) -> void;
+};
+
+/* Corpo inteiro de uma vez; lança InternalServerError se a biblioteca falhar */
+auto compress(Encoding encoding, int level, std::string_view body) -> std::string;
+
+} // namespace lynx::compression
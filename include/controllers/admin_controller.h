@@ -0,0 +1,31 @@
+#pragma once
+
+#include "database/query_profiler.h"
+#include "handlers/interface.h"
+#include "ledger/order_ledger.h"
+
+namespace lynx::controller
+{
+
+class AdminController : public interface::IHandler
+{
+
+private:
+    std::shared_ptr<ledger::OrderLedger> ledger_;
+    std::shared_ptr<database::QueryProfiler> query_profiler_;
+    std::string base_path_ = "/api/admin";
+
+    auto ledger_stats() -> crow::response;                           // handle_ledger_stats
+    auto ledger_verify(const crow::request &req) -> crow::response; // handle_ledger_verify
+    auto query_stats(const crow::request &req) -> crow::response;   // handle_query_stats
+#ifdef LYNX_TRACING
+    auto trace_export(const crow::request &req) -> crow::response; // handle_trace_export
+#endif
+
+public:
+    AdminController(std::shared_ptr<ledger::OrderLedger> ledger, std::shared_ptr<database::QueryProfiler> query_profiler);
+
+    auto register_routes(App &app) -> void override;
+};
+
+} // namespace lynx::controller
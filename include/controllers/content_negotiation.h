@@ -0,0 +1,75 @@
+#pragma once
+
+#include "models/dtos/dto_msgpack.h"
+#include "utils/http_header.h"
+#include <crow.h>
+#include <string_view>
+
+/*
+ * Negociação de formato dos controllers: o Accept escolhe a resposta entre JSON e MessagePack pelos
+ * q-values e "Content-Type: application/msgpack" marca o corpo de criação como binário. Sem esses
+ * cabeçalhos tudo segue em JSON; respostas de erro são sempre JSON. As rotas negociadas passam a
+ * resposta por negotiated(), que acrescenta "Vary: Accept" para caches intermediários.
+ */
+
+namespace lynx::controller
+{
+
+enum class BodyFormat
+{
+    json,
+    msgpack
+};
+
+/*
+ * Formato da resposta pelo Accept: para cada tipo vale a faixa mais específica que o cobre (o tipo
+ * exato, depois o curinga de application, depois o curinga geral) e o maior q vence. Empate, nenhum
+ * aceitável ou cabeçalho ausente: JSON.
+ */
+auto negotiate_format(std::string_view accept) -> BodyFormat;
+
+/* Formato de um Content-Type: só o tipo antes dos parâmetros conta */
+auto content_type_format(std::string_view content_type) -> BodyFormat;
+
+inline auto response_format(const crow::request &req) -> BodyFormat
+{
+    return negotiate_format(req.get_header_value("Accept"));
+}
+
+inline auto request_format(const crow::request &req) -> BodyFormat
+{
+    return content_type_format(req.get_header_value("Content-Type"));
+}
+
+/* Resposta de rota cujo corpo depende do Accept, inclusive as servidas de cache */
+inline auto negotiated(crow::response res) -> crow::response
+{
+    res.set_header("Vary", utils::http::merge_vary(res.get_header_value("Vary"), "Accept"));
+    return res;
+}
+
+/* Decodifica o corpo no DTO pelo formato do Content-Type */
+template <utils::json::Described T> auto parse_body(const crow::request &req) -> T
+{
+    if (request_format(req) == BodyFormat::msgpack)
+        return utils::msgpack::parse<T>(req.body);
+
+    return utils::json::parse<T>(req.body);
+}
+
+/* Resposta já codificada em MessagePack a partir do escritor */
+inline auto msgpack_response(int status, utils::msgpack::MsgPackWriter &writer) -> crow::response
+{
+    crow::response res(status, writer.take());
+    res.set_header("Content-Type", "application/msgpack");
+    return res;
+}
+
+template <typename T> auto msgpack_response(int status, const T &value, size_t reserve_bytes = 0) -> crow::response
+{
+    utils::msgpack::MsgPackWriter writer(reserve_bytes);
+    utils::msgpack::write(writer, value);
+    return msgpack_response(status, writer);
+}
+
+} // namespace lynx::controller
@@ -15,7 +15,7 @@ private:
     std::string base_path_ = "/api/customers";
 
     auto create(const crow::request &req) -> crow::response;
-    auto get(const int &id) -> crow::response;
+    auto get(const crow::request &req, const int &id) -> crow::response;
     auto list(const crow::request &req) -> crow::response;
     auto update(const crow::request &req, int &id) -> crow::response;
     auto remove(const crow::request &req) -> crow::response;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "errors/result.h"
+#include <crow.h>
+
+namespace lynx::controller
+{
+
+/* Resposta de uma falha esperada devolvida pelo service: status e corpo JSON já formatado, sem exceção */
+inline auto error_response(const errors::Error &error) -> crow::response
+{
+    crow::response res(static_cast<int>(error.status_code()), error.to_json());
+    res.set_header("Content-Type", "application/json");
+    return res;
+}
+
+} // namespace lynx::controller
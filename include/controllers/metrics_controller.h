@@ -0,0 +1,24 @@
+#pragma once
+
+#include "handlers/interface.h"
+#include "metrics/metrics_registry.h"
+
+namespace lynx::controller
+{
+
+class MetricsController : public interface::IHandler
+{
+
+private:
+    std::shared_ptr<metrics::MetricsRegistry> registry_;
+    std::string base_path_ = "/metrics";
+
+    auto scrape() -> crow::response; // handle_scrape
+
+public:
+    explicit MetricsController(std::shared_ptr<metrics::MetricsRegistry> registry);
+
+    auto register_routes(App &app) -> void override;
+};
+
+} // namespace lynx::controller
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "cache/order_details_cache.h"
 #include "handlers/interface.h"
 #include "services/order_services.h"
 
@@ -12,16 +13,17 @@ class OrderController : public interface::IHandler
 
 private:
     std::shared_ptr<services::OrderServices> services_;
+    std::shared_ptr<cache::OrderDetailsCache> details_cache_;
     std::string base_path_ = "/api/orders";
 
     auto create(const crow::request &req) -> crow::response;
-    auto get(const int id) -> crow::response;             // handle_get_order
+    auto get(const crow::request &req, const int id) -> crow::response; // handle_get_order
     auto list(const crow::request &req) -> crow::response; // handle_summary_orders
     auto update(const crow::request &req, int id) -> crow::response;
     auto remove(const crow::request &req) -> crow::response;
 
 public:
-    explicit OrderController(std::shared_ptr<services::OrderServices> services);
+    OrderController(std::shared_ptr<services::OrderServices> services, std::shared_ptr<cache::OrderDetailsCache> details_cache);
 
     auto register_routes(App &app) -> void override;
 };
@@ -16,10 +16,11 @@ private:
 
 
     auto create(const crow::request &req) -> crow::response; // handle_create_payment
-    auto get(const int &id) -> crow::response;               // handle_find_payment_by_id
+    auto get(const crow::request &req, const int &id) -> crow::response; // handle_find_payment_by_id
     auto list(const crow::request &req) -> crow::response;   // handle_find_all_payments
     auto update(const crow::request &req, int &id) -> crow::response; // handle_update_payment
     auto remove(const crow::request &req) -> crow::response; // handle_delete_payment
+    auto confirm(const crow::request &req) -> crow::response; // handle_confirm_payments (NDJSON)
 
 public:
     explicit PaymentController(std::shared_ptr<services::PaymentServices> services);
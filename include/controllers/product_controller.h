@@ -1,5 +1,6 @@
 #pragma once
 
+#include "cache/product_fragment_store.h"
 #include "handlers/interface.h"
 #include "services/product_services.h"
 
@@ -12,16 +13,18 @@ class ProductController : public interface::IHandler
 
 private:
     std::shared_ptr<services::ProductServices> services_;
+    std::shared_ptr<cache::ProductFragmentStore> fragments_;
     std::string base_path_ = "/api/products";
 
     auto create(const crow::request &req) -> crow::response; // handle_create
-    auto get(const int &id) -> crow::response;               // handle_find_by_id
+    auto get(const crow::request &req, const int &id) -> crow::response; // handle_find_by_id
     auto list(const crow::request &req) -> crow::response;   // handle_find_all
     auto update(const crow::request &req, int &id) -> crow::response; // handle_update
+    auto adjust_stock(const crow::request &req, int id) -> crow::response; // POST /api/products/<id>/stock
     auto remove(const crow::request &req) -> crow::response; // handle_delete
 
 public:
-    explicit ProductController(std::shared_ptr<services::ProductServices> services);
+    ProductController(std::shared_ptr<services::ProductServices> services, std::shared_ptr<cache::ProductFragmentStore> fragments);
 
     auto register_routes(App &app) -> void override;
 };
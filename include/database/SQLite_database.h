@@ -1,11 +1,20 @@
 #pragma once
 
+#include <cstdint>
 #include <sqlite3.h>
 #include <string>
 
 namespace lynx::database
 {
 
+struct DatabaseStats
+{
+    int64_t memory_used_bytes;
+    int64_t cache_used_bytes;
+    int64_t cache_hits;
+    int64_t cache_misses;
+};
+
 class SQLiteDatabase
 {
 private:
@@ -17,8 +26,14 @@ private:
     SQLiteDatabase(const SQLiteDatabase &) = delete;
     SQLiteDatabase &operator=(const SQLiteDatabase &) = delete;
 
+    static auto configured_path() -> std::string &;
+
 public:
+    /* Troca o arquivo do banco (ex.: um banco temporário nos benchmarks); só vale antes do primeiro get_instance() */
+    static auto set_path(std::string path) -> void;
+
     static auto get_instance() -> SQLiteDatabase &;
     auto get_connection() const -> sqlite3 *;
+    auto stats() const -> DatabaseStats;
 };
 } // namespace lynx::database
\ No newline at end of file
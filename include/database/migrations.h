@@ -0,0 +1,20 @@
+#pragma once
+
+#include <sqlite3.h>
+
+namespace lynx::database
+{
+
+/*
+ * Correções de schema e de dados de bancos criados por versões anteriores, aplicadas uma vez na subida.
+ *
+ * Cada migração roda na sua transação e fica registrada em schema_migrations; a que ainda não está
+ * registrada roda, inclusive num banco que acabou de receber o init.sql (com as tabelas vazias, as
+ * correções de dados não mudam nada). Lança InternalServerError se alguma falhar.
+ */
+auto apply_migrations(sqlite3 *db) -> void;
+
+/* Banco criado agora pelo init.sql atual e povoado já em UTC (geradores de dados): registra todas sem executar */
+auto mark_migrations_applied(sqlite3 *db) -> void;
+
+} // namespace lynx::database
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::database
+{
+
+struct QueryCacheConfig
+{
+    bool enabled = true;
+    size_t max_bytes = 64 * 1024 * 1024; // estimativa dos resultados guardados, dividida igualmente entre os shards
+    size_t shards = 16;
+    std::chrono::milliseconds ttl = std::chrono::seconds(10); // escritas que o hook não vê (outro processo no mesmo arquivo); zero desliga
+};
+
+/* Tabelas do schema; as versões são indexadas por elas */
+enum class Table : uint8_t
+{
+    customers,
+    products,
+    orders,
+    order_items,
+    payments,
+    count_
+};
+
+using TableMask = uint32_t;
+
+constexpr auto table_bit(Table table) -> TableMask
+{
+    return TableMask{1} << static_cast<unsigned>(table);
+}
+
+inline constexpr size_t table_count_ = static_cast<size_t>(Table::count_);
+inline constexpr std::array<const char *, table_count_> table_names_ = {"customers", "products", "orders", "order_items", "payments"};
+
+using TableVersions = std::array<uint64_t, table_count_>;
+
+struct QueryCacheStats
+{
+    uint64_t stale = 0;   // descartadas na leitura: alguma tabela lida mudou de versão
+    uint64_t expired = 0; // descartadas pelo TTL
+    uint64_t evicted = 0; // removidas pelo limite de memória
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+    TableVersions versions{};
+};
+
+/*
+ * Cache de resultados de leitura, invalidado por versão de tabela.
+ *
+ * Cada tabela tem um contador que sobe a cada linha escrita (sqlite3_update_hook) e em todo rollback
+ * (sqlite3_rollback_hook, que desfaz linhas sem avisar o update hook). Uma entrada guarda as versões
+ * das tabelas que a consulta lê, tiradas ANTES de executá-la: se uma escrita concorrente cair no meio,
+ * a entrada já nasce velha e é descartada na próxima leitura, nunca servida. O TTL só cobre escritas
+ * feitas fora desta conexão.
+ *
+ * Os valores são shared_ptr<const void> do tipo do método que os gravou; a chave inclui o repositório
+ * e o método, então o tipo de volta é sempre o mesmo. Cada shard tem a sua trava e o seu LRU.
+ */
+class QueryCache
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        std::shared_ptr<const void> value;
+        TableMask tables;
+        TableVersions versions;
+        Clock::time_point stored_at;
+        size_t bytes;
+        std::list<std::string>::iterator lru; // posição no LRU do shard; a frente é a mais recente
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        auto operator()(std::string_view text) const -> size_t { return std::hash<std::string_view>{}(text); }
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>> entries;
+        std::list<std::string> lru;
+        size_t bytes = 0;
+    };
+
+    QueryCacheConfig config_;
+    size_t shard_budget_;
+    std::unique_ptr<Shard[]> shards_;
+    std::array<std::atomic<uint64_t>, table_count_> versions_{};
+    std::vector<sqlite3 *> connections_;
+
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> expired_{0};
+    std::atomic<uint64_t> evicted_{0};
+
+    static auto on_update(void *context, int operation, const char *database, const char *table, sqlite3_int64 rowid) -> void;
+    static auto on_rollback(void *context) -> void;
+
+    auto shard_for(std::string_view key) -> Shard &;
+    auto erase(Shard &shard, std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>::iterator it) -> void;
+
+public:
+    explicit QueryCache(const QueryCacheConfig &config = QueryCacheConfig());
+    ~QueryCache();
+
+    QueryCache(const QueryCache &) = delete;
+    QueryCache &operator=(const QueryCache &) = delete;
+
+    /* Registra os hooks de escrita na conexão; chamar uma vez para cada conexão aberta. As versões são
+       mantidas mesmo com o cache desligado (o RepositoryCoalescing também as usa) */
+    auto attach(sqlite3 *connection) -> void;
+    auto detach() -> void;
+
+    auto config() const -> const QueryCacheConfig &;
+
+    /* Versões atuais; tirar antes de executar a consulta que vai para store() */
+    auto versions() const -> TableVersions;
+
+    /* Nenhuma das tabelas em tables mudou desde versions */
+    auto is_current(TableMask tables, const TableVersions &versions) const -> bool;
+
+    /* Para escritas que o update hook não vê (truncate optimization, REPLACE) */
+    auto invalidate(Table table) -> void;
+    auto invalidate_all() -> void;
+
+    /* nullptr: ausente, expirada ou velha (as duas últimas são removidas e contadas) */
+    auto find(std::string_view key) -> std::shared_ptr<const void>;
+    auto store(std::string key, TableMask tables, const TableVersions &versions, std::shared_ptr<const void> value, size_t bytes) -> void;
+
+    auto stats() -> QueryCacheStats;
+    auto clear() -> void;
+
+    auto render(std::string &out) -> void;
+};
+
+auto table_from_name(std::string_view name) -> std::optional<Table>;
+
+} // namespace lynx::database
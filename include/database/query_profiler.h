@@ -0,0 +1,128 @@
+#pragma once
+
+#include "metrics/metrics_registry.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::database
+{
+
+struct QueryProfilerConfig
+{
+    bool enabled = true;
+    std::chrono::milliseconds slow_threshold = std::chrono::milliseconds(50); // execuções acima disso vão para o log
+    size_t max_statements = 512;                                             // SQLs distintos; o excedente vai para "<other>"
+    size_t max_pending_slow = 256;                                           // fila do log; o excedente é descartado e contado
+};
+
+struct QueryStats
+{
+    std::string sql; // espaços colapsados, parâmetros continuam como ?
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t p99_ns = 0; // limite superior do bucket do histograma
+    uint64_t rows = 0;
+    uint64_t fullscan_steps = 0;
+    uint64_t sorts = 0;
+    uint64_t autoindexes = 0;
+    uint64_t vm_steps = 0;
+    uint64_t slow_count = 0;
+    std::optional<std::string> plan; // EXPLAIN QUERY PLAN, capturado na primeira execução lenta
+};
+
+/*
+ * Profiler de statements via sqlite3_trace_v2.
+ *
+ * Cada execução é cronometrada entre SQLITE_TRACE_STMT e SQLITE_TRACE_PROFILE, as linhas vêm de
+ * SQLITE_TRACE_ROW e os contadores de sqlite3_stmt_status são lidos e zerados no fim. As estatísticas
+ * são agregadas pelo texto do SQL, de modo que cada combinação de filtros das queries montadas em
+ * runtime aparece separada. Execuções lentas vão para uma fila: o EXPLAIN QUERY PLAN e o log rodam numa
+ * thread própria, fora do callback do SQLite.
+ */
+class QueryProfiler
+{
+private:
+    struct Entry
+    {
+        std::string sql;
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+        uint64_t rows = 0;
+        uint64_t fullscan_steps = 0;
+        uint64_t sorts = 0;
+        uint64_t autoindexes = 0;
+        uint64_t vm_steps = 0;
+        uint64_t slow_count = 0;
+        std::optional<std::string> plan;
+        metrics::LatencyHistogram latency; // µs; gravado sob mutex_, então sempre exclusivo
+    };
+
+    struct SlowQuery
+    {
+        sqlite3 *connection;
+        std::string key;
+        std::string expanded_sql;
+        uint64_t elapsed_ns;
+        uint64_t rows;
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        auto operator()(std::string_view text) const -> size_t { return std::hash<std::string_view>{}(text); }
+    };
+
+    QueryProfilerConfig config_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>> entries_;
+    std::vector<sqlite3 *> connections_;
+
+    std::deque<SlowQuery> slow_queue_;
+    uint64_t slow_dropped_ = 0;
+
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    static auto on_trace(unsigned type, void *context, void *p, void *x) -> int;
+
+    auto on_profile(sqlite3_stmt *stmt, uint64_t elapsed_ns, uint64_t rows) -> void;
+    auto run() -> void;
+    auto explain(sqlite3 *connection, const std::string &sql) -> std::string;
+
+public:
+    explicit QueryProfiler(const QueryProfilerConfig &config = QueryProfilerConfig());
+    ~QueryProfiler();
+
+    QueryProfiler(const QueryProfiler &) = delete;
+    QueryProfiler &operator=(const QueryProfiler &) = delete;
+
+    /* Registra os callbacks na conexão; chamar uma vez para cada conexão aberta */
+    auto attach(sqlite3 *connection) -> void;
+
+    auto start() -> void;
+    auto stop() -> void; // remove os callbacks e encerra a thread do log
+
+    auto snapshot() -> std::vector<QueryStats>;
+    auto slow_dropped() -> uint64_t;
+    auto reset() -> void;
+};
+
+auto normalize_sql(std::string_view sql) -> std::string;
+
+} // namespace lynx::database
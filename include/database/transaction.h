@@ -0,0 +1,37 @@
+#pragma once
+
+#include <mutex>
+#include <sqlite3.h>
+
+namespace lynx::database
+{
+
+/*
+ * Transação explícita na conexão compartilhada.
+ *
+ * A conexão tem um estado de transação só: um BEGIN enquanto outra thread está no meio da dela falha,
+ * e o COMMIT ou ROLLBACK de quem falhou fecharia a transação alheia. Todas as transações passam por um
+ * mutex comum; o BEGIN que falha lança e nada é feito. Sem commit(), o destrutor faz ROLLBACK.
+ */
+class Transaction
+{
+private:
+    sqlite3 *db_;
+    std::unique_lock<std::mutex> lock_;
+    bool open_ = false;
+
+    static auto mutex() -> std::mutex &;
+
+public:
+    /* Lança std::runtime_error se o BEGIN falhar */
+    Transaction(sqlite3 *db, const char *begin = "BEGIN TRANSACTION;");
+    ~Transaction();
+
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+
+    /* Lança std::runtime_error se o COMMIT falhar; a transação fica aberta e o destrutor a desfaz */
+    auto commit() -> void;
+};
+
+} // namespace lynx::database
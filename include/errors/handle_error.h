@@ -1,11 +1,27 @@
 #pragma once
 #include "utils/enums.h"
+#include "utils/json_writer.h"
 #include <exception>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 namespace lynx::exceptions
 {
+
+/* Corpo JSON de erro montado num buffer só, com a mensagem escapada; compartilhado por CustomError e errors::Error */
+inline auto error_json(std::string_view name, std::string_view message, HttpStatus status_code) -> std::string
+{
+    utils::json::JsonWriter writer(48 + name.size() + message.size());
+    writer.begin_object()
+        .key("error")
+        .value(name)
+        .key("message")
+        .value(message)
+        .key("statusCode")
+        .value(static_cast<int64_t>(status_code))
+        .end_object();
+    return writer.take();
+}
 class CustomError : public std::exception
 {
 private:
@@ -44,19 +60,12 @@ public:
 
     std::string to_string() const
     {
-        std::ostringstream oss;
-        oss << "Error: " << name_error_ << ", Message: " << message_ << ", StatusCode: " << static_cast<int>(status_code_);
-        return oss.str();
+        return "Error: " + name_error_ + ", Message: " + message_ + ", StatusCode: " + std::to_string(static_cast<int>(status_code_));
     }
 
     std::string to_json() const
     {
-        std::ostringstream oss;
-        oss << "{"
-            << "\"error\":\"" << name_error_ << "\","
-            << "\"message\":\"" << message_ << "\","
-            << "\"statusCode\":" << static_cast<int>(status_code_) << "}";
-        return oss.str();
+        return error_json(name_error_, message_, status_code_);
     }
 };
 } // namespace lynx::exceptions
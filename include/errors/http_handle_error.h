@@ -50,6 +50,15 @@ public:
     }
 };
 
+class PayloadTooLargeError : public CustomError
+{
+public:
+    PayloadTooLargeError(const std::string &message = "Payload Too Large")
+        : CustomError("Payload Too Large", message, HttpStatus::PAYLOAD_TOO_LARGE)
+    {
+    }
+};
+
 // 5xx - Server Errors
 class InternalServerError : public CustomError
 {
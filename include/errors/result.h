@@ -0,0 +1,181 @@
+#pragma once
+#include "errors/http_handle_error.h"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+/*
+ * Falhas esperadas (não encontrado, validação, conflito) voltam como valor em Result<T>, no molde do
+ * std::expected do C++23; exceções ficam para o que é de fato excepcional (erro do SQLite, bug).
+ * Quem ainda precisa da exceção chama value() ou error().raise().
+ */
+
+namespace lynx::errors
+{
+
+class Error
+{
+private:
+    HttpStatus status_code_;
+    std::string_view name_; // sempre literal: "Not Found", "Bad Request"...
+    std::string message_;
+
+public:
+    Error(HttpStatus status_code, std::string_view name, std::string message)
+        : status_code_(status_code)
+        , name_(name)
+        , message_(std::move(message))
+    {
+    }
+
+    auto status_code() const -> HttpStatus
+    {
+        return status_code_;
+    }
+
+    auto name() const -> std::string_view
+    {
+        return name_;
+    }
+
+    auto message() const -> const std::string &
+    {
+        return message_;
+    }
+
+    auto to_json() const -> std::string
+    {
+        return exceptions::error_json(name_, message_, status_code_);
+    }
+
+    [[noreturn]] auto raise() const -> void
+    {
+        throw exceptions::CustomError(std::string(name_), message_, status_code_);
+    }
+};
+
+inline auto bad_request(std::string message) -> Error
+{
+    return Error(HttpStatus::BAD_REQUEST, "Bad Request", std::move(message));
+}
+
+inline auto not_found(std::string message) -> Error
+{
+    return Error(HttpStatus::NOT_FOUND, "Not Found", std::move(message));
+}
+
+inline auto conflict(std::string message) -> Error
+{
+    return Error(HttpStatus::CONFLICT, "Conflict", std::move(message));
+}
+
+template <typename T> class [[nodiscard]] Result
+{
+private:
+    std::variant<T, Error> state_;
+
+public:
+    Result(T value)
+        : state_(std::in_place_index<0>, std::move(value))
+    {
+    }
+
+    Result(Error error)
+        : state_(std::in_place_index<1>, std::move(error))
+    {
+    }
+
+    auto has_value() const -> bool
+    {
+        return state_.index() == 0;
+    }
+
+    explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    /* Sem valor, lança o erro como CustomError */
+    auto value() & -> T &
+    {
+        if (!has_value())
+            error().raise();
+        return std::get<0>(state_);
+    }
+
+    auto value() && -> T
+    {
+        if (!has_value())
+            error().raise();
+        return std::move(std::get<0>(state_));
+    }
+
+    auto operator*() & -> T &
+    {
+        return *std::get_if<0>(&state_);
+    }
+
+    auto operator*() const & -> const T &
+    {
+        return *std::get_if<0>(&state_);
+    }
+
+    auto operator*() && -> T
+    {
+        return std::move(*std::get_if<0>(&state_));
+    }
+
+    auto operator->() -> T *
+    {
+        return std::get_if<0>(&state_);
+    }
+
+    auto operator->() const -> const T *
+    {
+        return std::get_if<0>(&state_);
+    }
+
+    auto error() const -> const Error &
+    {
+        return *std::get_if<1>(&state_);
+    }
+};
+
+template <> class [[nodiscard]] Result<void>
+{
+private:
+    std::optional<Error> error_;
+
+public:
+    Result() = default;
+
+    Result(Error error)
+        : error_(std::move(error))
+    {
+    }
+
+    auto has_value() const -> bool
+    {
+        return !error_.has_value();
+    }
+
+    explicit operator bool() const
+    {
+        return has_value();
+    }
+
+    auto value() const -> void
+    {
+        if (error_)
+            error_->raise();
+    }
+
+    auto error() const -> const Error &
+    {
+        return *error_;
+    }
+};
+
+} // namespace lynx::errors
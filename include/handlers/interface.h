@@ -2,9 +2,20 @@
 
 #include <crow.h>
 #include <crow/middlewares/cors.h>
+#include "admission/admission_middleware.h"
+#include "capture/capture_middleware.h"
+#include "compression/compression_middleware.h"
+#include "metrics/metrics_middleware.h"
+#include "tracing/tracing_middleware.h"
 #include <string>
 
-using App = crow::App<crow::CORSHandler>;
+// Captura logo após o CORS e admissão logo após as métricas, para que os 503 sejam gravados e contados.
+// Compressão por último: o after_handle dela roda primeiro, dentro do span da requisição
+#ifdef LYNX_TRACING
+using App = crow::App<crow::CORSHandler, lynx::capture::CaptureMiddleware, lynx::metrics::MetricsMiddleware, lynx::admission::AdmissionMiddleware, lynx::tracing::TracingMiddleware, lynx::compression::CompressionMiddleware>;
+#else
+using App = crow::App<crow::CORSHandler, lynx::capture::CaptureMiddleware, lynx::metrics::MetricsMiddleware, lynx::admission::AdmissionMiddleware, lynx::compression::CompressionMiddleware>;
+#endif
 
 namespace lynx::interface
 {
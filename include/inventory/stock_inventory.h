@@ -0,0 +1,110 @@
+#pragma once
+
+#include "models/order.h"
+#include "repository/interfaces/interface_inventory.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::inventory
+{
+
+/*
+ * Estoque disponível de um produto dividido em faixas atômicas, cada uma na sua linha de cache.
+ *
+ * Cada thread reserva primeiro na sua faixa e só toca as outras quando a sua não basta, o que tira a
+ * disputa de um único contador em produtos muito vendidos. Perto do fim do estoque duas reservas
+ * concorrentes podem falhar juntas mesmo havendo saldo para uma delas; nunca vendem além do saldo.
+ */
+class StockCounter
+{
+private:
+    static constexpr size_t stripe_count_ = 4;
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<int64_t> available{0};
+    };
+
+    std::array<Stripe, stripe_count_> stripes_;
+
+    static auto home_stripe() -> size_t;
+
+public:
+    explicit StockCounter(int64_t stock);
+
+    auto try_reserve(int64_t quantity) -> bool;
+    auto release(int64_t quantity) -> void;
+    auto available() const -> int64_t;
+};
+
+struct InventoryConfig
+{
+    std::chrono::milliseconds flush_interval = std::chrono::milliseconds(500); // intervalo entre write-backs
+};
+
+/*
+ * Reserva de estoque em memória com write-back em lote para products.stock.
+ *
+ * As vendas não geram UPDATE por pedido: o write-back deriva as baixas dos order_items gravados depois
+ * de um checkpoint, então um crash nunca perde uma baixa, e start() reconcilia o banco antes de carregar
+ * os contadores. Reposições de pedidos cancelados ficam pendentes em memória até o próximo write-back;
+ * um crash nesse intervalo só deixa o estoque menor do que o real.
+ *
+ * Produto com products.stock NULL não tem estoque controlado: não tem contador e nunca esgota.
+ */
+class StockInventory
+{
+private:
+    std::shared_ptr<repository::interface::IInventoryRepository> repository_;
+    InventoryConfig config_;
+
+    std::shared_mutex counters_mutex_;
+    std::unordered_map<int, std::unique_ptr<StockCounter>> counters_; // nullptr: estoque não controlado
+
+    std::mutex restocks_mutex_;
+    std::unordered_map<int, int64_t> pending_restocks_;
+
+    std::mutex flush_mutex_;
+
+    std::mutex worker_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    auto counter_for(int product_id) -> StockCounter *;
+    auto run() -> void;
+
+public:
+    StockInventory(std::shared_ptr<repository::interface::IInventoryRepository> repository,
+                   const InventoryConfig &config = InventoryConfig());
+    ~StockInventory();
+
+    auto start() -> void;
+    auto stop() -> void;
+
+    /* Reserva todos os itens ou nenhum; devolve o id do primeiro produto sem saldo */
+    auto try_reserve(const std::vector<models::OrderItem> &items) -> std::optional<int>;
+    auto release(const std::vector<models::OrderItem> &items) -> void;
+    auto restock_orders(const std::vector<int> &order_ids) -> void;
+
+    auto available(int product_id) -> std::optional<int64_t>;
+
+    /* Entrada (delta > 0) ou baixa manual no banco e no contador; false se a baixa passa do saldo */
+    auto adjust(int product_id, int64_t delta) -> bool;
+
+    /* Aplica no banco as vendas desde o último checkpoint e as reposições pendentes */
+    auto flush() -> void;
+};
+
+} // namespace lynx::inventory
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "errors/result.h"
+#include "models/order.h"
+#include "repository/interfaces/interface_order.h"
+#include "repository/interfaces/interface_payment.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::ledger
+{
+
+struct OrderBalance
+{
+    int64_t total_cents;
+    int64_t paid_cents;
+    models::OrderStatus status;
+
+    auto remaining_cents() const -> int64_t
+    {
+        return total_cents - paid_cents;
+    }
+
+    bool operator==(const OrderBalance &other) const = default;
+};
+
+struct LedgerStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t entries;
+};
+
+struct LedgerDrift
+{
+    int order_id;
+    OrderBalance cached;
+    std::optional<OrderBalance> database;
+};
+
+/*
+ * Saldo em memória dos pedidos em aberto (order_id -> total, pago, status).
+ *
+ * Os shards são alinhados em linha de cache e protegidos por mutex próprio; uma entrada é carregada
+ * do banco na primeira consulta e depois mantida pelas escritas de pedidos e pagamentos. Pedidos que
+ * chegam a PAID ou CANCELLED saem do ledger, o que limita a memória aos pedidos ainda pagáveis.
+ *
+ * Um pagamento é conferido e reservado no saldo de uma vez, com o shard travado (try_apply_payment):
+ * dois pagamentos simultâneos do mesmo pedido nunca passam pelo mesmo restante.
+ */
+class OrderLedger
+{
+private:
+    static constexpr size_t shard_count_ = 64;
+
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<int, OrderBalance> entries;
+    };
+
+    std::shared_ptr<repository::interface::IOrderRepository> order_repository_;
+    std::shared_ptr<repository::interface::IPaymentRepository> payment_repository_;
+
+    std::array<Shard, shard_count_> shards_;
+
+    alignas(64) std::atomic<uint64_t> hits_{0};
+    alignas(64) std::atomic<uint64_t> misses_{0};
+
+    auto shard_for(int order_id) -> Shard &;
+    auto load(int order_id) -> std::optional<OrderBalance>;
+
+    // Com o shard travado: a entrada em memória, ou o saldo lido do banco (guardado se o pedido for NEW)
+    auto find_locked(Shard &shard, int order_id) -> std::optional<OrderBalance>;
+
+public:
+    OrderLedger(std::shared_ptr<repository::interface::IOrderRepository> order_repository,
+                std::shared_ptr<repository::interface::IPaymentRepository> payment_repository);
+
+    auto get(int order_id) -> std::optional<OrderBalance>;
+
+    auto on_order_created(int order_id, int64_t total_cents) -> void;
+
+    /* Confere status e restante e soma o valor ao pago; devolve o saldo já com o pagamento */
+    auto try_apply_payment(int order_id, int64_t amount_cents) -> errors::Result<OrderBalance>;
+
+    /* Desfaz um try_apply_payment cujo INSERT falhou */
+    auto revert_payment(int order_id, int64_t amount_cents) -> void;
+
+    auto on_status_changed(int order_id, models::OrderStatus status) -> void;
+    auto invalidate(int order_id) -> void;
+
+    auto stats() const -> LedgerStats;
+
+    /* Compara cada entrada com o banco; se repair = true, corrige as entradas divergentes */
+    auto verify(bool repair) -> std::vector<LedgerDrift>;
+};
+
+} // namespace lynx::ledger
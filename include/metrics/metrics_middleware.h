@@ -0,0 +1,31 @@
+#pragma once
+
+#include "metrics/metrics_registry.h"
+#include <chrono>
+#include <crow.h>
+#include <memory>
+
+namespace lynx::metrics
+{
+
+/*
+ * Middleware do Crow que mede cada requisição e grava no MetricsRegistry.
+ * Sem registry configurado (set_registry) não faz nada.
+ */
+struct MetricsMiddleware
+{
+    struct context
+    {
+        std::chrono::steady_clock::time_point started_at;
+    };
+
+    auto set_registry(std::shared_ptr<MetricsRegistry> registry) -> void;
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+
+private:
+    std::shared_ptr<MetricsRegistry> registry_;
+};
+
+} // namespace lynx::metrics
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lynx::metrics
+{
+
+/*
+ * Histograma de latência em microssegundos com buckets log-lineares (estilo HDR): cada potência de 2
+ * é dividida em 4 sub-buckets, erro relativo abaixo de 25%, de 1 µs a ~67 s. Só contadores atômicos.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int sub_bucket_bits_ = 2;
+    static constexpr uint64_t sub_buckets_ = uint64_t{1} << sub_bucket_bits_;
+    static constexpr int max_exponent_ = 25;
+    static constexpr size_t bucket_count_ = (max_exponent_ - sub_bucket_bits_ + 2) * sub_buckets_;
+
+    static auto bucket_for(uint64_t micros) -> size_t;
+    static auto upper_bound(size_t bucket) -> uint64_t; // limite superior exclusivo, em µs
+
+    auto record(uint64_t micros, bool exclusive) -> void;
+
+    auto bucket(size_t index) const -> uint64_t;
+    auto sum_micros() const -> uint64_t;
+
+private:
+    std::array<std::atomic<uint64_t>, bucket_count_> buckets_{};
+    std::atomic<uint64_t> sum_micros_{0};
+};
+
+/*
+ * Os status conhecidos (HttpStatus e alguns comuns do Crow) têm contador próprio; os demais são
+ * agrupados pela classe (1xx..5xx).
+ */
+struct StatusSlots
+{
+    static constexpr std::array<int, 17> codes_ = {200, 201, 204, 400, 401, 403, 404, 405, 409, 413, 422, 429, 500, 501, 502, 503, 504};
+    static constexpr size_t count_ = codes_.size() + 5;
+
+    static auto slot_for(int status) -> size_t;
+    static auto label(size_t slot) -> std::string;
+};
+
+struct alignas(64) RouteShard
+{
+    std::array<std::atomic<uint64_t>, StatusSlots::count_> status{};
+    LatencyHistogram latency;
+};
+
+struct RouteMetrics
+{
+    // Um shard por thread (as excedentes dividem o último) para que threads não disputem as mesmas linhas de cache
+    static constexpr size_t shard_count_ = 8;
+
+    // key != 0 reserva a entrada; method e route só são lidos depois de ready
+    std::atomic<uint64_t> key{0};
+    std::atomic<bool> ready{false};
+    std::string method;
+    std::string route;
+
+    std::array<RouteShard, shard_count_> shards;
+};
+
+/*
+ * Métricas HTTP por rota/método/status e gauges registrados por quem usa.
+ *
+ * A gravação não trava: a rota é normalizada (segmentos numéricos viram <int>) e hasheada numa única
+ * passada sem alocar, e a entrada é achada numa tabela de endereçamento aberto de tamanho fixo.
+ * Respostas 404 e rotas além da capacidade vão para uma entrada única, para que URLs arbitrárias
+ * não criem séries novas.
+ */
+class MetricsRegistry
+{
+public:
+    using Collector = std::function<void(std::string &out)>;
+
+    MetricsRegistry();
+
+    auto request_started() -> void;
+    auto request_finished(std::string_view method, std::string_view path, int status, std::chrono::nanoseconds elapsed) -> void;
+
+    /* Coletores rodam a cada scrape e escrevem linhas já no formato de texto do Prometheus */
+    auto add_collector(Collector collector) -> void;
+
+    auto render() -> std::string;
+
+private:
+    static constexpr size_t route_capacity_ = 128;
+
+    struct alignas(64) InFlight
+    {
+        std::atomic<int64_t> value{0};
+    };
+
+    std::array<RouteMetrics, route_capacity_> routes_;
+    RouteMetrics unmatched_;
+
+    std::array<InFlight, RouteMetrics::shard_count_> in_flight_;
+
+    std::mutex collectors_mutex_;
+    std::vector<Collector> collectors_;
+
+    auto route_for(std::string_view method, std::string_view path) -> RouteMetrics &;
+};
+
+/* Escreve uma linha "nome{labels} valor"; labels já no formato chave="valor" */
+auto write_sample(std::string &out, std::string_view name, std::string_view labels, double value) -> void;
+auto write_sample(std::string &out, std::string_view name, std::string_view labels, int64_t value) -> void;
+auto write_histogram(std::string &out, std::string_view name, const std::string &labels,
+                     const std::array<uint64_t, LatencyHistogram::bucket_count_> &buckets, uint64_t sum_micros) -> void;
+auto write_header(std::string &out, std::string_view name, std::string_view type, std::string_view help) -> void;
+
+} // namespace lynx::metrics
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "models/dtos/dto_customers.h"
+#include "models/dtos/dto_orders.h"
+#include "models/dtos/dto_payment.h"
+#include "models/dtos/dto_product.h"
+#include "utils/convert.h"
+#include "utils/json_reader.h"
+#include "utils/json_writer.h"
+
+/*
+ * Descritores de campos dos DTOs: os de resposta na ordem em que aparecem no JSON, os de criação
+ * com os campos opcionais marcados (ausentes, ficam com o padrão do DTO).
+ */
+
+namespace utils::json
+{
+
+inline auto write(JsonWriter &writer, lynx::models::Category category) -> void
+{
+    writer.value(utils::category_to_string(category));
+}
+
+inline auto write(JsonWriter &writer, lynx::models::PaymentMethod method) -> void
+{
+    writer.value(utils::payment_method_to_string(method));
+}
+
+// Enums chegam como string; o valor recebido fica fora da mensagem de erro
+inline auto read(JsonReader &reader, lynx::models::Category &category) -> void
+{
+    std::string text;
+    reader.read_string(text);
+
+    try
+    {
+        category = utils::string_to_category(text);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+        reader.fail("unknown product category");
+    }
+}
+
+inline auto read(JsonReader &reader, lynx::models::PaymentMethod &method) -> void
+{
+    std::string text;
+    reader.read_string(text);
+
+    try
+    {
+        method = utils::string_to_payment_method(text);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+        reader.fail("unknown payment method");
+    }
+}
+
+template <> struct JsonFields<lynx::models::dto::ProductResponseDTO>
+{
+    using T = lynx::models::dto::ProductResponseDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("id", &T::id), field("name", &T::name), field("category", &T::category),
+                                                    field("price_cents", &T::price_cents), field("active", &T::active),
+                                                    field("stock", &T::stock));
+};
+
+template <> struct JsonFields<lynx::models::dto::OrderSummaryDTO>
+{
+    using T = lynx::models::dto::OrderSummaryDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("id", &T::id), field("customer_id", &T::customer_id), field("status", &T::status),
+                                                    field("created_at", &T::created_at), field("total_cents", &T::total_cents),
+                                                    field("total_paid_cents", &T::total_paid_cents));
+};
+
+template <> struct JsonFields<lynx::models::dto::OrderItemDetailsDTO>
+{
+    using T = lynx::models::dto::OrderItemDetailsDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("product_id", &T::product_id), field("product_name", &T::product_name),
+                                                    field("quantity", &T::quantity), field("unit_price_cents", &T::unit_price_cents),
+                                                    field("subtotal_cents", &T::subtotal_cents));
+};
+
+template <> struct JsonFields<lynx::models::dto::OrderDetailsResponseDTO>
+{
+    using T = lynx::models::dto::OrderDetailsResponseDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("order_id", &T::order_id), field("customer_id", &T::customer_id),
+                                                    field("status", &T::status), field("created_at", &T::created_at),
+                                                    field("items", &T::items), field("total_cents", &T::total_cents));
+};
+
+template <> struct JsonFields<lynx::models::dto::CustomerResponseDTO>
+{
+    using T = lynx::models::dto::CustomerResponseDTO;
+
+    static constexpr auto fields_ =
+        std::make_tuple(field("id", &T::id), field("name", &T::name), field("email", &T::email), field("created_at", &T::created_at));
+};
+
+template <> struct JsonFields<lynx::models::dto::PaymentResponseDTO>
+{
+    using T = lynx::models::dto::PaymentResponseDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("id", &T::id), field("order_id", &T::order_id), field("method", &T::method),
+                                                    field("amount_cents", &T::amount_cents), field("paid_at", &T::paid_at),
+                                                    field("still_missing", &T::still_missing));
+};
+
+template <> struct JsonFields<lynx::models::dto::OrderItemDTO>
+{
+    using T = lynx::models::dto::OrderItemDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("product_id", &T::product_id), field("quantity", &T::quantity));
+};
+
+template <> struct JsonFields<lynx::models::dto::OrderCreateDTO>
+{
+    using T = lynx::models::dto::OrderCreateDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("customer_id", &T::customer_id), field("items", &T::items));
+};
+
+template <> struct JsonFields<lynx::models::dto::PaymentCreateDTO>
+{
+    using T = lynx::models::dto::PaymentCreateDTO;
+
+    static constexpr auto fields_ =
+        std::make_tuple(field("order_id", &T::order_id), field("method", &T::method), field("amount_cents", &T::amount_cents));
+};
+
+// Uma linha do NDJSON de POST /api/payments/confirm; line é preenchido pelo controller
+template <> struct JsonFields<lynx::models::dto::PaymentConfirmationDTO>
+{
+    using T = lynx::models::dto::PaymentConfirmationDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("payment_id", &T::payment_id), field("paid_at", &T::paid_at, Presence::optional));
+};
+
+template <> struct JsonFields<lynx::models::dto::ProductCreateDTO>
+{
+    using T = lynx::models::dto::ProductCreateDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("name", &T::name), field("category", &T::category),
+                                                    field("price_cents", &T::price_cents), field("active", &T::active, Presence::optional),
+                                                    field("stock", &T::stock, Presence::optional));
+};
+
+template <> struct JsonFields<lynx::models::dto::StockAdjustmentDTO>
+{
+    using T = lynx::models::dto::StockAdjustmentDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("delta", &T::delta));
+};
+
+template <> struct JsonFields<lynx::models::dto::CustomerCreateDTO>
+{
+    using T = lynx::models::dto::CustomerCreateDTO;
+
+    static constexpr auto fields_ = std::make_tuple(field("name", &T::name), field("email", &T::email));
+};
+
+} // namespace utils::json
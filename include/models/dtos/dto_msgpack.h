@@ -0,0 +1,55 @@
+#pragma once
+
+#include "models/dtos/dto_json.h"
+#include "utils/msgpack_reader.h"
+#include "utils/msgpack_writer.h"
+
+/*
+ * Enums dos DTOs em MessagePack; os campos vêm dos mesmos descritores de dto_json.h. Os enums seguem
+ * como string, igual ao JSON, para que os consumidores não dependam da ordem dos valores.
+ */
+
+namespace utils::msgpack
+{
+
+inline auto write(MsgPackWriter &writer, lynx::models::Category category) -> void
+{
+    writer.value(utils::category_to_string(category));
+}
+
+inline auto write(MsgPackWriter &writer, lynx::models::PaymentMethod method) -> void
+{
+    writer.value(utils::payment_method_to_string(method));
+}
+
+inline auto read(MsgPackReader &reader, lynx::models::Category &category) -> void
+{
+    std::string text;
+    reader.read_string(text);
+
+    try
+    {
+        category = utils::string_to_category(text);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+        reader.fail("unknown product category");
+    }
+}
+
+inline auto read(MsgPackReader &reader, lynx::models::PaymentMethod &method) -> void
+{
+    std::string text;
+    reader.read_string(text);
+
+    try
+    {
+        method = utils::string_to_payment_method(text);
+    }
+    catch (const lynx::exceptions::CustomError &)
+    {
+        reader.fail("unknown payment method");
+    }
+}
+
+} // namespace utils::msgpack
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <optional>
 #include <string>
+#include <vector>
 
 
 namespace lynx::models::dto
@@ -22,6 +23,39 @@ struct PaymentResponseDTO
     PaymentMethod method;
     int amount_cents;
     std::optional<std::chrono::system_clock::time_point> paid_at;
-    std::optional<int> still_missing;
+    std::optional<int> still_missing = std::nullopt;
+};
+
+struct PaymentPageDTO
+{
+    std::vector<PaymentResponseDTO> items;
+    std::optional<PaymentCursor> next_cursor;
+};
+
+struct PaymentConfirmationDTO
+{
+    int line;
+    int payment_id;
+    std::optional<std::chrono::system_clock::time_point> paid_at;
+};
+
+struct PaymentConfirmationResultDTO
+{
+    int line;
+    int payment_id;
+    ConfirmationStatus status;
+    std::optional<int> order_id;
+    std::optional<std::string> error;
+};
+
+struct PaymentConfirmationSummaryDTO
+{
+    int received = 0;
+    int confirmed = 0;
+    int already_paid = 0;
+    int not_found = 0;
+    int invalid = 0;
+    int orders_paid = 0;
+    std::vector<PaymentConfirmationResultDTO> results;
 };
 } // namespace lynx::models::dto
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include "models/product.h"
 
@@ -11,6 +12,7 @@ namespace lynx::models::dto
         Category category;
         int price_cents;
         bool active = true;
+        std::optional<int> stock;
     };
 
     struct ProductResponseDTO
@@ -20,5 +22,13 @@ namespace lynx::models::dto
         Category category;
         int price_cents;
         bool active;
+        std::optional<int> stock;
+
+        bool operator==(const ProductResponseDTO &other) const = default;
+    };
+
+    struct StockAdjustmentDTO
+    {
+        int delta; // entrada (> 0) ou baixa (< 0)
     };
 }
\ No newline at end of file
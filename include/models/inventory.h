@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace lynx::models
+{
+
+struct ProductStock
+{
+    int product_id;
+    int64_t stock;
+};
+
+struct StockDelta
+{
+    int product_id;
+    int64_t quantity;
+};
+
+} // namespace lynx::models
@@ -3,6 +3,7 @@
 #include "customers.h"
 #include "order_item.h"
 #include <chrono>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -36,6 +37,12 @@ struct OrderSummary
     int64_t total_paid_cents;
 };
 
+struct PendingOrder
+{
+    int id;
+    std::chrono::system_clock::time_point created_at;
+};
+
 struct OrderItemDetails
 {
     int product_id;
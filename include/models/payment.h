@@ -1,9 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
-#include <optional>
 
 namespace lynx::models
 {
@@ -25,4 +26,47 @@ struct Payment
     std::optional<std::chrono::system_clock::time_point> paid_at;
 };
 
+struct PaymentCursor
+{
+    int id;
+    std::optional<std::chrono::system_clock::time_point> paid_at; // presente só na paginação por data
+};
+
+struct PaymentFilters
+{
+    std::optional<int> order_id;
+    std::optional<PaymentMethod> method;
+    std::optional<std::chrono::system_clock::time_point> paid_from; // inclusivo
+    std::optional<std::chrono::system_clock::time_point> paid_to;   // exclusivo
+    std::optional<PaymentCursor> after;
+    int limit = 100;
+
+    // Intervalo de data sem order_id: páginas em ordem de (paid_at, id); os demais filtros, em ordem de id
+    auto pages_by_paid_at() const -> bool
+    {
+        return !order_id.has_value() && (paid_from.has_value() || paid_to.has_value());
+    }
+};
+
+enum class ConfirmationStatus
+{
+    CONFIRMED,
+    ALREADY_PAID,
+    NOT_FOUND,
+    INVALID
+};
+
+struct PaymentConfirmation
+{
+    int payment_id;
+    std::string paid_at;
+};
+
+struct PaymentConfirmationResult
+{
+    int payment_id;
+    ConfirmationStatus status;
+    std::optional<int> order_id;
+};
+
 } // namespace lynx::models
\ No newline at end of file
@@ -32,6 +32,7 @@ struct Product
     Category category;
     int price_cents;
     bool active = true;
+    std::optional<int> stock; // nullopt: estoque não controlado, o produto nunca esgota
 };
 
 struct ProductFilters
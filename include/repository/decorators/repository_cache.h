@@ -0,0 +1,239 @@
+#pragma once
+
+#include "database/query_cache.h"
+#include "metrics/metrics_registry.h"
+#include "models/customers.h"
+#include "models/order.h"
+#include "models/payment.h"
+#include "models/product.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lynx::repository::decorators
+{
+
+// ======================
+// Chave: os argumentos do método, no lugar dos parâmetros ligados ao statement
+// ======================
+
+template <typename T>
+    requires std::is_integral_v<T> || std::is_enum_v<T>
+auto append_key(std::string &key, T value) -> void
+{
+    key += std::to_string(static_cast<int64_t>(value));
+    key += '|';
+}
+
+inline auto append_key(std::string &key, const std::string &text) -> void
+{
+    // Tamanho na frente: nenhum texto se confunde com o separador
+    key += std::to_string(text.size());
+    key += ':';
+    key += text;
+    key += '|';
+}
+
+inline auto append_key(std::string &key, const std::chrono::system_clock::time_point &tp) -> void
+{
+    append_key(key, static_cast<int64_t>(tp.time_since_epoch().count()));
+}
+
+inline auto append_key(std::string &key, const models::PaymentCursor &cursor) -> void;
+
+// Restrito ao que tem chave: optional<Product> (update) não entra no cache por acidente
+template <typename T>
+    requires requires(std::string &key, const T &value) { append_key(key, value); }
+auto append_key(std::string &key, const std::optional<T> &value) -> void
+{
+    if (!value.has_value())
+    {
+        key += "-|";
+        return;
+    }
+    append_key(key, *value);
+}
+
+inline auto append_key(std::string &key, const models::ProductFilters &filters) -> void
+{
+    append_key(key, filters.category);
+    append_key(key, filters.active);
+    append_key(key, filters.min_price_cents);
+    append_key(key, filters.max_price_cents);
+}
+
+inline auto append_key(std::string &key, const models::PaymentCursor &cursor) -> void
+{
+    append_key(key, cursor.id);
+    append_key(key, cursor.paid_at);
+}
+
+inline auto append_key(std::string &key, const models::PaymentFilters &filters) -> void
+{
+    append_key(key, filters.order_id);
+    append_key(key, filters.method);
+    append_key(key, filters.paid_from);
+    append_key(key, filters.paid_to);
+    append_key(key, filters.after);
+    append_key(key, filters.limit);
+}
+
+// Argumentos sem append_key (Order&, vetores) deixam o método fora do cache em tempo de compilação
+template <typename T>
+concept CacheKey = requires(std::string &key, const T &value) { append_key(key, value); };
+
+// ======================
+// Tamanho estimado do resultado, para o limite de memória do cache
+// ======================
+
+template <typename T> auto approx_bytes(const T &) -> size_t
+{
+    return sizeof(T);
+}
+
+// Só o que passa do buffer interno (SSO) ocupa memória à parte
+inline auto approx_bytes(const std::string &text) -> size_t
+{
+    return sizeof(std::string) + (text.size() > 15 ? text.capacity() + 1 : 0);
+}
+
+template <typename T> auto approx_bytes(const std::optional<T> &value) -> size_t;
+template <typename T> auto approx_bytes(const std::vector<T> &values) -> size_t;
+
+inline auto approx_bytes(const models::Product &product) -> size_t
+{
+    return sizeof(models::Product) - sizeof(std::string) + approx_bytes(product.name);
+}
+
+inline auto approx_bytes(const models::Customer &customer) -> size_t
+{
+    return sizeof(models::Customer) - 2 * sizeof(std::string) + approx_bytes(customer.name) + approx_bytes(customer.email);
+}
+
+inline auto approx_bytes(const models::Order &order) -> size_t
+{
+    return sizeof(models::Order) - sizeof(order.items) - sizeof(order.customer) + approx_bytes(order.items) + approx_bytes(order.customer);
+}
+
+template <typename T> auto approx_bytes(const std::optional<T> &value) -> size_t
+{
+    return value.has_value() ? sizeof(std::optional<T>) - sizeof(T) + approx_bytes(*value) : sizeof(std::optional<T>);
+}
+
+template <typename T> auto approx_bytes(const std::vector<T> &values) -> size_t
+{
+    size_t bytes = sizeof(std::vector<T>) + (values.capacity() - values.size()) * sizeof(T);
+    for (const auto &value : values)
+        bytes += approx_bytes(value);
+
+    return bytes;
+}
+
+/*
+ * Policy dos decorators de repositório que guarda os resultados das leituras no QueryCache.
+ *
+ * Só os métodos registrados em cache_method, cada um com as tabelas que lê, passam pelo cache; a chave é
+ * repositório + método + argumentos, o equivalente ao SQL montado mais os parâmetros ligados. Escritas
+ * e métodos sem argumentos serializáveis seguem direto. Exceções não são guardadas. Hits e misses são
+ * contados por método, em atômicos relaxados como na RepositoryInstrumentation.
+ */
+class RepositoryCache
+{
+private:
+    struct alignas(64) MethodCounters
+    {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+
+    std::string repository_;
+    std::vector<const char *> method_names_;
+    std::vector<database::TableMask> method_tables_; // 0: não cacheado
+    std::unique_ptr<MethodCounters[]> counters_;
+    std::shared_ptr<database::QueryCache> cache_;
+
+public:
+    RepositoryCache(std::string repository, std::span<const char *const> method_names, std::shared_ptr<database::QueryCache> cache)
+        : repository_(std::move(repository))
+        , method_names_(method_names.begin(), method_names.end())
+        , method_tables_(method_names.size(), 0)
+        , counters_(std::make_unique<MethodCounters[]>(method_names.size()))
+        , cache_(std::move(cache))
+    {
+    }
+
+    /* Passa o método pelo cache; tables são todas as tabelas que o SQL dele lê */
+    auto cache_method(size_t method, database::TableMask tables) -> RepositoryCache &
+    {
+        method_tables_[method] = tables;
+        return *this;
+    }
+
+    template <typename Call, typename... Args> auto invoke(size_t method, Call &&call, const Args &...args) -> std::invoke_result_t<Call>
+    {
+        using Result = std::invoke_result_t<Call>;
+
+        if constexpr (!std::is_void_v<Result> && std::is_copy_constructible_v<Result> && (CacheKey<Args> && ...))
+        {
+            const auto tables = method_tables_[method];
+            if (tables == 0)
+                return call();
+
+            std::string key = repository_;
+            key += '.';
+            key += method_names_[method];
+            key += '|';
+            (append_key(key, args), ...);
+
+            auto &counters = counters_[method];
+
+            if (auto cached = cache_->find(key))
+            {
+                counters.hits.fetch_add(1, std::memory_order_relaxed);
+                return *std::static_pointer_cast<const Result>(cached);
+            }
+
+            counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+            // Versões antes da consulta: escrita concorrente deixa a entrada velha, nunca um resultado antigo com versão nova
+            const auto versions = cache_->versions();
+            auto result = std::make_shared<const Result>(call());
+            cache_->store(std::move(key), tables, versions, result, approx_bytes(*result));
+            return *result;
+        }
+        else
+        {
+            return call();
+        }
+    }
+
+    /* Hits e misses de todos os repositórios no formato do Prometheus; coletor do MetricsRegistry */
+    static auto render(std::string &out, std::span<const std::shared_ptr<RepositoryCache>> caches) -> void
+    {
+        metrics::write_header(out, "lynx_query_cache_requests_total", "counter", "Leituras de repositório pelo cache de consultas, por resultado.");
+
+        for (const auto &cache : caches)
+        {
+            for (size_t i = 0; i < cache->method_names_.size(); ++i)
+            {
+                if (cache->method_tables_[i] == 0)
+                    continue;
+
+                const auto labels = "repository=\"" + cache->repository_ + "\",method=\"" + cache->method_names_[i] + "\"";
+                metrics::write_sample(out, "lynx_query_cache_requests_total", labels + ",result=\"hit\"",
+                                      static_cast<int64_t>(cache->counters_[i].hits.load(std::memory_order_relaxed)));
+                metrics::write_sample(out, "lynx_query_cache_requests_total", labels + ",result=\"miss\"",
+                                      static_cast<int64_t>(cache->counters_[i].misses.load(std::memory_order_relaxed)));
+            }
+        }
+    }
+};
+
+} // namespace lynx::repository::decorators
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "database/query_cache.h"
+#include "metrics/metrics_registry.h"
+#include "repository/decorators/repository_cache.h"
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lynx::repository::decorators
+{
+
+/* Opt-in por rota: cada flag liga os métodos de repositório que a rota consulta */
+struct CoalescingConfig
+{
+    bool enabled = true;
+    bool products = true;       // GET /api/products e /api/products/<id>
+    bool orders_summary = true; // GET /api/orders/summary
+};
+
+/*
+ * Policy dos decorators de repositório que junta leituras idênticas simultâneas (single-flight).
+ *
+ * Para os métodos registrados em coalesce_method, a primeira chamada com uma chave (repositório +
+ * método + argumentos, a mesma do RepositoryCache) executa; as que chegam enquanto ela roda esperam o
+ * shared_future dela e recebem uma cópia do resultado, ou a mesma exceção. Uma chamada só entra num
+ * voo se nenhuma das tabelas do método mudou desde que ele começou (versões do QueryCache): uma
+ * leitura feita depois de uma escrita nunca recebe um resultado anterior a ela.
+ *
+ * Fica abaixo do RepositoryCache: num miss em massa (expiração, invalidação, deploy) só uma consulta
+ * vai ao SQLite por chave.
+ */
+class RepositoryCoalescing
+{
+private:
+    struct Flight
+    {
+        std::shared_future<std::shared_ptr<const void>> result;
+        database::TableVersions versions;
+    };
+
+    struct alignas(64) MethodCounters
+    {
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> coalesced{0};
+    };
+
+    std::string repository_;
+    std::vector<const char *> method_names_;
+    std::vector<database::TableMask> method_tables_; // 0: fora do single-flight
+    std::unique_ptr<MethodCounters[]> counters_;
+    std::shared_ptr<database::QueryCache> versions_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+
+    // Só o próprio voo sai do mapa: um voo mais novo da mesma chave pode tê-lo substituído
+    auto finish(const std::string &key, const std::shared_ptr<Flight> &flight) -> void
+    {
+        std::lock_guard lock(mutex_);
+        if (const auto it = flights_.find(key); it != flights_.end() && it->second == flight)
+            flights_.erase(it);
+    }
+
+public:
+    RepositoryCoalescing(std::string repository, std::span<const char *const> method_names, std::shared_ptr<database::QueryCache> versions)
+        : repository_(std::move(repository))
+        , method_names_(method_names.begin(), method_names.end())
+        , method_tables_(method_names.size(), 0)
+        , counters_(std::make_unique<MethodCounters[]>(method_names.size()))
+        , versions_(std::move(versions))
+    {
+    }
+
+    /* Junta as chamadas simultâneas do método; tables são todas as tabelas que o SQL dele lê */
+    auto coalesce_method(size_t method, database::TableMask tables) -> RepositoryCoalescing &
+    {
+        method_tables_[method] = tables;
+        return *this;
+    }
+
+    template <typename Call, typename... Args> auto invoke(size_t method, Call &&call, const Args &...args) -> std::invoke_result_t<Call>
+    {
+        using Result = std::invoke_result_t<Call>;
+
+        if constexpr (!std::is_void_v<Result> && std::is_copy_constructible_v<Result> && (CacheKey<Args> && ...))
+        {
+            const auto tables = method_tables_[method];
+            if (tables == 0)
+                return call();
+
+            std::string key = repository_;
+            key += '.';
+            key += method_names_[method];
+            key += '|';
+            (append_key(key, args), ...);
+
+            auto &counters = counters_[method];
+
+            std::promise<std::shared_ptr<const void>> promise;
+            std::shared_ptr<Flight> joined;
+            auto flight = std::make_shared<Flight>();
+
+            {
+                std::lock_guard lock(mutex_);
+
+                const auto it = flights_.find(key);
+                if (it != flights_.end() && versions_->is_current(tables, it->second->versions))
+                {
+                    joined = it->second;
+                }
+                else
+                {
+                    flight->result = promise.get_future().share();
+                    flight->versions = versions_->versions();
+                    flights_.insert_or_assign(key, flight);
+                }
+            }
+
+            if (joined)
+            {
+                counters.coalesced.fetch_add(1, std::memory_order_relaxed);
+                return *std::static_pointer_cast<const Result>(joined->result.get());
+            }
+
+            counters.executed.fetch_add(1, std::memory_order_relaxed);
+
+            try
+            {
+                auto result = std::make_shared<const Result>(call());
+                finish(key, flight);
+                promise.set_value(result);
+                return *result;
+            }
+            catch (...)
+            {
+                finish(key, flight);
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+        }
+        else
+        {
+            return call();
+        }
+    }
+
+    /* Chamadas executadas e juntadas a um voo, de todos os repositórios; coletor do MetricsRegistry */
+    static auto render(std::string &out, std::span<const std::shared_ptr<RepositoryCoalescing>> coalescings) -> void
+    {
+        metrics::write_header(out, "lynx_repository_coalescing_requests_total", "counter",
+                              "Leituras pelo single-flight: executadas no SQLite ou juntadas a uma idêntica em andamento.");
+
+        for (const auto &coalescing : coalescings)
+        {
+            for (size_t i = 0; i < coalescing->method_names_.size(); ++i)
+            {
+                if (coalescing->method_tables_[i] == 0)
+                    continue;
+
+                const auto labels = "repository=\"" + coalescing->repository_ + "\",method=\"" + coalescing->method_names_[i] + "\"";
+                metrics::write_sample(out, "lynx_repository_coalescing_requests_total", labels + ",result=\"executed\"",
+                                      static_cast<int64_t>(coalescing->counters_[i].executed.load(std::memory_order_relaxed)));
+                metrics::write_sample(out, "lynx_repository_coalescing_requests_total", labels + ",result=\"coalesced\"",
+                                      static_cast<int64_t>(coalescing->counters_[i].coalesced.load(std::memory_order_relaxed)));
+            }
+        }
+    }
+};
+
+} // namespace lynx::repository::decorators
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "repository/interfaces/interface_customer.h"
+#include "repository/interfaces/interface_inventory.h"
+#include "repository/interfaces/interface_order.h"
+#include "repository/interfaces/interface_payment.h"
+#include "repository/interfaces/interface_product.h"
+#include <array>
+#include <memory>
+
+/*
+ * Decorators das interfaces de repositório, um por interface, parametrizados por uma Policy.
+ *
+ * Cada método repassa a chamada ao repositório de dentro por meio de Policy::invoke(método, chamada,
+ * argumentos...), onde o método é o índice na tabela *Methods da interface e os argumentos são os do
+ * método, para a policy que precisar deles (a chave do RepositoryCache e do RepositoryCoalescing). A
+ * policy decide o que acontece em volta (medir, cachear, juntar leituras simultâneas) sem que os
+ * repositórios SQLite mudem; como o decorator implementa a própria interface, policies diferentes se
+ * empilham envolvendo um decorator no outro.
+ */
+
+namespace lynx::repository::decorators
+{
+
+struct OrderMethods
+{
+    enum : size_t
+    {
+        create,
+        find_by_id,
+        find_all,
+        find_by_id_with_customer,
+        find_pending_deadlines,
+        update,
+        update_status,
+        mark_settled_as_paid,
+        cancel_expired,
+        remove,
+        find_items_by_order_id,
+        sum_items_total_by_order,
+        find_all_summary,
+        count_
+    };
+
+    static constexpr std::array<const char *, count_> names_ = {"create",
+                                                                "find_by_id",
+                                                                "find_all",
+                                                                "find_by_id_with_customer",
+                                                                "find_pending_deadlines",
+                                                                "update",
+                                                                "update_status",
+                                                                "mark_settled_as_paid",
+                                                                "cancel_expired",
+                                                                "remove",
+                                                                "find_items_by_order_id",
+                                                                "sum_items_total_by_order",
+                                                                "find_all_summary"};
+};
+
+template <typename Policy> class OrderRepositoryDecorator : public interface::IOrderRepository
+{
+private:
+    std::shared_ptr<interface::IOrderRepository> inner_;
+    std::shared_ptr<Policy> policy_;
+
+public:
+    OrderRepositoryDecorator(std::shared_ptr<interface::IOrderRepository> inner, std::shared_ptr<Policy> policy)
+        : inner_(inner)
+        , policy_(policy)
+    {
+    }
+
+    auto create(models::Order &order) -> void override
+    {
+        policy_->invoke(OrderMethods::create, [&] { inner_->create(order); }, order);
+    }
+
+    auto find_by_id(int id) -> std::optional<models::Order> override
+    {
+        return policy_->invoke(OrderMethods::find_by_id, [&] { return inner_->find_by_id(id); }, id);
+    }
+
+    auto find_all() -> std::vector<models::Order> override
+    {
+        return policy_->invoke(OrderMethods::find_all, [&] { return inner_->find_all(); });
+    }
+
+    auto find_by_id_with_customer(int id) -> std::optional<models::Order> override
+    {
+        return policy_->invoke(OrderMethods::find_by_id_with_customer, [&] { return inner_->find_by_id_with_customer(id); }, id);
+    }
+
+    auto find_pending_deadlines() -> std::vector<models::PendingOrder> override
+    {
+        return policy_->invoke(OrderMethods::find_pending_deadlines, [&] { return inner_->find_pending_deadlines(); });
+    }
+
+    auto update(const int &id, const models::Order &order) -> void override
+    {
+        policy_->invoke(OrderMethods::update, [&] { inner_->update(id, order); }, id, order);
+    }
+
+    auto update_status(int order_id, const models::OrderStatus &status) -> errors::Result<void> override
+    {
+        return policy_->invoke(OrderMethods::update_status, [&] { return inner_->update_status(order_id, status); }, order_id, status);
+    }
+
+    auto mark_settled_as_paid(const std::vector<int> &order_ids) -> std::vector<int> override
+    {
+        return policy_->invoke(OrderMethods::mark_settled_as_paid, [&] { return inner_->mark_settled_as_paid(order_ids); }, order_ids);
+    }
+
+    auto cancel_expired(const std::vector<int> &order_ids, const std::chrono::system_clock::time_point &created_before)
+        -> std::vector<int> override
+    {
+        return policy_->invoke(OrderMethods::cancel_expired, [&] { return inner_->cancel_expired(order_ids, created_before); }, order_ids,
+                               created_before);
+    }
+
+    auto remove(int id) -> void override
+    {
+        policy_->invoke(OrderMethods::remove, [&] { inner_->remove(id); }, id);
+    }
+
+    auto find_items_by_order_id(int order_id) -> std::vector<models::OrderItem> override
+    {
+        return policy_->invoke(OrderMethods::find_items_by_order_id, [&] { return inner_->find_items_by_order_id(order_id); }, order_id);
+    }
+
+    auto sum_items_total_by_order(int order_id) -> int64_t override
+    {
+        return policy_->invoke(OrderMethods::sum_items_total_by_order, [&] { return inner_->sum_items_total_by_order(order_id); }, order_id);
+    }
+
+    auto find_all_summary(const std::optional<std::string> &status_filter, const std::optional<int> &customer_id_filter,
+                          const std::optional<int> &limit) -> std::vector<models::OrderSummary> override
+    {
+        return policy_->invoke(OrderMethods::find_all_summary,
+                               [&] { return inner_->find_all_summary(status_filter, customer_id_filter, limit); }, status_filter,
+                               customer_id_filter, limit);
+    }
+};
+
+struct ProductMethods
+{
+    enum : size_t
+    {
+        create,
+        find_product_by_id,
+        find_all,
+        update,
+        remove,
+        count_
+    };
+
+    static constexpr std::array<const char *, count_> names_ = {"create", "find_product_by_id", "find_all", "update", "remove"};
+};
+
+template <typename Policy> class ProductRepositoryDecorator : public interface::IProductRepository
+{
+private:
+    std::shared_ptr<interface::IProductRepository> inner_;
+    std::shared_ptr<Policy> policy_;
+
+public:
+    ProductRepositoryDecorator(std::shared_ptr<interface::IProductRepository> inner, std::shared_ptr<Policy> policy)
+        : inner_(inner)
+        , policy_(policy)
+    {
+    }
+
+    auto create(models::Product &product) -> void override
+    {
+        policy_->invoke(ProductMethods::create, [&] { inner_->create(product); }, product);
+    }
+
+    auto find_product_by_id(int id) -> std::optional<models::Product> override
+    {
+        return policy_->invoke(ProductMethods::find_product_by_id, [&] { return inner_->find_product_by_id(id); }, id);
+    }
+
+    auto find_all(const models::ProductFilters &filters) -> std::vector<models::Product> override
+    {
+        return policy_->invoke(ProductMethods::find_all, [&] { return inner_->find_all(filters); }, filters);
+    }
+
+    auto update(const int &id, const std::optional<models::Product> &product) -> errors::Result<void> override
+    {
+        return policy_->invoke(ProductMethods::update, [&] { return inner_->update(id, product); }, id, product);
+    }
+
+    auto remove(int id) -> void override
+    {
+        policy_->invoke(ProductMethods::remove, [&] { inner_->remove(id); }, id);
+    }
+};
+
+struct CustomerMethods
+{
+    enum : size_t
+    {
+        create,
+        find_by_id,
+        find_by_email,
+        find_all,
+        update,
+        remove,
+        count_
+    };
+
+    static constexpr std::array<const char *, count_> names_ = {"create", "find_by_id", "find_by_email", "find_all", "update", "remove"};
+};
+
+template <typename Policy> class CustomerRepositoryDecorator : public interface::ICustomerRepository
+{
+private:
+    std::shared_ptr<interface::ICustomerRepository> inner_;
+    std::shared_ptr<Policy> policy_;
+
+public:
+    CustomerRepositoryDecorator(std::shared_ptr<interface::ICustomerRepository> inner, std::shared_ptr<Policy> policy)
+        : inner_(inner)
+        , policy_(policy)
+    {
+    }
+
+    auto create(models::Customer &customer) -> void override
+    {
+        policy_->invoke(CustomerMethods::create, [&] { inner_->create(customer); }, customer);
+    }
+
+    auto find_by_id(int id) -> std::optional<models::Customer> override
+    {
+        return policy_->invoke(CustomerMethods::find_by_id, [&] { return inner_->find_by_id(id); }, id);
+    }
+
+    auto find_by_email(const std::string &email) -> std::optional<models::Customer> override
+    {
+        return policy_->invoke(CustomerMethods::find_by_email, [&] { return inner_->find_by_email(email); }, email);
+    }
+
+    auto find_all() -> std::vector<models::Customer> override
+    {
+        return policy_->invoke(CustomerMethods::find_all, [&] { return inner_->find_all(); });
+    }
+
+    auto update(const int &id, const models::Customer &customer) -> void override
+    {
+        policy_->invoke(CustomerMethods::update, [&] { inner_->update(id, customer); }, id, customer);
+    }
+
+    auto remove(int id) -> void override
+    {
+        policy_->invoke(CustomerMethods::remove, [&] { inner_->remove(id); }, id);
+    }
+};
+
+struct PaymentMethods
+{
+    enum : size_t
+    {
+        create,
+        find_by_id,
+        find_all,
+        sum_by_order,
+        mark_as_paid,
+        mark_as_paid_batch,
+        update,
+        remove,
+        count_
+    };
+
+    static constexpr std::array<const char *, count_> names_ = {"create",       "find_by_id",         "find_all", "sum_by_order",
+                                                                "mark_as_paid", "mark_as_paid_batch", "update", "remove"};
+};
+
+template <typename Policy> class PaymentRepositoryDecorator : public interface::IPaymentRepository
+{
+private:
+    std::shared_ptr<interface::IPaymentRepository> inner_;
+    std::shared_ptr<Policy> policy_;
+
+public:
+    PaymentRepositoryDecorator(std::shared_ptr<interface::IPaymentRepository> inner, std::shared_ptr<Policy> policy)
+        : inner_(inner)
+        , policy_(policy)
+    {
+    }
+
+    auto create(models::Payment &payment) -> void override
+    {
+        policy_->invoke(PaymentMethods::create, [&] { inner_->create(payment); }, payment);
+    }
+
+    auto find_by_id(int id) -> std::optional<models::Payment> override
+    {
+        return policy_->invoke(PaymentMethods::find_by_id, [&] { return inner_->find_by_id(id); }, id);
+    }
+
+    auto find_all(const models::PaymentFilters &filters) -> std::vector<models::Payment> override
+    {
+        return policy_->invoke(PaymentMethods::find_all, [&] { return inner_->find_all(filters); }, filters);
+    }
+
+    auto sum_by_order(int order_id) -> int override
+    {
+        return policy_->invoke(PaymentMethods::sum_by_order, [&] { return inner_->sum_by_order(order_id); }, order_id);
+    }
+
+    auto mark_as_paid(int payment_id, const std::string &paid_at) -> void override
+    {
+        policy_->invoke(PaymentMethods::mark_as_paid, [&] { inner_->mark_as_paid(payment_id, paid_at); }, payment_id, paid_at);
+    }
+
+    auto mark_as_paid_batch(const std::vector<models::PaymentConfirmation> &confirmations)
+        -> std::vector<models::PaymentConfirmationResult> override
+    {
+        return policy_->invoke(PaymentMethods::mark_as_paid_batch, [&] { return inner_->mark_as_paid_batch(confirmations); }, confirmations);
+    }
+
+    auto update(const int &id, const models::Payment &payment) -> void override
+    {
+        policy_->invoke(PaymentMethods::update, [&] { inner_->update(id, payment); }, id, payment);
+    }
+
+    auto remove(int id) -> void override
+    {
+        policy_->invoke(PaymentMethods::remove, [&] { inner_->remove(id); }, id);
+    }
+};
+
+struct InventoryMethods
+{
+    enum : size_t
+    {
+        find_stock,
+        find_all_stock,
+        sum_items_by_orders,
+        write_back,
+        adjust_stock,
+        count_
+    };
+
+    static constexpr std::array<const char *, count_> names_ = {"find_stock", "find_all_stock", "sum_items_by_orders", "write_back",
+                                                                "adjust_stock"};
+};
+
+template <typename Policy> class InventoryRepositoryDecorator : public interface::IInventoryRepository
+{
+private:
+    std::shared_ptr<interface::IInventoryRepository> inner_;
+    std::shared_ptr<Policy> policy_;
+
+public:
+    InventoryRepositoryDecorator(std::shared_ptr<interface::IInventoryRepository> inner, std::shared_ptr<Policy> policy)
+        : inner_(inner)
+        , policy_(policy)
+    {
+    }
+
+    auto find_stock(int product_id) -> std::optional<int64_t> override
+    {
+        return policy_->invoke(InventoryMethods::find_stock, [&] { return inner_->find_stock(product_id); }, product_id);
+    }
+
+    auto find_all_stock() -> std::vector<models::ProductStock> override
+    {
+        return policy_->invoke(InventoryMethods::find_all_stock, [&] { return inner_->find_all_stock(); });
+    }
+
+    auto sum_items_by_orders(const std::vector<int> &order_ids) -> std::vector<models::StockDelta> override
+    {
+        return policy_->invoke(InventoryMethods::sum_items_by_orders, [&] { return inner_->sum_items_by_orders(order_ids); }, order_ids);
+    }
+
+    auto write_back(const std::vector<models::StockDelta> &restocks) -> void override
+    {
+        policy_->invoke(InventoryMethods::write_back, [&] { inner_->write_back(restocks); }, restocks);
+    }
+
+    auto adjust_stock(int product_id, int64_t delta) -> bool override
+    {
+        return policy_->invoke(InventoryMethods::adjust_stock, [&] { return inner_->adjust_stock(product_id, delta); }, product_id, delta);
+    }
+};
+
+} // namespace lynx::repository::decorators
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "errors/result.h"
+#include "metrics/metrics_registry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lynx::repository::decorators
+{
+
+struct alignas(64) MethodStats
+{
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> rows{0};
+    metrics::LatencyHistogram latency;
+};
+
+// Linhas devolvidas: tamanho do vetor, 0/1 para optional, o valor de um Result; escalares e void não contam
+template <typename T> auto rows_of(const std::vector<T> &result) -> uint64_t
+{
+    return result.size();
+}
+
+template <typename T> auto rows_of(const std::optional<T> &result) -> uint64_t
+{
+    return result.has_value() ? 1 : 0;
+}
+
+template <typename T> auto rows_of(const T &) -> uint64_t
+{
+    return 0;
+}
+
+template <typename T> auto rows_of(const errors::Result<T> &result) -> uint64_t
+{
+    if constexpr (std::is_void_v<T>)
+        return 0;
+    else
+        return result.has_value() ? rows_of(*result) : 0;
+}
+
+// Falha esperada devolvida como valor também conta como erro do método
+template <typename T> auto failed(const errors::Result<T> &result) -> bool
+{
+    return !result.has_value();
+}
+
+template <typename T> auto failed(const T &) -> bool
+{
+    return false;
+}
+
+/*
+ * Policy dos decorators de repositório que mede cada método: chamadas, erros (exceção ou Result com
+ * erro), linhas devolvidas e histograma de latência. Os contadores são atômicos relaxados, um bloco alinhado por método, e o custo
+ * por chamada fica em duas leituras do relógio.
+ */
+class RepositoryInstrumentation
+{
+private:
+    std::string repository_;
+    std::vector<const char *> method_names_;
+    std::unique_ptr<MethodStats[]> methods_;
+
+    static auto record(MethodStats &stats, std::chrono::steady_clock::time_point started, uint64_t rows) -> void;
+
+public:
+    RepositoryInstrumentation(std::string repository, std::span<const char *const> method_names);
+
+    template <typename Call, typename... Args> auto invoke(size_t method, Call &&call, const Args &...) -> std::invoke_result_t<Call>
+    {
+        auto &stats = methods_[method];
+        const auto started = std::chrono::steady_clock::now();
+
+        try
+        {
+            if constexpr (std::is_void_v<std::invoke_result_t<Call>>)
+            {
+                call();
+                record(stats, started, 0);
+            }
+            else
+            {
+                auto result = call();
+                if (failed(result))
+                    stats.errors.fetch_add(1, std::memory_order_relaxed);
+                record(stats, started, rows_of(result));
+                return result;
+            }
+        }
+        catch (...)
+        {
+            stats.errors.fetch_add(1, std::memory_order_relaxed);
+            record(stats, started, 0);
+            throw;
+        }
+    }
+
+    /* Escreve as séries de todos os repositórios no formato do Prometheus, uma família por vez; coletor do MetricsRegistry */
+    static auto render(std::string &out, std::span<const std::shared_ptr<RepositoryInstrumentation>> instrumentations) -> void;
+};
+
+} // namespace lynx::repository::decorators
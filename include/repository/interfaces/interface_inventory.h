@@ -0,0 +1,21 @@
+#pragma once
+
+#include "models/inventory.h"
+#include <optional>
+#include <vector>
+
+namespace lynx::repository::interface
+{
+
+class IInventoryRepository
+{
+public:
+    virtual ~IInventoryRepository() = default;
+
+    virtual auto find_stock(int product_id) -> std::optional<int64_t> = 0;
+    virtual auto find_all_stock() -> std::vector<models::ProductStock> = 0;
+    virtual auto sum_items_by_orders(const std::vector<int> &order_ids) -> std::vector<models::StockDelta> = 0;
+    virtual auto write_back(const std::vector<models::StockDelta> &restocks) -> void = 0;
+    virtual auto adjust_stock(int product_id, int64_t delta) -> bool = 0; // false: produto inexistente
+};
+} // namespace lynx::repository::interface
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "errors/result.h"
 #include "models/order.h"
 #include <cstdint>
 #include <optional>
@@ -17,8 +18,12 @@ public:
     virtual auto find_by_id(int id) -> std::optional<models::Order> = 0;
     virtual auto find_all() -> std::vector<models::Order> = 0;
     virtual auto find_by_id_with_customer(int id) -> std::optional<models::Order> = 0;
+    virtual auto find_pending_deadlines() -> std::vector<models::PendingOrder> = 0;
     virtual auto update(const int &id, const models::Order &order) -> void = 0;
-    virtual auto update_status(int order_id, const models::OrderStatus &status) -> void = 0;
+    virtual auto update_status(int order_id, const models::OrderStatus &status) -> errors::Result<void> = 0; // não encontrado volta como erro
+    virtual auto mark_settled_as_paid(const std::vector<int> &order_ids) -> std::vector<int> = 0; // ids que passaram a PAID
+    virtual auto cancel_expired(const std::vector<int> &order_ids, const std::chrono::system_clock::time_point &created_before)
+        -> std::vector<int> = 0;
     virtual auto remove(int id) -> void = 0;
 
     // Order Items
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "errors/result.h"
 #include "models/product.h"
 #include <optional>
 #include <vector>
@@ -15,7 +16,7 @@ public:
     virtual auto create(models::Product &product) -> void = 0;
     virtual auto find_product_by_id(int id) -> std::optional<models::Product> = 0;
     virtual auto find_all(const models::ProductFilters &filters) -> std::vector<models::Product> = 0;
-    virtual auto update(const int &id, const std::optional<models::Product> &product) -> void = 0;
+    virtual auto update(const int &id, const std::optional<models::Product> &product) -> errors::Result<void> = 0;
     virtual auto remove(int id) -> void = 0;
 };
 } // namespace lynx::repository::interface
\ No newline at end of file
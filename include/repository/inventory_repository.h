@@ -0,0 +1,21 @@
+#pragma once
+
+#include "repository/database/sqlite/sqlite_base_repository.h"
+#include "repository/interfaces/interface_inventory.h"
+
+namespace lynx::repository
+{
+
+class InventoryRepository final : public interface::IInventoryRepository, protected SQLiteBaseRepository
+{
+public:
+    InventoryRepository();
+
+    auto find_stock(int product_id) -> std::optional<int64_t> override;
+    auto find_all_stock() -> std::vector<models::ProductStock> override;
+    auto sum_items_by_orders(const std::vector<int> &order_ids) -> std::vector<models::StockDelta> override;
+    auto write_back(const std::vector<models::StockDelta> &restocks) -> void override;
+    auto adjust_stock(int product_id, int64_t delta) -> bool override;
+};
+
+} // namespace lynx::repository
@@ -16,9 +16,13 @@ public:
     auto find_by_id(int id) -> std::optional<models::Order> override;
     auto find_by_id_with_customer(int id) -> std::optional<models::Order> override;
     auto find_all() -> std::vector<models::Order> override;
+    auto find_pending_deadlines() -> std::vector<models::PendingOrder> override;
     
     auto update(const int &id, const models::Order &order) -> void override;
-    auto update_status(int order_id, const models::OrderStatus &status) -> void override;
+    auto update_status(int order_id, const models::OrderStatus &status) -> errors::Result<void> override;
+    auto mark_settled_as_paid(const std::vector<int> &order_ids) -> std::vector<int> override;
+    auto cancel_expired(const std::vector<int> &order_ids, const std::chrono::system_clock::time_point &created_before)
+        -> std::vector<int> override;
     auto remove(int id) -> void override;
     
     /* Order Items */
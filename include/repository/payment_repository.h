@@ -13,10 +13,12 @@ public:
 
     auto create(models::Payment &Payment) -> void override;
     auto find_by_id(int id) -> std::optional<models::Payment> override;
-    auto find_all() -> std::vector<models::Payment> override;
+    auto find_all(const models::PaymentFilters &filters) -> std::vector<models::Payment> override;
     auto sum_by_order(int order_id) -> int override;
     auto update(const int &id, const models::Payment &Payment) -> void override;
     auto mark_as_paid(int payment_id, const std::string &paid_at) -> void override;
+    auto mark_as_paid_batch(const std::vector<models::PaymentConfirmation> &confirmations)
+        -> std::vector<models::PaymentConfirmationResult> override;
     auto remove(int id) -> void override;
 };
 
@@ -14,7 +14,7 @@ public:
     auto create(models::Product &product) -> void override;
     auto find_product_by_id(int id) -> std::optional<models::Product> override;
     auto find_all(const models::ProductFilters &filters) -> std::vector<models::Product> override;
-    auto update(const int &id, const std::optional<models::Product> &product) -> void override;
+    auto update(const int &id, const std::optional<models::Product> &product) -> errors::Result<void> override;
     auto remove(int id) -> void override;
 };
 
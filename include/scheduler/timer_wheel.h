@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace lynx::scheduler
+{
+
+/*
+ * Timer wheel hierárquico (4 níveis x 64 slots) para prazos identificados por id.
+ *
+ * schedule e cancel são O(1); advance devolve de uma vez todos os ids vencidos, para que quem chama
+ * aplique as expirações em lote. O tempo é medido em ticks absolutos (a duração do tick é de quem usa).
+ * Prazos além de 64^4 ticks ficam numa lista de overflow reavaliada a cada volta completa da roda.
+ */
+class TimerWheel
+{
+private:
+    static constexpr int level_bits_ = 6;
+    static constexpr int levels_ = 4;
+    static constexpr uint64_t slots_ = uint64_t{1} << level_bits_;
+    static constexpr uint64_t slot_mask_ = slots_ - 1;
+
+    struct Entry
+    {
+        int id;
+        uint64_t deadline;
+    };
+
+    uint64_t now_;
+    std::array<std::array<std::vector<Entry>, slots_>, levels_> wheel_;
+    std::vector<Entry> overflow_;
+
+    // Prazo vigente por id; entradas nos slots que não batem com este mapa foram canceladas
+    std::unordered_map<int, uint64_t> deadlines_;
+
+    auto place(const Entry &entry) -> void;
+    auto cascade(int level) -> void;
+
+public:
+    explicit TimerWheel(uint64_t now_tick);
+
+    auto schedule(int id, uint64_t deadline_tick) -> void;
+    auto cancel(int id) -> bool;
+    auto advance(uint64_t now_tick, std::vector<int> &expired) -> void;
+
+    auto now() const -> uint64_t;
+    auto size() const -> size_t;
+};
+
+} // namespace lynx::scheduler
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "handlers/interface.h"
+#include "metrics/metrics_registry.h"
 
 namespace lynx::server
 {
@@ -12,6 +13,11 @@ struct ServerConfig
     std::string log_level = "info";
     bool cors = true;
     std::string cors_origin = "*";
+
+    // Compressão negociada por Accept-Encoding (gzip/deflate, zstd com LYNX_WITH_ZSTD)
+    bool compression = true;
+    int compression_level = 6;
+    size_t compression_min_bytes = 1024;
 };
 
 class Server
@@ -25,8 +31,14 @@ private:
 
 public:
     auto add_handler(std::shared_ptr<interface::IHandler> handler) -> void;
+    auto set_metrics(std::shared_ptr<metrics::MetricsRegistry> registry) -> void;
+    auto set_admission(std::shared_ptr<admission::AdmissionControl> control) -> void;
+    auto set_capture(std::shared_ptr<capture::TrafficRecorder> recorder) -> void;
     explicit Server(const ServerConfig &config = ServerConfig());
 
+    /* Bloqueia até stop(), chamado de outra thread */
     auto start() -> void;
+    auto wait_until_ready() -> void;
+    auto stop() -> void;
 };
 } // namespace lynx::server
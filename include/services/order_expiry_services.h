@@ -0,0 +1,67 @@
+#pragma once
+
+#include "cache/order_details_cache.h"
+#include "inventory/stock_inventory.h"
+#include "ledger/order_ledger.h"
+#include "repository/interfaces/interface_order.h"
+#include "scheduler/timer_wheel.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lynx::services
+{
+
+struct OrderExpiryConfig
+{
+    bool enabled = true;
+    std::chrono::seconds payment_deadline = std::chrono::hours(24); // prazo para pagar um pedido NEW
+    std::chrono::milliseconds tick = std::chrono::seconds(1);       // resolução do timer wheel
+    size_t batch_size = 1000;                                       // pedidos por UPDATE de cancelamento
+};
+
+/*
+ * Cancela pedidos NEW que passaram do prazo de pagamento.
+ *
+ * Os prazos ficam num timer wheel carregado do banco em start() e mantido por create_order e pelos
+ * pagamentos; uma thread avança a roda a cada tick e cancela os vencidos em UPDATEs por lote.
+ * Pedidos com pagamento parcial não são cancelados: ficam NEW e o estoque continua reservado.
+ */
+class OrderExpiryServices
+{
+private:
+    std::shared_ptr<repository::interface::IOrderRepository> repository_;
+    std::shared_ptr<ledger::OrderLedger> ledger_;
+    std::shared_ptr<inventory::StockInventory> inventory_;
+    std::shared_ptr<cache::OrderDetailsCache> details_cache_;
+    OrderExpiryConfig config_;
+
+    std::mutex mutex_;
+    scheduler::TimerWheel wheel_;
+
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    auto to_tick(const std::chrono::system_clock::time_point &tp) const -> uint64_t;
+    auto run() -> void;
+    auto expire(const std::vector<int> &order_ids) -> void;
+
+public:
+    OrderExpiryServices(std::shared_ptr<repository::interface::IOrderRepository> repository, std::shared_ptr<ledger::OrderLedger> ledger,
+                        std::shared_ptr<inventory::StockInventory> inventory, std::shared_ptr<cache::OrderDetailsCache> details_cache,
+                        const OrderExpiryConfig &config = OrderExpiryConfig());
+    ~OrderExpiryServices();
+
+    auto start() -> void;
+    auto stop() -> void;
+
+    auto schedule(int order_id, const std::chrono::system_clock::time_point &created_at) -> void;
+    auto cancel(int order_id) -> void;
+    auto pending() -> size_t;
+};
+
+} // namespace lynx::services
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "cache/order_details_cache.h"
+#include "inventory/stock_inventory.h"
+#include "ledger/order_ledger.h"
 #include "models/dtos/dto_orders.h"
 #include "repository/interfaces/interface_order.h"
 #include "services/customer_services.h"
+#include "services/order_expiry_services.h"
 #include "services/product_services.h"
 #include <memory>
 #include <string>
@@ -16,10 +20,14 @@ private:
     std::shared_ptr<repository::interface::IOrderRepository> repository_;
     std::shared_ptr<ProductServices> product_service_;
     std::shared_ptr<CustomerServices> customer_service_;
+    std::shared_ptr<ledger::OrderLedger> ledger_;
+    std::shared_ptr<OrderExpiryServices> expiry_service_;
+    std::shared_ptr<inventory::StockInventory> inventory_;
+    std::shared_ptr<cache::OrderDetailsCache> details_cache_;
 
-    auto validate_order(const models::Order &order) -> void;
-    auto validate_products(std::vector<models::OrderItem> &items) -> void;
-    auto validate_customer(int customer_id) -> void;
+    auto validate_order(const models::Order &order) -> errors::Result<void>;
+    auto validate_products(std::vector<models::OrderItem> &items) -> errors::Result<void>;
+    auto validate_customer(int customer_id) -> errors::Result<void>;
 
     auto to_response_dto(const models::Order &order) -> models::dto::OrderResponseDTO;
     auto to_summary_dto(const models::OrderSummary &summary) -> models::dto::OrderSummaryDTO;
@@ -27,23 +35,30 @@ private:
 public:
     OrderServices(std::shared_ptr<repository::interface::IOrderRepository> order_repository,
                   std::shared_ptr<repository::interface::IProductRepository> product_repository,
-                  std::shared_ptr<repository::interface::ICustomerRepository> customer_repository);
+                  std::shared_ptr<repository::interface::ICustomerRepository> customer_repository,
+                  std::shared_ptr<ledger::OrderLedger> ledger, std::shared_ptr<OrderExpiryServices> expiry_service,
+                  std::shared_ptr<inventory::StockInventory> inventory, std::shared_ptr<cache::OrderDetailsCache> details_cache);
 
     /* Criação de pedido */
-    auto create_order(const models::dto::OrderCreateDTO &dto) -> models::dto::OrderResponseDTO;
+    auto create_order(const models::dto::OrderCreateDTO &dto) -> errors::Result<models::dto::OrderResponseDTO>;
 
     /* Consultas */
-    auto get_order_by_id(const int &id) -> models::Order;
-    auto get_order_with_customer(const int &id) -> models::Order;
+    auto get_order_by_id(const int &id) -> errors::Result<models::Order>;
+    auto get_order_with_customer(const int &id) -> errors::Result<models::Order>;
     auto get_all_orders() -> std::vector<models::Order>;
     auto get_all_orders_summary(const std::optional<std::string>& status_filter,
     const std::optional<int>& customer_id_filter,
     const std::optional<int>& limit) -> std::vector<models::dto::OrderSummaryDTO>;
-    auto get_order_details(int order_id) -> models::dto::OrderDetailsResponseDTO;
+    auto get_order_details(int order_id) -> errors::Result<models::dto::OrderDetailsResponseDTO>;
 
     /* Operações */
-    auto mark_order_as_paid(const int &order_id) -> void;
+    auto mark_order_as_paid(const int &order_id) -> errors::Result<void>;
+    auto mark_settled_orders_as_paid(const std::vector<int> &order_ids) -> int;
     auto calculate_total_cents(int order_id) -> int64_t;
+    auto get_order_balance(int order_id) -> errors::Result<ledger::OrderBalance>;
+
+    /* Para escritas de fora do service (pagamentos) que mudam o detalhe do pedido */
+    auto invalidate_order_details(int order_id) -> void;
 };
 
 } // namespace lynx::services
\ No newline at end of file
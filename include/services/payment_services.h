@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ledger/order_ledger.h"
 #include "models/dtos/dto_payment.h"
 #include "repository/interfaces/interface_payment.h"
 #include "services/order_services.h"
@@ -13,15 +14,25 @@ class PaymentServices
 private:
     std::shared_ptr<repository::interface::IPaymentRepository> repository_;
     std::shared_ptr<OrderServices> order_service_; // Para validar pedidos e total
+    std::shared_ptr<ledger::OrderLedger> ledger_;
 
-    auto validate_payment(const models::Payment &payment, int total_order_cents, int total_already_paid) -> void;
+    auto validate_payment(const models::Payment &payment) -> errors::Result<void>;
 
     auto to_response_dto(const models::Payment &payment) -> models::dto::PaymentResponseDTO;
 
+    // Quantidade de confirmações aplicadas por transação
+    static constexpr size_t confirmation_batch_size_ = 4096;
+
+    // Tamanho máximo de página na listagem
+    static constexpr int max_page_size_ = 1000;
+
 public:
-    PaymentServices(std::shared_ptr<repository::interface::IPaymentRepository> payment_repository, std::shared_ptr<OrderServices> order_service);
+    PaymentServices(std::shared_ptr<repository::interface::IPaymentRepository> payment_repository, std::shared_ptr<OrderServices> order_service,
+                    std::shared_ptr<ledger::OrderLedger> ledger);
 
-    auto create_payment(const models::dto::PaymentCreateDTO &dto) -> models::dto::PaymentResponseDTO;
-    auto get_payment_by_id(int payment_id) -> models::dto::PaymentResponseDTO;
+    auto create_payment(const models::dto::PaymentCreateDTO &dto) -> errors::Result<models::dto::PaymentResponseDTO>;
+    auto get_payment_by_id(int payment_id) -> errors::Result<models::dto::PaymentResponseDTO>;
+    auto get_all_payments(models::PaymentFilters filters) -> errors::Result<models::dto::PaymentPageDTO>;
+    auto confirm_payments(const std::vector<models::dto::PaymentConfirmationDTO> &confirmations) -> models::dto::PaymentConfirmationSummaryDTO;
 };
 } // namespace lynx::services
\ No newline at end of file
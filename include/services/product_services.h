@@ -1,5 +1,8 @@
 #pragma once
 
+#include "cache/order_details_cache.h"
+#include "errors/result.h"
+#include "inventory/stock_inventory.h"
 #include "models/dtos/dto_product.h"
 #include "repository/interfaces/interface_product.h"
 #include <memory>
@@ -12,20 +15,28 @@ class ProductServices
 {
 private:
     std::shared_ptr<repository::interface::IProductRepository> repository_;
+    std::shared_ptr<cache::OrderDetailsCache> details_cache_; // nome do produto aparece no detalhe dos pedidos
+    std::shared_ptr<inventory::StockInventory> inventory_;
 
-    auto validate_product(const models::Product &product) -> void;
+    auto validate_product(const models::Product &product) -> errors::Result<void>;
 
     auto to_response_dto(const models::Product &product) -> models::dto::ProductResponseDTO;
 
     auto from_create_dto(const models::dto::ProductCreateDTO &dto) -> models::Product;
 
 public:
-    ProductServices(std::shared_ptr<repository::interface::IProductRepository> repository);
+    ProductServices(std::shared_ptr<repository::interface::IProductRepository> repository,
+                    std::shared_ptr<cache::OrderDetailsCache> details_cache = nullptr,
+                    std::shared_ptr<inventory::StockInventory> inventory = nullptr);
 
-    auto create_product(const models::dto::ProductCreateDTO &dto) -> models::dto::ProductResponseDTO;
-    auto get_product_by_id(const int &id) -> models::dto::ProductResponseDTO;
+    /* Validação e produto inexistente voltam como erro no Result */
+    auto create_product(const models::dto::ProductCreateDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>;
+    auto get_product_by_id(const int &id) -> errors::Result<models::dto::ProductResponseDTO>;
     auto get_all_products(const models::ProductFilters &filters = {}) -> std::vector<models::dto::ProductResponseDTO>;
-    auto update_product(int product_id, const models::dto::ProductCreateDTO &dto) -> models::dto::ProductResponseDTO;
+    auto update_product(int product_id, const models::dto::ProductCreateDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>;
+
+    /* Entrada ou baixa manual de estoque; passa pelo StockInventory para os contadores acompanharem o banco */
+    auto adjust_stock(int product_id, const models::dto::StockAdjustmentDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>;
 };
 
 } // namespace lynx::services
\ No newline at end of file
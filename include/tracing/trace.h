@@ -0,0 +1,87 @@
+#pragma once
+
+/*
+ * Spans por requisição (controller -> service -> repositório).
+ *
+ * Com LYNX_TRACING definido (opção LYNX_ENABLE_TRACING do CMake), cada LYNX_TRACE_SPAN grava início e
+ * duração numa pilha por thread; o TracingMiddleware devolve os tempos no header Server-Timing e copia
+ * uma amostra das requisições para um ring buffer exportável no formato trace-event do Chrome.
+ * Sem a definição, LYNX_TRACE_SPAN vira uma expressão vazia e nada disto é compilado.
+ */
+
+#ifdef LYNX_TRACING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lynx::tracing
+{
+
+struct Span
+{
+    const char *name; // sempre um literal: o ponteiro é guardado sem cópia
+    int64_t start_ns;
+    int64_t duration_ns;
+    uint32_t depth;
+    uint32_t thread;
+};
+
+/* Ring buffer global das requisições amostradas */
+class TraceBuffer
+{
+private:
+    TraceBuffer() = default;
+
+    mutable std::mutex mutex_;
+    std::vector<Span> spans_;
+    size_t capacity_ = 65536;
+    size_t next_ = 0;
+    std::atomic<uint32_t> sample_every_{100}; // lido a cada requisição sem travar
+
+public:
+    static auto get_instance() -> TraceBuffer &;
+
+    /* sample_every = 0 desliga a amostragem; o Server-Timing continua */
+    auto configure(size_t capacity, uint32_t sample_every) -> void;
+    auto sample_every() const -> uint32_t;
+
+    auto push(const std::vector<Span> &spans) -> void;
+    auto clear() -> void;
+
+    auto to_chrome_json() const -> std::string;
+};
+
+class ScopedSpan
+{
+private:
+    int64_t index_;
+
+public:
+    explicit ScopedSpan(const char *name);
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan &) = delete;
+    ScopedSpan &operator=(const ScopedSpan &) = delete;
+};
+
+auto now_ns() -> int64_t;
+
+/* Chamados pelo middleware no início e no fim de cada requisição, na thread que a atende */
+auto begin_request() -> void;
+auto end_request() -> std::string; // devolve o valor do header Server-Timing
+
+} // namespace lynx::tracing
+
+#define LYNX_TRACE_CONCAT_(a, b) a##b
+#define LYNX_TRACE_CONCAT(a, b) LYNX_TRACE_CONCAT_(a, b)
+#define LYNX_TRACE_SPAN(name) ::lynx::tracing::ScopedSpan LYNX_TRACE_CONCAT(lynx_trace_span_, __LINE__)(name)
+
+#else
+
+#define LYNX_TRACE_SPAN(name) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "tracing/trace.h"
+
+#ifdef LYNX_TRACING
+
+#include <crow.h>
+
+namespace lynx::tracing
+{
+
+/* Abre a pilha de spans da thread no início da requisição e devolve os tempos em Server-Timing */
+struct TracingMiddleware
+{
+    struct context
+    {
+    };
+
+    void before_handle(crow::request &req, crow::response &res, context &ctx);
+    void after_handle(crow::request &req, crow::response &res, context &ctx);
+};
+
+} // namespace lynx::tracing
+
+#endif
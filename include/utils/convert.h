@@ -5,6 +5,7 @@
 #include "models/product.h"
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace utils
 {
@@ -155,4 +156,34 @@ inline auto payment_method_to_string(lynx::models::PaymentMethod status) -> std:
     }
     throw lynx::exceptions::InternalServerError("Invalid order status enum value");
 }
+
+inline auto confirmation_status_to_string(lynx::models::ConfirmationStatus status) -> std::string
+{
+    switch (status)
+    {
+    case lynx::models::ConfirmationStatus::CONFIRMED:
+        return "CONFIRMED";
+    case lynx::models::ConfirmationStatus::ALREADY_PAID:
+        return "ALREADY_PAID";
+    case lynx::models::ConfirmationStatus::NOT_FOUND:
+        return "NOT_FOUND";
+    case lynx::models::ConfirmationStatus::INVALID:
+        return "INVALID";
+    }
+    throw lynx::exceptions::InternalServerError("Invalid confirmation status enum value");
+}
+
+// Listas de ids são enviadas como um único parâmetro e expandidas com json_each
+inline auto ids_to_json_array(const std::vector<int> &ids) -> std::string
+{
+    std::string json = "[";
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        if (i > 0)
+            json += ',';
+        json += std::to_string(ids[i]);
+    }
+    json += ']';
+    return json;
+}
 } // namespace utils
\ No newline at end of file
@@ -12,6 +12,7 @@ enum class HttpStatus : int
     NOT_FOUND = 404,
     FORBIDDEN = 403,
     CONFLICT = 409,
+    PAYLOAD_TOO_LARGE = 413,
 
     // 5XX
     INTERNAL_SERVER_ERROR = 500,
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/* Leitura dos cabeçalhos de negociação (Accept, Accept-Encoding) e montagem do Vary */
+
+namespace utils::http
+{
+
+/* Tira espaços e tabs das pontas */
+auto trim(std::string_view text) -> std::string_view;
+
+auto equals_ignore_case(std::string_view a, std::string_view b) -> bool;
+
+/* Valor de "q=" nos parâmetros de um item, em milésimos (0..1000); sem o parâmetro vale 1000, malformado vale 0 */
+auto quality_of(std::string_view params) -> int;
+
+/* Vary atual mais field, sem repetir um campo já listado */
+auto merge_vary(std::string_view current, std::string_view field) -> std::string;
+
+} // namespace utils::http
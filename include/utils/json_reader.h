@@ -0,0 +1,219 @@
+#pragma once
+
+#include "utils/json_writer.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Leitor de JSON em passada única que decodifica direto nos DTOs, sem árvore intermediária.
+ *
+ * Os mesmos descritores JsonFields<T> da escrita dizem quais chaves existem e quais são obrigatórias;
+ * chaves desconhecidas são puladas. Qualquer erro vira BadRequestError com o caminho do campo
+ * ("items[3].quantity: expected integer"), e arrays acima de max_array_items viram PayloadTooLargeError.
+ *
+ * Os templates de vetor e de DTO só dependem da interface de leitura (begin_object/next_key,
+ * begin_array/next_item, push/pop do caminho), então servem também ao MsgPackReader.
+ */
+
+namespace utils::json
+{
+
+struct ReaderLimits
+{
+    size_t max_array_items = 1000;
+    size_t max_string_bytes = 16 * 1024;
+    size_t max_depth = 32;
+};
+
+/* Caminho do campo atual e limites, comuns aos leitores de JSON e MessagePack */
+class ReaderBase
+{
+private:
+    struct PathSegment
+    {
+        std::string_view name; // vazio quando o segmento é um índice
+        size_t index;
+    };
+
+    std::vector<PathSegment> path_;
+
+protected:
+    ReaderLimits limits_;
+    size_t depth_ = 0;
+
+    explicit ReaderBase(const ReaderLimits &limits);
+
+    auto enter() -> void; // aplica max_depth ao abrir objeto ou array
+    auto check_item_limit(size_t index) const -> void;
+
+public:
+    [[noreturn]] auto fail(const std::string &message) const -> void;
+    auto path() const -> std::string;
+
+    auto push_key(std::string_view name) -> void;
+    auto push_index(size_t index) -> void;
+    auto pop() -> void;
+};
+
+class JsonReader : public ReaderBase
+{
+private:
+    std::string_view input_;
+    size_t pos_ = 0;
+    bool after_open_ = false; // acabou de abrir um objeto: a próxima chave vem sem vírgula
+    std::string key_scratch_;
+
+    auto skip_whitespace() -> void;
+    auto peek() -> char;
+    auto expect(char c, const char *what) -> void;
+    auto read_string_into(std::string &out) -> void;
+    auto read_hex4() -> uint32_t;
+    auto number_token() -> std::string_view;
+    auto skip_string() -> void;
+
+public:
+    JsonReader(std::string_view input, const ReaderLimits &limits = ReaderLimits());
+
+    auto begin_object() -> void;
+    auto next_key(std::string_view &key) -> bool; // false ao fechar o objeto
+    auto begin_array() -> void;
+    auto next_item(size_t index) -> bool;          // false ao fechar o array; aplica max_array_items
+
+    auto read_int64() -> int64_t;
+    auto read_int() -> int;
+    auto read_bool() -> bool;
+    auto read_string(std::string &out) -> void;
+    auto read_double() -> double;
+    auto read_time_point() -> std::chrono::system_clock::time_point; // string aceita por utils::time::parse_time
+    auto read_null() -> bool; // consome um null; false (sem consumir nada) se o valor é outro
+    auto skip_value() -> void;
+
+    auto finish() -> void; // só espaço em branco depois do valor raiz
+};
+
+inline auto read(JsonReader &reader, int &value) -> void
+{
+    value = reader.read_int();
+}
+
+inline auto read(JsonReader &reader, int64_t &value) -> void
+{
+    value = reader.read_int64();
+}
+
+inline auto read(JsonReader &reader, bool &value) -> void
+{
+    value = reader.read_bool();
+}
+
+inline auto read(JsonReader &reader, double &value) -> void
+{
+    value = reader.read_double();
+}
+
+inline auto read(JsonReader &reader, std::string &value) -> void
+{
+    reader.read_string(value);
+}
+
+inline auto read(JsonReader &reader, std::chrono::system_clock::time_point &value) -> void
+{
+    value = reader.read_time_point();
+}
+
+template <typename Reader, typename T> auto read(Reader &reader, std::optional<T> &value) -> void
+{
+    if (reader.read_null())
+    {
+        value.reset();
+        return;
+    }
+
+    read(reader, value.emplace());
+}
+
+template <typename Reader, typename T> auto read(Reader &reader, std::vector<T> &values) -> void
+{
+    values.clear();
+    reader.begin_array();
+
+    for (size_t index = 0; reader.next_item(index); ++index)
+    {
+        reader.push_index(index);
+        read(reader, values.emplace_back());
+        reader.pop();
+    }
+}
+
+template <typename Reader, Described T> auto read(Reader &reader, T &object) -> void
+{
+    constexpr auto field_count = std::tuple_size_v<std::decay_t<decltype(JsonFields<T>::fields_)>>;
+    static_assert(field_count <= 64, "JsonFields com mais de 64 campos");
+
+    uint64_t seen = 0;
+    reader.begin_object();
+
+    std::string_view key;
+    while (reader.next_key(key))
+    {
+        bool matched = false;
+        size_t index = 0;
+
+        std::apply(
+            [&](const auto &...fields) {
+                const auto try_field = [&](const auto &field) {
+                    if (!matched && key == field.name)
+                    {
+                        matched = true;
+                        reader.push_key(field.name);
+
+                        if (seen & (uint64_t{1} << index))
+                            reader.fail("duplicated field");
+                        seen |= uint64_t{1} << index;
+
+                        read(reader, object.*(field.member));
+                        reader.pop();
+                    }
+                    ++index;
+                };
+                (try_field(fields), ...);
+            },
+            JsonFields<T>::fields_);
+
+        if (!matched)
+            reader.skip_value();
+    }
+
+    size_t index = 0;
+    std::apply(
+        [&](const auto &...fields) {
+            const auto check_field = [&](const auto &field) {
+                if (field.required && !(seen & (uint64_t{1} << index)))
+                {
+                    reader.push_key(field.name);
+                    reader.fail("required field is missing");
+                }
+                ++index;
+            };
+            (check_field(fields), ...);
+        },
+        JsonFields<T>::fields_);
+}
+
+/* Lê o corpo inteiro como T; lança BadRequestError (ou PayloadTooLargeError) no primeiro erro */
+template <Described T> auto parse(std::string_view body, const ReaderLimits &limits = ReaderLimits()) -> T
+{
+    JsonReader reader(body, limits);
+
+    T value{};
+    read(reader, value);
+    reader.finish();
+
+    return value;
+}
+
+} // namespace utils::json
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/*
+ * Escritor de JSON só para frente: cada valor é anexado direto num buffer, sem montar árvore.
+ *
+ * Os DTOs descrevem seus campos em tempo de compilação especializando JsonFields<T> (ver
+ * models/dtos/dto_json.h); write(writer, dto) percorre a tupla de campos e escreve cada membro pelo
+ * overload de write do tipo dele. Tipos novos entram com um overload de write no namespace utils::json.
+ */
+
+namespace utils::json
+{
+
+class JsonWriter
+{
+private:
+    std::string out_;
+
+    auto separate() -> void;
+
+public:
+    explicit JsonWriter(size_t reserve_bytes = 0);
+
+    auto begin_object() -> JsonWriter &;
+    auto end_object() -> JsonWriter &;
+    auto begin_array() -> JsonWriter &;
+    auto end_array() -> JsonWriter &;
+
+    /* Chave literal de campo: escrita sem escape */
+    auto key(std::string_view name) -> JsonWriter &;
+
+    auto value(int64_t number) -> JsonWriter &;
+    auto value(double number) -> JsonWriter &; // não finito: null
+    auto value(bool flag) -> JsonWriter &;
+    auto value(std::string_view text) -> JsonWriter &;
+    auto null() -> JsonWriter &;
+
+    /* ISO 8601 em UTC, "YYYY-MM-DDTHH:MM:SSZ" (utils::time::format_time) */
+    auto value(const std::chrono::system_clock::time_point &tp) -> JsonWriter &;
+
+    auto buffer() const -> const std::string &;
+    auto take() -> std::string; // move o buffer para fora; o escritor fica vazio
+    auto clear() -> void;       // esvazia mantendo a capacidade, para reaproveitar o buffer
+};
+
+enum class Presence
+{
+    required,
+    optional // ausente na leitura: o membro fica com o valor padrão do DTO
+};
+
+template <typename Class, typename Member> struct Field
+{
+    std::string_view name;
+    Member Class::*member;
+    bool required;
+};
+
+template <typename Class, typename Member>
+constexpr auto field(std::string_view name, Member Class::*member, Presence presence = Presence::required) -> Field<Class, Member>
+{
+    return Field<Class, Member>{name, member, presence == Presence::required};
+}
+
+/* Especializar com `static constexpr auto fields_ = std::make_tuple(field("id", &T::id), ...);`; a leitura usa o mesmo descritor */
+template <typename T> struct JsonFields;
+
+template <typename T>
+concept Described = requires { JsonFields<T>::fields_; };
+
+inline auto write(JsonWriter &writer, int number) -> void
+{
+    writer.value(static_cast<int64_t>(number));
+}
+
+inline auto write(JsonWriter &writer, int64_t number) -> void
+{
+    writer.value(number);
+}
+
+inline auto write(JsonWriter &writer, double number) -> void
+{
+    writer.value(number);
+}
+
+inline auto write(JsonWriter &writer, bool flag) -> void
+{
+    writer.value(flag);
+}
+
+inline auto write(JsonWriter &writer, const std::string &text) -> void
+{
+    writer.value(std::string_view(text));
+}
+
+inline auto write(JsonWriter &writer, const std::chrono::system_clock::time_point &tp) -> void
+{
+    writer.value(tp);
+}
+
+template <typename T> auto write(JsonWriter &writer, const std::optional<T> &value) -> void
+{
+    if (value.has_value())
+        write(writer, *value);
+    else
+        writer.null();
+}
+
+template <typename T> auto write(JsonWriter &writer, const std::vector<T> &values) -> void
+{
+    writer.begin_array();
+    for (const auto &value : values)
+    {
+        write(writer, value);
+    }
+    writer.end_array();
+}
+
+template <Described T> auto write(JsonWriter &writer, const T &object) -> void
+{
+    writer.begin_object();
+    std::apply(
+        [&](const auto &...fields) {
+            ((writer.key(fields.name), write(writer, object.*(fields.member))), ...);
+        },
+        JsonFields<T>::fields_);
+    writer.end_object();
+}
+
+} // namespace utils::json
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "utils/json_reader.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Leitor de MessagePack com a mesma interface do JsonReader, para que os templates de leitura de
+ * utils::json (vetores e DTOs descritos por JsonFields<T>) decodifiquem corpos binários sem mudar.
+ * Erros e limites são os mesmos: BadRequestError com o caminho do campo, PayloadTooLargeError
+ * acima de max_array_items. Chaves de map precisam ser strings.
+ */
+
+namespace utils::msgpack
+{
+
+class MsgPackReader : public json::ReaderBase
+{
+private:
+    std::string_view input_;
+    size_t pos_ = 0;
+    std::vector<uint32_t> remaining_; // entradas ainda não lidas de cada map/array aberto
+
+    auto byte() -> uint8_t;
+    auto big_endian(int bytes) -> uint64_t;
+    auto bytes(size_t size) -> std::string_view;
+    auto container_size(uint8_t head, uint8_t fix_mask, uint8_t size16, uint8_t size32, const char *what) -> uint32_t;
+    auto string_view_of(const char *what) -> std::string_view;
+
+public:
+    MsgPackReader(std::string_view input, const json::ReaderLimits &limits = json::ReaderLimits());
+
+    auto begin_object() -> void;
+    auto next_key(std::string_view &key) -> bool; // false depois da última entrada do map
+    auto begin_array() -> void;
+    auto next_item(size_t index) -> bool;          // false depois do último item; aplica max_array_items
+
+    auto read_int64() -> int64_t;
+    auto read_int() -> int;
+    auto read_bool() -> bool;
+    auto read_string(std::string &out) -> void;
+    auto read_double() -> double;
+    auto read_time_point() -> std::chrono::system_clock::time_point;
+    auto read_null() -> bool; // consome um nil; false (sem consumir nada) se o valor é outro
+    auto skip_value() -> void;
+
+    auto finish() -> void; // nada depois do valor raiz
+};
+
+inline auto read(MsgPackReader &reader, int &value) -> void
+{
+    value = reader.read_int();
+}
+
+inline auto read(MsgPackReader &reader, int64_t &value) -> void
+{
+    value = reader.read_int64();
+}
+
+inline auto read(MsgPackReader &reader, bool &value) -> void
+{
+    value = reader.read_bool();
+}
+
+inline auto read(MsgPackReader &reader, double &value) -> void
+{
+    value = reader.read_double();
+}
+
+inline auto read(MsgPackReader &reader, std::string &value) -> void
+{
+    reader.read_string(value);
+}
+
+inline auto read(MsgPackReader &reader, std::chrono::system_clock::time_point &value) -> void
+{
+    value = reader.read_time_point();
+}
+
+/* Lê o corpo inteiro como T pelos templates de utils::json; lança BadRequestError (ou PayloadTooLargeError) no primeiro erro */
+template <json::Described T> auto parse(std::string_view body, const json::ReaderLimits &limits = json::ReaderLimits()) -> T
+{
+    MsgPackReader reader(body, limits);
+
+    T value{};
+    json::read(reader, value);
+    reader.finish();
+
+    return value;
+}
+
+} // namespace utils::msgpack
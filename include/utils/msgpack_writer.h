@@ -0,0 +1,109 @@
+#pragma once
+
+#include "utils/json_writer.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/*
+ * Escritor de MessagePack só para frente, par do JsonWriter: mesmos descritores JsonFields<T>, cada
+ * valor anexado direto no buffer da resposta. Inteiros saem na menor codificação que os comporta e
+ * horários como extensão timestamp (tipo -1), em vez do texto "YYYY-mm-dd HH:MM:SS" do JSON.
+ */
+
+namespace utils::msgpack
+{
+
+class MsgPackWriter
+{
+private:
+    std::string out_;
+
+    auto put_byte(uint8_t byte) -> void;
+    auto put_big_endian(uint64_t value, int bytes) -> void;
+    auto put_header(uint8_t head, uint64_t value, int bytes) -> void;
+
+public:
+    explicit MsgPackWriter(size_t reserve_bytes = 0);
+
+    /* Map e array do MessagePack levam a contagem no cabeçalho */
+    auto begin_map(uint32_t size) -> MsgPackWriter &;
+    auto begin_array(uint32_t size) -> MsgPackWriter &;
+
+    auto key(std::string_view name) -> MsgPackWriter &;
+
+    auto value(int64_t number) -> MsgPackWriter &;
+    auto value(double number) -> MsgPackWriter &;
+    auto value(bool flag) -> MsgPackWriter &;
+    auto value(std::string_view text) -> MsgPackWriter &;
+    auto value(const char *text) -> MsgPackWriter &; // sem ele, literal viraria bool
+    auto value(const std::chrono::system_clock::time_point &tp) -> MsgPackWriter &;
+    auto null() -> MsgPackWriter &;
+
+    auto buffer() const -> const std::string &;
+    auto take() -> std::string; // move o buffer para fora; o escritor fica vazio
+    auto clear() -> void;
+};
+
+inline auto write(MsgPackWriter &writer, int number) -> void
+{
+    writer.value(static_cast<int64_t>(number));
+}
+
+inline auto write(MsgPackWriter &writer, int64_t number) -> void
+{
+    writer.value(number);
+}
+
+inline auto write(MsgPackWriter &writer, double number) -> void
+{
+    writer.value(number);
+}
+
+inline auto write(MsgPackWriter &writer, bool flag) -> void
+{
+    writer.value(flag);
+}
+
+inline auto write(MsgPackWriter &writer, const std::string &text) -> void
+{
+    writer.value(std::string_view(text));
+}
+
+inline auto write(MsgPackWriter &writer, const std::chrono::system_clock::time_point &tp) -> void
+{
+    writer.value(tp);
+}
+
+template <typename T> auto write(MsgPackWriter &writer, const std::optional<T> &value) -> void
+{
+    if (value.has_value())
+        write(writer, *value);
+    else
+        writer.null();
+}
+
+template <typename T> auto write(MsgPackWriter &writer, const std::vector<T> &values) -> void
+{
+    writer.begin_array(static_cast<uint32_t>(values.size()));
+    for (const auto &value : values)
+    {
+        write(writer, value);
+    }
+}
+
+template <json::Described T> auto write(MsgPackWriter &writer, const T &object) -> void
+{
+    writer.begin_map(static_cast<uint32_t>(std::tuple_size_v<std::decay_t<decltype(json::JsonFields<T>::fields_)>>));
+    std::apply(
+        [&](const auto &...fields) {
+            ((writer.key(fields.name), write(writer, object.*(fields.member))), ...);
+        },
+        json::JsonFields<T>::fields_);
+}
+
+} // namespace utils::msgpack
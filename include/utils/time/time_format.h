@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+ * Formatação e leitura de horários sempre em UTC, sem fuso local (localtime_r pega a trava de fuso
+ * da glibc) e sem stream: os dígitos são escritos direto no buffer de quem chama.
+ */
+
+namespace utils::time
+{
+
+enum class TimeFormat
+{
+    sql,           // "YYYY-MM-DD HH:MM:SS", o formato de datetime() do SQLite; ordena como texto
+    iso8601,       // "YYYY-MM-DDTHH:MM:SSZ" (também RFC 3339)
+    iso8601_millis // "YYYY-MM-DDTHH:MM:SS.mmmZ"
+};
+
+inline constexpr size_t max_time_length_ = 24;
+
+/* Escreve em out (ao menos max_time_length_ bytes) e devolve quantos bytes usou */
+auto format_time(const std::chrono::system_clock::time_point &tp, TimeFormat format, char *out) -> size_t;
+auto format_time(const std::chrono::system_clock::time_point &tp, TimeFormat format) -> std::string;
+
+/*
+ * "YYYY-MM-DD HH:MM:SS" ou com 'T', fração opcional (até nanossegundos) e fuso opcional ("Z" ou
+ * "±HH:MM"); sem fuso o horário é UTC. Devolve false para qualquer coisa fora disso.
+ */
+auto parse_time(std::string_view text, std::chrono::system_clock::time_point &out) -> bool;
+
+/* Para valores lidos do banco: texto inválido é dado corrompido e vira InternalServerError */
+auto parse_time_or_throw(std::string_view text) -> std::chrono::system_clock::time_point;
+
+} // namespace utils::time
@@ -0,0 +1,83 @@
+#include "admission/admission_control.h"
+#include "metrics/metrics_registry.h"
+
+#include <array>
+
+namespace lynx::admission
+{
+
+namespace
+{
+
+constexpr std::array<std::string_view, 3> priority_names_ = {"low", "normal", "critical"};
+
+auto starts_with_segment(std::string_view url, std::string_view prefix) -> bool
+{
+    return url.starts_with(prefix) && (url.size() == prefix.size() || url[prefix.size()] == '/' || url[prefix.size()] == '?');
+}
+
+} // namespace
+
+AdmissionControl::AdmissionControl(const AdmissionConfig &config)
+    : config_(config), read_(config.read), write_(config.write)
+{
+}
+
+auto AdmissionControl::limiter_for(std::string_view method, std::string_view url) -> ConcurrencyLimiter *
+{
+    if (starts_with_segment(url, "/metrics"))
+        return nullptr;
+
+    return method == "GET" || method == "HEAD" ? &read_ : &write_;
+}
+
+// Pagamentos são descartados por último; relatórios e admin, que varrem tabelas, primeiro
+auto AdmissionControl::priority_for(std::string_view url) -> Priority
+{
+    if (starts_with_segment(url, "/api/payments"))
+        return Priority::critical;
+
+    if (starts_with_segment(url, "/api/orders/summary") || starts_with_segment(url, "/api/admin"))
+        return Priority::low;
+
+    return Priority::normal;
+}
+
+auto AdmissionControl::retry_after() const -> std::chrono::seconds
+{
+    return config_.retry_after;
+}
+
+auto AdmissionControl::render(std::string &out) const -> void
+{
+    const std::array<std::pair<std::string_view, LimiterStats>, 2> pools = {{{"read", read_.stats()}, {"write", write_.stats()}}};
+
+    metrics::write_header(out, "lynx_admission_limit", "gauge", "Limite de concorrência adaptativo por pool.");
+    for (const auto &[pool, stats] : pools)
+        metrics::write_sample(out, "lynx_admission_limit", "pool=\"" + std::string(pool) + "\"", stats.limit);
+
+    metrics::write_header(out, "lynx_admission_in_flight", "gauge", "Requisições admitidas ainda em andamento por pool.");
+    for (const auto &[pool, stats] : pools)
+        metrics::write_sample(out, "lynx_admission_in_flight", "pool=\"" + std::string(pool) + "\"", stats.in_flight);
+
+    metrics::write_header(out, "lynx_admission_rtt_microseconds", "gauge", "Média curta da latência das requisições admitidas.");
+    for (const auto &[pool, stats] : pools)
+        metrics::write_sample(out, "lynx_admission_rtt_microseconds", "pool=\"" + std::string(pool) + "\"", stats.rtt_micros);
+
+    metrics::write_header(out, "lynx_admission_baseline_rtt_microseconds", "gauge", "Menor latência recente, referência sem fila do limitador.");
+    for (const auto &[pool, stats] : pools)
+        metrics::write_sample(out, "lynx_admission_baseline_rtt_microseconds", "pool=\"" + std::string(pool) + "\"", stats.baseline_rtt_micros);
+
+    metrics::write_header(out, "lynx_admission_requests_total", "counter", "Decisões de admissão por pool, prioridade e resultado.");
+    for (const auto &[pool, stats] : pools)
+    {
+        for (size_t i = 0; i < priority_names_.size(); ++i)
+        {
+            const auto labels = "pool=\"" + std::string(pool) + "\",priority=\"" + std::string(priority_names_[i]) + "\"";
+            metrics::write_sample(out, "lynx_admission_requests_total", labels + ",result=\"admitted\"", static_cast<int64_t>(stats.admitted[i]));
+            metrics::write_sample(out, "lynx_admission_requests_total", labels + ",result=\"rejected\"", static_cast<int64_t>(stats.rejected[i]));
+        }
+    }
+}
+
+} // namespace lynx::admission
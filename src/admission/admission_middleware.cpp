@@ -0,0 +1,46 @@
+#include "admission/admission_middleware.h"
+#include "errors/result.h"
+
+namespace lynx::admission
+{
+
+auto AdmissionMiddleware::set_control(std::shared_ptr<AdmissionControl> control) -> void
+{
+    control_ = control;
+}
+
+void AdmissionMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!control_)
+        return;
+
+    auto *limiter = control_->limiter_for(crow::method_name(req.method), req.url);
+    if (limiter == nullptr)
+        return;
+
+    if (!limiter->try_acquire(AdmissionControl::priority_for(req.url), ctx.in_flight))
+    {
+        const errors::Error error(HttpStatus::SERVICE_UNAVAILABLE, "Service Unavailable", "Server overloaded, retry later");
+
+        res.code = static_cast<int>(error.status_code());
+        res.body = error.to_json();
+        res.set_header("Content-Type", "application/json");
+        res.set_header("Retry-After", std::to_string(control_->retry_after().count()));
+        res.end();
+        return;
+    }
+
+    ctx.limiter = limiter;
+    ctx.started_at = std::chrono::steady_clock::now();
+}
+
+void AdmissionMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (ctx.limiter == nullptr)
+        return;
+
+    ctx.limiter->release(std::chrono::steady_clock::now() - ctx.started_at, ctx.in_flight);
+    ctx.limiter = nullptr;
+}
+
+} // namespace lynx::admission
@@ -0,0 +1,110 @@
+#include "admission/concurrency_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lynx::admission
+{
+
+ConcurrencyLimiter::ConcurrencyLimiter(const LimiterConfig &config)
+    : config_(config), limit_(static_cast<int64_t>(config.initial_limit)), estimated_limit_(config.initial_limit)
+{
+}
+
+auto ConcurrencyLimiter::allowed_for(Priority priority) const -> int64_t
+{
+    const auto limit = limit_.load(std::memory_order_relaxed);
+
+    switch (priority)
+    {
+    case Priority::low:
+        return std::max<int64_t>(1, static_cast<int64_t>(limit * config_.low_share));
+    case Priority::normal:
+        return std::max<int64_t>(1, static_cast<int64_t>(limit * config_.normal_share));
+    default:
+        return limit;
+    }
+}
+
+auto ConcurrencyLimiter::try_acquire(Priority priority, int64_t &in_flight) -> bool
+{
+    const auto allowed = allowed_for(priority);
+    const auto slot = static_cast<size_t>(priority);
+
+    auto current = in_flight_.load(std::memory_order_relaxed);
+    while (current < allowed)
+    {
+        if (in_flight_.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            in_flight = current + 1;
+            admitted_[slot].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    rejected_[slot].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+auto ConcurrencyLimiter::release(std::chrono::nanoseconds latency, int64_t in_flight) -> void
+{
+    in_flight_.fetch_sub(1, std::memory_order_release);
+
+    std::unique_lock lock(update_mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    const auto rtt = std::max(1.0, std::chrono::duration<double, std::micro>(latency).count());
+
+    // Média curta: aritmética no aquecimento, exponencial depois
+    samples_ += 1;
+    const auto short_samples = std::min(samples_, config_.short_window);
+    rtt_micros_ += (rtt - rtt_micros_) / static_cast<double>(short_samples);
+
+    // Mínimo por janela; a referência é o menor entre a janela atual e a anterior
+    if (window_min_micros_ == 0 || rtt < window_min_micros_)
+        window_min_micros_ = rtt;
+
+    if (samples_ % config_.baseline_window == 0)
+    {
+        previous_min_micros_ = window_min_micros_;
+        window_min_micros_ = 0;
+    }
+
+    const auto baseline = previous_min_micros_ == 0 ? window_min_micros_
+                          : window_min_micros_ == 0 ? previous_min_micros_
+                                                    : std::min(previous_min_micros_, window_min_micros_);
+
+    // Com menos da metade do limite em uso a latência não diz nada sobre a capacidade
+    if (static_cast<double>(in_flight) < estimated_limit_ / 2.0)
+        return;
+
+    const auto gradient = std::clamp(config_.tolerance * baseline / rtt_micros_, 0.5, 1.0);
+    const auto queue_size = std::sqrt(estimated_limit_);
+
+    auto next = estimated_limit_ * gradient + queue_size;
+    next = estimated_limit_ * (1.0 - config_.smoothing) + next * config_.smoothing;
+
+    estimated_limit_ = std::clamp(next, config_.min_limit, config_.max_limit);
+    limit_.store(static_cast<int64_t>(estimated_limit_), std::memory_order_relaxed);
+}
+
+auto ConcurrencyLimiter::stats() const -> LimiterStats
+{
+    LimiterStats stats;
+    stats.limit = limit_.load(std::memory_order_relaxed);
+    stats.in_flight = in_flight_.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < stats.admitted.size(); ++i)
+    {
+        stats.admitted[i] = admitted_[i].load(std::memory_order_relaxed);
+        stats.rejected[i] = rejected_[i].load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard lock(update_mutex_);
+    stats.baseline_rtt_micros = previous_min_micros_ == 0 ? window_min_micros_ : previous_min_micros_;
+    stats.rtt_micros = rtt_micros_;
+    return stats;
+}
+
+} // namespace lynx::admission
@@ -0,0 +1,350 @@
+#include "application.h"
+
+/* Controllers */
+#include "controllers/admin_controller.h"
+#include "controllers/customer_controller.h"
+#include "controllers/metrics_controller.h"
+#include "controllers/order_controller.h"
+#include "controllers/payment_controller.h"
+#include "controllers/product_controller.h"
+
+// Repositories
+#include "repository/customer_repository.h"
+#include "repository/inventory_repository.h"
+#include "repository/order_repository.h"
+#include "repository/payment_repository.h"
+#include "repository/product_repository.h"
+
+#include "repository/decorators/repository_cache.h"
+#include "repository/decorators/repository_coalescing.h"
+#include "repository/decorators/repository_decorators.h"
+#include "repository/decorators/repository_instrumentation.h"
+
+// Ledger
+#include "ledger/order_ledger.h"
+
+// Respostas pré-serializadas
+#include "cache/product_fragment_store.h"
+
+// Inventory
+#include "inventory/stock_inventory.h"
+
+// Metrics
+#include "database/SQLite_database.h"
+#include "database/migrations.h"
+#include "database/query_cache.h"
+#include "database/query_profiler.h"
+#include "metrics/metrics_registry.h"
+#include "tracing/trace.h"
+
+// Services
+#include "services/customer_services.h"
+#include "services/order_expiry_services.h"
+#include "services/order_services.h"
+#include "services/payment_services.h"
+#include "services/product_services.h"
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace lynx::app
+{
+
+Application::Application(const ApplicationConfig &config)
+    : server_(std::make_unique<server::Server>(config.server))
+{
+    // Bancos de versões anteriores: datas em hora local viram UTC, antes de qualquer leitura
+    database::apply_migrations(database::SQLiteDatabase::get_instance().get_connection());
+
+    auto metrics_registry = std::make_shared<metrics::MetricsRegistry>();
+    server_->set_metrics(metrics_registry);
+
+    // Limites de concorrência adaptativos (leitura/escrita); sem vaga a requisição recebe 503 com Retry-After
+    auto admission_control = std::make_shared<admission::AdmissionControl>(config.admission);
+    server_->set_admission(admission_control);
+
+    // Tempo, linhas e contadores por SQL; execuções acima do limite são logadas com o EXPLAIN QUERY PLAN
+    query_profiler_ = std::make_shared<database::QueryProfiler>(config.profiler);
+    query_profiler_->attach(database::SQLiteDatabase::get_instance().get_connection());
+
+    // Amostra do tráfego real em NDJSON, para o lynx_replay reproduzir contra uma instância de teste
+    traffic_recorder_ = std::make_shared<capture::TrafficRecorder>(config.capture);
+    if (config.capture.enabled)
+        server_->set_capture(traffic_recorder_);
+
+#ifdef LYNX_TRACING
+    // Toda requisição recebe Server-Timing; 1 em cada 100 (por thread) vai para o ring buffer de /api/admin/trace
+    tracing::TraceBuffer::get_instance().configure(65536, 100);
+#endif
+
+    // ======================
+    // Repositories
+    // ======================
+    // Cada repositório SQLite é envolvido por um decorator que mede chamadas, linhas, exceções e latência por método
+    using repository::decorators::RepositoryInstrumentation;
+
+    auto customer_instrumentation = std::make_shared<RepositoryInstrumentation>("customer", repository::decorators::CustomerMethods::names_);
+    auto product_instrumentation = std::make_shared<RepositoryInstrumentation>("product", repository::decorators::ProductMethods::names_);
+    auto order_instrumentation = std::make_shared<RepositoryInstrumentation>("order", repository::decorators::OrderMethods::names_);
+    auto payment_instrumentation = std::make_shared<RepositoryInstrumentation>("payment", repository::decorators::PaymentMethods::names_);
+    auto inventory_instrumentation =
+        std::make_shared<RepositoryInstrumentation>("inventory", repository::decorators::InventoryMethods::names_);
+
+    std::shared_ptr<repository::interface::ICustomerRepository> customer_repository =
+        std::make_shared<repository::decorators::CustomerRepositoryDecorator<RepositoryInstrumentation>>(
+            std::make_shared<repository::CustomerRepository>(), customer_instrumentation);
+    std::shared_ptr<repository::interface::IProductRepository> product_repository =
+        std::make_shared<repository::decorators::ProductRepositoryDecorator<RepositoryInstrumentation>>(
+            std::make_shared<repository::ProductRepository>(), product_instrumentation);
+    std::shared_ptr<repository::interface::IOrderRepository> order_repository =
+        std::make_shared<repository::decorators::OrderRepositoryDecorator<RepositoryInstrumentation>>(
+            std::make_shared<repository::OrderRepository>(), order_instrumentation);
+    std::shared_ptr<repository::interface::IPaymentRepository> payment_repository =
+        std::make_shared<repository::decorators::PaymentRepositoryDecorator<RepositoryInstrumentation>>(
+            std::make_shared<repository::PaymentRepository>(), payment_instrumentation);
+    std::shared_ptr<repository::interface::IInventoryRepository> inventory_repository =
+        std::make_shared<repository::decorators::InventoryRepositoryDecorator<RepositoryInstrumentation>>(
+            std::make_shared<repository::InventoryRepository>(), inventory_instrumentation);
+
+    // Versões por tabela (update/rollback hook): invalidam o cache de leituras e limitam o single-flight
+    query_cache_ = std::make_shared<database::QueryCache>(config.query_cache);
+    query_cache_->attach(database::SQLiteDatabase::get_instance().get_connection());
+
+    using database::Table;
+    using database::table_bit;
+
+    constexpr auto product_tables = table_bit(Table::products);
+    constexpr auto order_summary_tables = table_bit(Table::orders) | table_bit(Table::order_items) | table_bit(Table::payments);
+
+    // Single-flight entre a instrumentação e o cache: leituras idênticas simultâneas viram uma consulta
+    std::vector<std::shared_ptr<repository::decorators::RepositoryCoalescing>> repository_coalescings;
+
+    if (config.coalescing.enabled)
+    {
+        using repository::decorators::OrderMethods;
+        using repository::decorators::ProductMethods;
+        using repository::decorators::RepositoryCoalescing;
+
+        if (config.coalescing.products)
+        {
+            auto product_coalescing = std::make_shared<RepositoryCoalescing>("product", ProductMethods::names_, query_cache_);
+            product_coalescing->coalesce_method(ProductMethods::find_product_by_id, product_tables)
+                .coalesce_method(ProductMethods::find_all, product_tables);
+
+            product_repository =
+                std::make_shared<repository::decorators::ProductRepositoryDecorator<RepositoryCoalescing>>(product_repository, product_coalescing);
+            repository_coalescings.push_back(product_coalescing);
+        }
+
+        if (config.coalescing.orders_summary)
+        {
+            auto order_coalescing = std::make_shared<RepositoryCoalescing>("order", OrderMethods::names_, query_cache_);
+            order_coalescing->coalesce_method(OrderMethods::find_all_summary, order_summary_tables);
+
+            order_repository =
+                std::make_shared<repository::decorators::OrderRepositoryDecorator<RepositoryCoalescing>>(order_repository, order_coalescing);
+            repository_coalescings.push_back(order_coalescing);
+        }
+    }
+
+    // Cache de leituras por cima de tudo: os hits não chegam ao SQLite nem às métricas por método.
+    // Cada método cacheado declara as tabelas que lê; qualquer linha escrita nelas invalida o resultado
+    std::vector<std::shared_ptr<repository::decorators::RepositoryCache>> repository_caches;
+
+    if (config.query_cache.enabled)
+    {
+        using repository::decorators::CustomerMethods;
+        using repository::decorators::OrderMethods;
+        using repository::decorators::PaymentMethods;
+        using repository::decorators::ProductMethods;
+        using repository::decorators::RepositoryCache;
+
+        auto customer_cache = std::make_shared<RepositoryCache>("customer", CustomerMethods::names_, query_cache_);
+        customer_cache->cache_method(CustomerMethods::find_by_id, table_bit(Table::customers))
+            .cache_method(CustomerMethods::find_by_email, table_bit(Table::customers));
+
+        auto product_cache = std::make_shared<RepositoryCache>("product", ProductMethods::names_, query_cache_);
+        product_cache->cache_method(ProductMethods::find_product_by_id, product_tables).cache_method(ProductMethods::find_all, product_tables);
+
+        auto order_cache = std::make_shared<RepositoryCache>("order", OrderMethods::names_, query_cache_);
+        order_cache->cache_method(OrderMethods::find_by_id, table_bit(Table::orders) | table_bit(Table::order_items))
+            .cache_method(OrderMethods::find_by_id_with_customer, table_bit(Table::orders) | table_bit(Table::customers))
+            .cache_method(OrderMethods::find_items_by_order_id, table_bit(Table::order_items))
+            .cache_method(OrderMethods::sum_items_total_by_order, table_bit(Table::order_items))
+            .cache_method(OrderMethods::find_all_summary, order_summary_tables);
+
+        auto payment_cache = std::make_shared<RepositoryCache>("payment", PaymentMethods::names_, query_cache_);
+        payment_cache->cache_method(PaymentMethods::find_by_id, table_bit(Table::payments))
+            .cache_method(PaymentMethods::find_all, table_bit(Table::payments))
+            .cache_method(PaymentMethods::sum_by_order, table_bit(Table::payments));
+
+        customer_repository =
+            std::make_shared<repository::decorators::CustomerRepositoryDecorator<RepositoryCache>>(customer_repository, customer_cache);
+        product_repository = std::make_shared<repository::decorators::ProductRepositoryDecorator<RepositoryCache>>(product_repository, product_cache);
+        order_repository = std::make_shared<repository::decorators::OrderRepositoryDecorator<RepositoryCache>>(order_repository, order_cache);
+        payment_repository = std::make_shared<repository::decorators::PaymentRepositoryDecorator<RepositoryCache>>(payment_repository, payment_cache);
+
+        repository_caches = {customer_cache, product_cache, order_cache, payment_cache};
+    }
+
+    // ======================
+    // Corpos prontos de GET /api/orders/<id> para pedidos encerrados
+    // ======================
+    auto order_details_cache = std::make_shared<cache::OrderDetailsCache>(config.order_details_cache);
+
+    // JSON de cada produto pronto para as respostas de /api/products
+    auto product_fragments = std::make_shared<cache::ProductFragmentStore>(config.product_fragments);
+
+    // ======================
+    // Ledger (saldo dos pedidos em memória)
+    // ======================
+    auto order_ledger = std::make_shared<ledger::OrderLedger>(order_repository, payment_repository);
+
+    // ======================
+    // Estoque (reservas em memória, write-back em lote)
+    // ======================
+    stock_inventory_ = std::make_shared<inventory::StockInventory>(inventory_repository, config.inventory);
+
+    // ======================
+    // Expiração de pedidos não pagos
+    // ======================
+    order_expiry_service_ = std::make_shared<services::OrderExpiryServices>(order_repository, order_ledger, stock_inventory_, order_details_cache,
+                                                                           config.expiry);
+
+    // ======================
+    // Services
+    // ======================
+    auto customer_service = std::make_shared<services::CustomerServices>(customer_repository);
+    auto product_service = std::make_shared<services::ProductServices>(product_repository, order_details_cache, stock_inventory_);
+    auto order_service = std::make_shared<services::OrderServices>(order_repository, product_repository, customer_repository, order_ledger,
+                                                                 order_expiry_service_, stock_inventory_, order_details_cache);
+    auto payment_service = std::make_shared<services::PaymentServices>(payment_repository, order_service, order_ledger);
+
+    // ======================
+    // Gauges (lidos a cada scrape de /metrics)
+    // ======================
+    metrics_registry->add_collector([](std::string &out) {
+        const auto stats = database::SQLiteDatabase::get_instance().stats();
+
+        metrics::write_header(out, "lynx_sqlite_memory_used_bytes", "gauge", "Memória alocada pelo SQLite.");
+        metrics::write_sample(out, "lynx_sqlite_memory_used_bytes", "", stats.memory_used_bytes);
+        metrics::write_header(out, "lynx_sqlite_cache_used_bytes", "gauge", "Memória do page cache da conexão.");
+        metrics::write_sample(out, "lynx_sqlite_cache_used_bytes", "", stats.cache_used_bytes);
+        metrics::write_header(out, "lynx_sqlite_cache_hits", "gauge", "Acertos do page cache da conexão.");
+        metrics::write_sample(out, "lynx_sqlite_cache_hits", "", stats.cache_hits);
+        metrics::write_header(out, "lynx_sqlite_cache_misses", "gauge", "Faltas do page cache da conexão.");
+        metrics::write_sample(out, "lynx_sqlite_cache_misses", "", stats.cache_misses);
+    });
+
+    metrics_registry->add_collector([order_ledger, order_expiry_service = order_expiry_service_](std::string &out) {
+        const auto stats = order_ledger->stats();
+
+        metrics::write_header(out, "lynx_ledger_entries", "gauge", "Pedidos em aberto no ledger em memória.");
+        metrics::write_sample(out, "lynx_ledger_entries", "", static_cast<int64_t>(stats.entries));
+        metrics::write_header(out, "lynx_ledger_lookups_total", "counter", "Consultas ao ledger por resultado.");
+        metrics::write_sample(out, "lynx_ledger_lookups_total", "result=\"hit\"", static_cast<int64_t>(stats.hits));
+        metrics::write_sample(out, "lynx_ledger_lookups_total", "result=\"miss\"", static_cast<int64_t>(stats.misses));
+        metrics::write_header(out, "lynx_order_expiry_pending", "gauge", "Pedidos aguardando o prazo de pagamento.");
+        metrics::write_sample(out, "lynx_order_expiry_pending", "", static_cast<int64_t>(order_expiry_service->pending()));
+    });
+
+    metrics_registry->add_collector([admission_control](std::string &out) { admission_control->render(out); });
+
+    if (config.capture.enabled)
+        metrics_registry->add_collector([traffic_recorder = traffic_recorder_](std::string &out) { traffic_recorder->render(out); });
+
+    metrics_registry->add_collector([instrumentations = std::vector{customer_instrumentation, product_instrumentation,
+                                                                    order_instrumentation, payment_instrumentation,
+                                                                    inventory_instrumentation}](std::string &out) {
+        RepositoryInstrumentation::render(out, instrumentations);
+    });
+
+    if (config.order_details_cache.enabled)
+        metrics_registry->add_collector([order_details_cache](std::string &out) { order_details_cache->render(out); });
+
+    metrics_registry->add_collector([product_fragments](std::string &out) { product_fragments->render(out); });
+
+    if (!repository_coalescings.empty())
+    {
+        metrics_registry->add_collector([repository_coalescings](std::string &out) {
+            repository::decorators::RepositoryCoalescing::render(out, repository_coalescings);
+        });
+    }
+
+    if (config.query_cache.enabled)
+    {
+        metrics_registry->add_collector([query_cache = query_cache_, repository_caches](std::string &out) {
+            repository::decorators::RepositoryCache::render(out, repository_caches);
+            query_cache->render(out);
+        });
+    }
+
+    // ======================
+    // Controllers (Handlers)
+    // ======================
+    server_->add_handler(std::make_shared<controller::CustomerController>(customer_service));
+
+    server_->add_handler(std::make_shared<controller::ProductController>(product_service, product_fragments));
+
+    server_->add_handler(std::make_shared<controller::OrderController>(order_service, order_details_cache));
+
+    server_->add_handler(std::make_shared<controller::PaymentController>(payment_service));
+
+    server_->add_handler(std::make_shared<controller::AdminController>(order_ledger, query_profiler_));
+
+    server_->add_handler(std::make_shared<controller::MetricsController>(metrics_registry));
+}
+
+auto Application::run() -> void
+{
+    // Serviços já iniciados, parados em ordem inversa na saída: também quando o start de um serviço
+    // seguinte ou do servidor lança (porta ocupada, banco inacessível)
+    struct StartedServices
+    {
+        std::vector<std::function<void()>> stops;
+
+        ~StartedServices()
+        {
+            for (auto it = stops.rbegin(); it != stops.rend(); ++it)
+            {
+                try
+                {
+                    (*it)();
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Background service stop failed: " << e.what() << '\n';
+                }
+            }
+        }
+    } started;
+
+    // Primeiro: um caminho de captura inválido falha antes de subir o resto
+    traffic_recorder_->start();
+    started.stops.push_back([this] { traffic_recorder_->stop(); });
+
+    query_profiler_->start();
+    started.stops.push_back([this] { query_profiler_->stop(); });
+
+    stock_inventory_->start();
+    started.stops.push_back([this] { stock_inventory_->stop(); });
+
+    order_expiry_service_->start();
+    started.stops.push_back([this] { order_expiry_service_->stop(); });
+
+    server_->start();
+}
+
+auto Application::wait_until_ready() -> void
+{
+    server_->wait_until_ready();
+}
+
+auto Application::stop() -> void
+{
+    server_->stop();
+}
+
+} // namespace lynx::app
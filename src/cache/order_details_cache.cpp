@@ -0,0 +1,168 @@
+#include "cache/order_details_cache.h"
+#include "metrics/metrics_registry.h"
+#include <algorithm>
+
+namespace lynx::cache
+{
+
+namespace
+{
+
+auto key_of(int order_id, Encoding encoding) -> uint64_t
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(order_id)) << 1) | static_cast<uint64_t>(encoding);
+}
+
+} // namespace
+
+OrderDetailsCache::OrderDetailsCache(const OrderDetailsCacheConfig &config)
+    : config_(config)
+{
+    config_.shards = std::max<size_t>(config_.shards, 1);
+    shard_budget_ = config_.max_bytes / config_.shards;
+    shards_ = std::make_unique<Shard[]>(config_.shards);
+}
+
+auto OrderDetailsCache::enabled() const -> bool
+{
+    return config_.enabled;
+}
+
+auto OrderDetailsCache::shard_for(int order_id) -> Shard &
+{
+    return shards_[static_cast<uint32_t>(order_id) % config_.shards];
+}
+
+auto OrderDetailsCache::erase(Shard &shard, std::unordered_map<uint64_t, Entry>::iterator it) -> void
+{
+    shard.bytes -= it->second.body->size() + entry_overhead_;
+    shard.lru.erase(it->second.lru);
+    shard.entries.erase(it);
+}
+
+auto OrderDetailsCache::find(int order_id, Encoding encoding) -> std::shared_ptr<const std::string>
+{
+    if (!config_.enabled)
+        return nullptr;
+
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    const auto it = shard.entries.find(key_of(order_id, encoding));
+    if (it == shard.entries.end())
+    {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru);
+    return it->second.body;
+}
+
+auto OrderDetailsCache::generation(int order_id) -> uint64_t
+{
+    return shard_for(order_id).generation.load(std::memory_order_acquire);
+}
+
+auto OrderDetailsCache::store(int order_id, Encoding encoding, uint64_t generation, std::string body) -> void
+{
+    const auto bytes = body.size() + entry_overhead_;
+    if (!config_.enabled || bytes > shard_budget_)
+        return;
+
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    // Invalidação entre a leitura do banco e aqui: o corpo pode ser anterior a ela
+    if (shard.generation.load(std::memory_order_relaxed) != generation)
+        return;
+
+    const auto key = key_of(order_id, encoding);
+    if (const auto it = shard.entries.find(key); it != shard.entries.end())
+        erase(shard, it);
+
+    while (shard.bytes + bytes > shard_budget_ && !shard.lru.empty())
+    {
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+        erase(shard, shard.entries.find(shard.lru.back()));
+    }
+
+    shard.lru.push_front(key);
+    shard.bytes += bytes;
+    shard.entries.emplace(key, Entry{std::make_shared<const std::string>(std::move(body)), shard.lru.begin()});
+}
+
+auto OrderDetailsCache::invalidate(int order_id) -> void
+{
+    if (!config_.enabled)
+        return;
+
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    shard.generation.fetch_add(1, std::memory_order_acq_rel);
+
+    for (const auto encoding : {Encoding::json, Encoding::msgpack})
+    {
+        if (const auto it = shard.entries.find(key_of(order_id, encoding)); it != shard.entries.end())
+        {
+            invalidations_.fetch_add(1, std::memory_order_relaxed);
+            erase(shard, it);
+        }
+    }
+}
+
+auto OrderDetailsCache::invalidate_all() -> void
+{
+    if (!config_.enabled)
+        return;
+
+    for (size_t i = 0; i < config_.shards; ++i)
+    {
+        auto &shard = shards_[i];
+        std::lock_guard lock(shard.mutex);
+
+        shard.generation.fetch_add(1, std::memory_order_acq_rel);
+        invalidations_.fetch_add(shard.entries.size(), std::memory_order_relaxed);
+        shard.entries.clear();
+        shard.lru.clear();
+        shard.bytes = 0;
+    }
+}
+
+auto OrderDetailsCache::stats() -> OrderDetailsCacheStats
+{
+    OrderDetailsCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < config_.shards; ++i)
+    {
+        std::lock_guard lock(shards_[i].mutex);
+        stats.entries += shards_[i].entries.size();
+        stats.bytes += shards_[i].bytes;
+    }
+
+    return stats;
+}
+
+auto OrderDetailsCache::render(std::string &out) -> void
+{
+    const auto current = stats();
+
+    metrics::write_header(out, "lynx_order_details_cache_requests_total", "counter", "Consultas ao cache de detalhes de pedido, por resultado.");
+    metrics::write_sample(out, "lynx_order_details_cache_requests_total", "result=\"hit\"", static_cast<int64_t>(current.hits));
+    metrics::write_sample(out, "lynx_order_details_cache_requests_total", "result=\"miss\"", static_cast<int64_t>(current.misses));
+    metrics::write_header(out, "lynx_order_details_cache_removals_total", "counter", "Corpos removidos do cache de detalhes, por motivo.");
+    metrics::write_sample(out, "lynx_order_details_cache_removals_total", "reason=\"invalidated\"", static_cast<int64_t>(current.invalidations));
+    metrics::write_sample(out, "lynx_order_details_cache_removals_total", "reason=\"evicted\"", static_cast<int64_t>(current.evicted));
+    metrics::write_header(out, "lynx_order_details_cache_entries", "gauge", "Corpos guardados no cache de detalhes de pedido.");
+    metrics::write_sample(out, "lynx_order_details_cache_entries", "", static_cast<int64_t>(current.entries));
+    metrics::write_header(out, "lynx_order_details_cache_bytes", "gauge", "Memória dos corpos guardados, com o custo fixo por entrada.");
+    metrics::write_sample(out, "lynx_order_details_cache_bytes", "", static_cast<int64_t>(current.bytes));
+}
+
+} // namespace lynx::cache
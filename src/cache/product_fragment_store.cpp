@@ -0,0 +1,141 @@
+#include "cache/product_fragment_store.h"
+#include "metrics/metrics_registry.h"
+#include "models/dtos/dto_json.h"
+#include <algorithm>
+
+namespace lynx::cache
+{
+
+ProductFragmentStore::ProductFragmentStore(const ProductFragmentConfig &config)
+    : config_(config)
+    , shard_capacity_(std::max<size_t>(config.max_entries / shard_count_, 1))
+{
+}
+
+auto ProductFragmentStore::shard_for(int product_id) -> Shard &
+{
+    return shards_[static_cast<uint32_t>(product_id) % shard_count_];
+}
+
+auto ProductFragmentStore::append(std::string &out, const models::dto::ProductResponseDTO &product) -> void
+{
+    if (!config_.enabled)
+    {
+        utils::json::JsonWriter writer(112);
+        utils::json::write(writer, product);
+        out += writer.take();
+        rendered_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto &shard = shard_for(product.id);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.entries.find(product.id);
+    if (it == shard.entries.end())
+    {
+        while (shard.entries.size() >= shard_capacity_)
+        {
+            evicted_.fetch_add(1, std::memory_order_relaxed);
+            shard.entries.erase(shard.lru.back());
+            shard.lru.pop_back();
+        }
+
+        shard.lru.push_front(product.id);
+        it = shard.entries.emplace(product.id, Fragment{{}, {}, shard.lru.begin()}).first;
+    }
+    else
+    {
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru);
+    }
+
+    auto &fragment = it->second;
+
+    // Entrada recém-criada tem json vazio: cai no mesmo caminho de um produto alterado
+    if (fragment.json.empty() || !(fragment.source == product))
+    {
+        utils::json::JsonWriter writer(112);
+        utils::json::write(writer, product);
+
+        fragment.source = product;
+        fragment.json = writer.take();
+        rendered_.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        reused_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    out += fragment.json;
+}
+
+auto ProductFragmentStore::to_json(const models::dto::ProductResponseDTO &product) -> std::string
+{
+    std::string out;
+    append(out, product);
+    return out;
+}
+
+auto ProductFragmentStore::to_json(const std::vector<models::dto::ProductResponseDTO> &products) -> std::string
+{
+    std::string out;
+    out.reserve(2 + products.size() * 112);
+
+    out += '[';
+    for (size_t i = 0; i < products.size(); ++i)
+    {
+        if (i > 0)
+            out += ',';
+        append(out, products[i]);
+    }
+    out += ']';
+
+    return out;
+}
+
+auto ProductFragmentStore::forget(int product_id) -> void
+{
+    if (!config_.enabled)
+        return;
+
+    auto &shard = shard_for(product_id);
+    std::lock_guard lock(shard.mutex);
+
+    if (const auto it = shard.entries.find(product_id); it != shard.entries.end())
+    {
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+        shard.lru.erase(it->second.lru);
+        shard.entries.erase(it);
+    }
+}
+
+auto ProductFragmentStore::stats() -> ProductFragmentStats
+{
+    ProductFragmentStats stats;
+    stats.reused = reused_.load(std::memory_order_relaxed);
+    stats.rendered = rendered_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+
+    for (auto &shard : shards_)
+    {
+        std::lock_guard lock(shard.mutex);
+        stats.entries += shard.entries.size();
+    }
+
+    return stats;
+}
+
+auto ProductFragmentStore::render(std::string &out) -> void
+{
+    const auto current = stats();
+
+    metrics::write_header(out, "lynx_product_fragments_total", "counter", "Produtos escritos em respostas JSON, por origem do fragmento.");
+    metrics::write_sample(out, "lynx_product_fragments_total", "result=\"reused\"", static_cast<int64_t>(current.reused));
+    metrics::write_sample(out, "lynx_product_fragments_total", "result=\"rendered\"", static_cast<int64_t>(current.rendered));
+    metrics::write_header(out, "lynx_product_fragments_evicted_total", "counter", "Fragmentos descartados pelo limite de entradas ou por produto inexistente.");
+    metrics::write_sample(out, "lynx_product_fragments_evicted_total", "", static_cast<int64_t>(current.evicted));
+    metrics::write_header(out, "lynx_product_fragments_entries", "gauge", "Fragmentos JSON de produto guardados.");
+    metrics::write_sample(out, "lynx_product_fragments_entries", "", static_cast<int64_t>(current.entries));
+}
+
+} // namespace lynx::cache
@@ -0,0 +1,51 @@
+#include "capture/capture_middleware.h"
+
+namespace lynx::capture
+{
+
+auto CaptureMiddleware::set_recorder(std::shared_ptr<TrafficRecorder> recorder) -> void
+{
+    recorder_ = recorder;
+}
+
+void CaptureMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!recorder_ || !recorder_->sample(req.url))
+        return;
+
+    ctx.sampled = true;
+    ctx.received_at_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    ctx.started_at = std::chrono::steady_clock::now();
+}
+
+void CaptureMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!ctx.sampled)
+        return;
+
+    const auto elapsed = std::chrono::steady_clock::now() - ctx.started_at;
+    const auto max_body_bytes = recorder_->config().max_body_bytes;
+
+    CapturedRequest request;
+    request.received_at_us = ctx.received_at_us;
+    request.method = crow::method_name(req.method);
+    request.path = req.url;
+
+    // raw_url traz a query string; url é só o caminho
+    if (const auto question = req.raw_url.find('?'); question != std::string::npos)
+        request.query = req.raw_url.substr(question + 1);
+
+    request.content_type = req.get_header_value("Content-Type");
+    request.accept = req.get_header_value("Accept");
+    request.accept_encoding = req.get_header_value("Accept-Encoding");
+    request.body = req.body.substr(0, max_body_bytes);
+    request.body_truncated = req.body.size() > max_body_bytes;
+    request.status = res.code;
+    request.duration_us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    request.response_bytes = static_cast<int64_t>(res.body.size());
+
+    recorder_->record(std::move(request));
+}
+
+} // namespace lynx::capture
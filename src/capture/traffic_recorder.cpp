@@ -0,0 +1,261 @@
+#include "capture/traffic_recorder.h"
+#include "errors/http_handle_error.h"
+#include "metrics/metrics_registry.h"
+
+#include <array>
+#include <stdexcept>
+
+namespace lynx::capture
+{
+
+namespace
+{
+
+constexpr std::string_view base64_alphabet_ = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Contador de amostragem da thread do Crow: sem estado compartilhado entre as requisições
+thread_local uint64_t requests_seen = 0;
+
+auto starts_with_any(std::string_view path, const std::vector<std::string> &prefixes) -> bool
+{
+    for (const auto &prefix : prefixes)
+    {
+        if (path.starts_with(prefix))
+            return true;
+    }
+    return false;
+}
+
+auto base64_encode(std::string_view data) -> std::string
+{
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3)
+    {
+        const auto chunk = static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << 16 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(data[i + 1])) << 8 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(data[i + 2]));
+        out += base64_alphabet_[chunk >> 18 & 0x3F];
+        out += base64_alphabet_[chunk >> 12 & 0x3F];
+        out += base64_alphabet_[chunk >> 6 & 0x3F];
+        out += base64_alphabet_[chunk & 0x3F];
+    }
+
+    if (const auto rest = data.size() - i; rest > 0)
+    {
+        auto chunk = static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << 16;
+        if (rest == 2)
+            chunk |= static_cast<uint32_t>(static_cast<unsigned char>(data[i + 1])) << 8;
+
+        out += base64_alphabet_[chunk >> 18 & 0x3F];
+        out += base64_alphabet_[chunk >> 12 & 0x3F];
+        out += rest == 2 ? base64_alphabet_[chunk >> 6 & 0x3F] : '=';
+        out += '=';
+    }
+
+    return out;
+}
+
+auto base64_decode(std::string_view text) -> std::string
+{
+    std::array<int8_t, 256> values;
+    values.fill(-1);
+    for (size_t i = 0; i < base64_alphabet_.size(); ++i)
+        values[static_cast<unsigned char>(base64_alphabet_[i])] = static_cast<int8_t>(i);
+
+    while (!text.empty() && text.back() == '=')
+        text.remove_suffix(1);
+
+    std::string out;
+    out.reserve(text.size() * 3 / 4);
+
+    uint32_t chunk = 0;
+    int bits = 0;
+    for (const auto c : text)
+    {
+        const auto value = values[static_cast<unsigned char>(c)];
+        if (value < 0)
+            throw exceptions::BadRequestError("body: invalid base64");
+
+        chunk = chunk << 6 | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            out += static_cast<char>(chunk >> bits & 0xFF);
+        }
+    }
+
+    return out;
+}
+
+} // namespace
+
+TrafficRecorder::TrafficRecorder(const CaptureConfig &config)
+    : config_(config)
+{
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+    stop();
+}
+
+auto TrafficRecorder::start() -> void
+{
+    if (!config_.enabled || worker_.joinable())
+        return;
+
+    file_.open(config_.path, std::ios::out | std::ios::app | std::ios::binary);
+    if (!file_)
+        throw std::runtime_error("Não foi possível abrir o arquivo de captura: " + config_.path);
+
+    stopping_ = false;
+    worker_ = std::thread([this] { run(); });
+}
+
+auto TrafficRecorder::stop() -> void
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    if (worker_.joinable())
+        worker_.join();
+
+    if (file_.is_open())
+        file_.close();
+}
+
+auto TrafficRecorder::config() const -> const CaptureConfig &
+{
+    return config_;
+}
+
+auto TrafficRecorder::sample(std::string_view path) const -> bool
+{
+    if (config_.sample_every == 0 || !starts_with_any(path, config_.prefixes) || starts_with_any(path, config_.excluded_prefixes))
+        return false;
+
+    return ++requests_seen % config_.sample_every == 0;
+}
+
+auto TrafficRecorder::record(CapturedRequest &&request) -> void
+{
+    {
+        std::lock_guard lock(mutex_);
+
+        // Sem a thread de escrita (parada ou nunca iniciada) a fila não seria esvaziada
+        if (stopping_ || !worker_.joinable() || queue_.size() >= config_.max_pending)
+        {
+            ++dropped_;
+            return;
+        }
+
+        ++recorded_;
+        if (request.body_truncated)
+            ++truncated_;
+
+        queue_.push_back(std::move(request));
+    }
+    cv_.notify_one();
+}
+
+auto TrafficRecorder::run() -> void
+{
+    std::deque<CapturedRequest> batch;
+    utils::json::JsonWriter writer(1024);
+    std::string lines;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+            // Parando, só sai com a fila vazia: o que foi aceito chega ao arquivo
+            if (queue_.empty())
+                return;
+
+            batch.swap(queue_);
+        }
+
+        lines.clear();
+        for (auto &request : batch)
+        {
+            writer.clear();
+            to_ndjson(std::move(request), writer);
+            lines.append(writer.buffer()).push_back('\n');
+        }
+
+        file_.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        file_.flush();
+
+        {
+            std::lock_guard lock(mutex_);
+            if (file_)
+                written_ += batch.size();
+            else
+                dropped_ += batch.size();
+        }
+
+        batch.clear();
+    }
+}
+
+auto TrafficRecorder::render(std::string &out) -> void
+{
+    uint64_t recorded, dropped, written, truncated, pending;
+    {
+        std::lock_guard lock(mutex_);
+        recorded = recorded_;
+        dropped = dropped_;
+        written = written_;
+        truncated = truncated_;
+        pending = queue_.size();
+    }
+
+    metrics::write_header(out, "lynx_capture_requests_total", "counter", "Requisições amostradas para a captura, por resultado.");
+    metrics::write_sample(out, "lynx_capture_requests_total", "result=\"recorded\"", static_cast<int64_t>(recorded));
+    metrics::write_sample(out, "lynx_capture_requests_total", "result=\"dropped\"", static_cast<int64_t>(dropped));
+    metrics::write_header(out, "lynx_capture_written_total", "counter", "Linhas gravadas no arquivo de captura.");
+    metrics::write_sample(out, "lynx_capture_written_total", "", static_cast<int64_t>(written));
+    metrics::write_header(out, "lynx_capture_truncated_total", "counter", "Capturas com o corpo cortado em max_body_bytes.");
+    metrics::write_sample(out, "lynx_capture_truncated_total", "", static_cast<int64_t>(truncated));
+    metrics::write_header(out, "lynx_capture_pending", "gauge", "Capturas na fila da escrita.");
+    metrics::write_sample(out, "lynx_capture_pending", "", static_cast<int64_t>(pending));
+}
+
+auto to_ndjson(CapturedRequest request, utils::json::JsonWriter &writer) -> void
+{
+    if (!request.body.empty() && request.content_type.find("msgpack") != std::string::npos)
+    {
+        request.body = base64_encode(request.body);
+        request.body_base64 = true;
+    }
+
+    utils::json::write(writer, request);
+}
+
+auto parse_ndjson(std::string_view line) -> CapturedRequest
+{
+    // Corpo em base64 ocupa 4/3 do original
+    utils::json::ReaderLimits limits;
+    limits.max_string_bytes = 1024 * 1024;
+
+    auto request = utils::json::parse<CapturedRequest>(line, limits);
+
+    if (request.body_base64)
+    {
+        request.body = base64_decode(request.body);
+        request.body_base64 = false;
+    }
+
+    return request;
+}
+
+} // namespace lynx::capture
@@ -0,0 +1,65 @@
+#include "compression/compression_middleware.h"
+#include "errors/http_handle_error.h"
+#include "tracing/trace.h"
+#include "utils/http_header.h"
+
+#include <algorithm>
+#include <string_view>
+
+namespace lynx::compression
+{
+
+namespace
+{
+
+auto compressible(std::string_view content_type) -> bool
+{
+    return content_type.empty() || content_type.starts_with("application/json") || content_type.starts_with("application/msgpack") ||
+           content_type.starts_with("application/x-ndjson") || content_type.starts_with("text/");
+}
+
+} // namespace
+
+auto CompressionMiddleware::configure(const CompressionConfig &config) -> void
+{
+    config_ = config;
+    config_.level = std::clamp(config_.level, 1, 9);
+}
+
+void CompressionMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx)
+{
+}
+
+void CompressionMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!config_.enabled || res.body.size() < config_.min_bytes || res.code == 204 || res.code == 304)
+        return;
+
+    if (!res.get_header_value("Content-Encoding").empty() || !compressible(res.get_header_value("Content-Type")))
+        return;
+
+    // Acima do limite a representação depende do Accept-Encoding, comprimida ou não
+    res.set_header("Vary", utils::http::merge_vary(res.get_header_value("Vary"), "Accept-Encoding"));
+
+    const auto encoding = negotiate_encoding(req.get_header_value("Accept-Encoding"));
+    if (encoding == Encoding::identity)
+        return;
+
+    LYNX_TRACE_SPAN("compression.compress");
+
+    try
+    {
+        auto compressed = compress(encoding, config_.level, res.body);
+        if (compressed.size() >= res.body.size())
+            return;
+
+        res.body = std::move(compressed);
+        res.set_header("Content-Encoding", std::string(encoding_name(encoding)));
+    }
+    catch (const exceptions::CustomError &)
+    {
+        // Falha da biblioteca: segue sem compressão
+    }
+}
+
+} // namespace lynx::compression
@@ -0,0 +1,279 @@
+#include "compression/response_compressor.h"
+#include "errors/http_handle_error.h"
+#include "utils/http_header.h"
+
+#include <zlib.h>
+
+#ifdef LYNX_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace lynx::compression
+{
+
+namespace
+{
+
+constexpr size_t output_step_ = 16 * 1024;
+
+struct ZlibContext
+{
+    z_stream stream{};
+    bool ready = false;
+    int level = 0;
+
+    ~ZlibContext()
+    {
+        if (ready)
+            deflateEnd(&stream);
+    }
+};
+
+auto thread_zlib(Encoding encoding) -> ZlibContext &
+{
+    thread_local ZlibContext gzip_context;
+    thread_local ZlibContext deflate_context;
+
+    return encoding == Encoding::gzip ? gzip_context : deflate_context;
+}
+
+// deflateReset mantém as tabelas alocadas; só um nível diferente exige recriar o stream
+auto begin_zlib(Encoding encoding, int level) -> void
+{
+    auto &context = thread_zlib(encoding);
+
+    if (context.ready && context.level == level)
+    {
+        deflateReset(&context.stream);
+        return;
+    }
+
+    if (context.ready)
+        deflateEnd(&context.stream);
+
+    // 15 + 16: janela de 32 KB com cabeçalho gzip; 15 sozinho é o formato zlib, o "deflate" do HTTP
+    const int window_bits = encoding == Encoding::gzip ? 15 + 16 : 15;
+
+    context.stream = z_stream{};
+    context.ready = deflateInit2(&context.stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    context.level = level;
+
+    if (!context.ready)
+        throw exceptions::InternalServerError("Erro ao iniciar o compressor zlib");
+}
+
+auto zlib_deflate(Encoding encoding, std::string_view input, int flush, std::string &out) -> void
+{
+    auto &stream = thread_zlib(encoding).stream;
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+
+    do
+    {
+        const auto offset = out.size();
+        out.resize(offset + output_step_);
+
+        stream.next_out = reinterpret_cast<Bytef *>(out.data() + offset);
+        stream.avail_out = static_cast<uInt>(output_step_);
+
+        const auto status = deflate(&stream, flush);
+        out.resize(offset + output_step_ - stream.avail_out);
+
+        if (status == Z_STREAM_ERROR)
+            throw exceptions::InternalServerError("Erro ao comprimir a resposta (zlib)");
+    } while (stream.avail_out == 0);
+}
+
+#ifdef LYNX_WITH_ZSTD
+
+struct ZstdContext
+{
+    ZSTD_CCtx *context = ZSTD_createCCtx();
+
+    ~ZstdContext()
+    {
+        ZSTD_freeCCtx(context);
+    }
+};
+
+auto thread_zstd() -> ZSTD_CCtx *
+{
+    thread_local ZstdContext zstd_context;
+    return zstd_context.context;
+}
+
+auto begin_zstd(int level) -> void
+{
+    auto *context = thread_zstd();
+
+    if (context == nullptr)
+        throw exceptions::InternalServerError("Erro ao iniciar o compressor zstd");
+
+    ZSTD_CCtx_reset(context, ZSTD_reset_session_only);
+    ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level);
+}
+
+auto zstd_compress(std::string_view input, ZSTD_EndDirective mode, std::string &out) -> void
+{
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+
+    while (true)
+    {
+        const auto offset = out.size();
+        out.resize(offset + output_step_);
+
+        ZSTD_outBuffer buffer{out.data() + offset, output_step_, 0};
+        const auto remaining = ZSTD_compressStream2(thread_zstd(), &buffer, &in, mode);
+        out.resize(offset + buffer.pos);
+
+        if (ZSTD_isError(remaining))
+            throw exceptions::InternalServerError(std::string("Erro ao comprimir a resposta (zstd): ") + ZSTD_getErrorName(remaining));
+
+        const bool done = mode == ZSTD_e_end ? remaining == 0 : in.pos == in.size;
+        if (done)
+            break;
+    }
+}
+
+#endif
+
+} // namespace
+
+auto encoding_name(Encoding encoding) -> std::string_view
+{
+    switch (encoding)
+    {
+    case Encoding::gzip:
+        return "gzip";
+    case Encoding::deflate:
+        return "deflate";
+    case Encoding::zstd:
+        return "zstd";
+    default:
+        return "identity";
+    }
+}
+
+auto negotiate_encoding(std::string_view accept_encoding) -> Encoding
+{
+    // -1: não citada no cabeçalho
+    int gzip = -1;
+    int deflate = -1;
+    [[maybe_unused]] int zstd = -1;
+    int any = -1;
+
+    while (!accept_encoding.empty())
+    {
+        const auto comma = accept_encoding.find(',');
+        const auto item = accept_encoding.substr(0, comma);
+        accept_encoding = comma == std::string_view::npos ? std::string_view{} : accept_encoding.substr(comma + 1);
+
+        const auto semicolon = item.find(';');
+        const auto name = utils::http::trim(item.substr(0, semicolon));
+        const auto quality = semicolon == std::string_view::npos ? 1000 : utils::http::quality_of(item.substr(semicolon + 1));
+
+        if (utils::http::equals_ignore_case(name, "gzip") || utils::http::equals_ignore_case(name, "x-gzip"))
+            gzip = quality;
+        else if (utils::http::equals_ignore_case(name, "deflate"))
+            deflate = quality;
+        else if (utils::http::equals_ignore_case(name, "zstd"))
+            zstd = quality;
+        else if (name == "*")
+            any = quality;
+    }
+
+    const auto resolve = [any](int quality) { return quality >= 0 ? quality : any; };
+
+    auto chosen = Encoding::identity;
+    int best = 0;
+
+#ifdef LYNX_WITH_ZSTD
+    if (resolve(zstd) > best)
+    {
+        chosen = Encoding::zstd;
+        best = resolve(zstd);
+    }
+#endif
+    if (resolve(gzip) > best)
+    {
+        chosen = Encoding::gzip;
+        best = resolve(gzip);
+    }
+    if (resolve(deflate) > best)
+    {
+        chosen = Encoding::deflate;
+    }
+
+    return chosen;
+}
+
+StreamCompressor::StreamCompressor(Encoding encoding, int level)
+    : encoding_(encoding)
+{
+    switch (encoding_)
+    {
+    case Encoding::gzip:
+    case Encoding::deflate:
+        begin_zlib(encoding_, level);
+        break;
+#ifdef LYNX_WITH_ZSTD
+    case Encoding::zstd:
+        begin_zstd(level);
+        break;
+#endif
+    case Encoding::identity:
+        break;
+    default:
+        throw exceptions::InternalServerError("Codificação não suportada neste build");
+    }
+}
+
+auto StreamCompressor::write(std::string_view chunk, std::string &out) -> void
+{
+    switch (encoding_)
+    {
+    case Encoding::gzip:
+    case Encoding::deflate:
+        zlib_deflate(encoding_, chunk, Z_NO_FLUSH, out);
+        break;
+#ifdef LYNX_WITH_ZSTD
+    case Encoding::zstd:
+        zstd_compress(chunk, ZSTD_e_continue, out);
+        break;
+#endif
+    default:
+        out.append(chunk);
+    }
+}
+
+auto StreamCompressor::finish(std::string &out) -> void
+{
+    switch (encoding_)
+    {
+    case Encoding::gzip:
+    case Encoding::deflate:
+        zlib_deflate(encoding_, {}, Z_FINISH, out);
+        break;
+#ifdef LYNX_WITH_ZSTD
+    case Encoding::zstd:
+        zstd_compress({}, ZSTD_e_end, out);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+auto compress(Encoding encoding, int level, std::string_view body) -> std::string
+{
+    std::string out;
+    out.reserve(body.size() / 4 + output_step_);
+
+    StreamCompressor compressor(encoding, level);
+    compressor.write(body, out);
+    compressor.finish(out);
+    return out;
+}
+
+} // namespace lynx::compression
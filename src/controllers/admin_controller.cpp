@@ -0,0 +1,177 @@
+#include "controllers/admin_controller.h"
+#include "errors/handle_error.h"
+#include "tracing/trace.h"
+#include "utils/convert.h"
+#include "utils/enums.h"
+#include <algorithm>
+
+namespace lynx::controller
+{
+
+AdminController::AdminController(std::shared_ptr<ledger::OrderLedger> ledger, std::shared_ptr<database::QueryProfiler> query_profiler)
+    : ledger_(ledger)
+    , query_profiler_(query_profiler)
+{
+}
+
+auto AdminController::register_routes(App &app) -> void
+{
+    app.route_dynamic(this->base_path_ + "/ledger").methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->ledger_stats(); });
+    app.route_dynamic(this->base_path_ + "/ledger/verify").methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->ledger_verify(req); });
+    app.route_dynamic(this->base_path_ + "/queries").methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->query_stats(req); });
+#ifdef LYNX_TRACING
+    app.route_dynamic(this->base_path_ + "/trace").methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->trace_export(req); });
+#endif
+}
+
+auto AdminController::ledger_stats() -> crow::response
+{
+    const auto stats = ledger_->stats();
+    const auto lookups = stats.hits + stats.misses;
+
+    crow::json::wvalue res;
+    res["entries"] = stats.entries;
+    res["hits"] = stats.hits;
+    res["misses"] = stats.misses;
+    res["hit_rate"] = lookups == 0 ? 0.0 : static_cast<double>(stats.hits) / static_cast<double>(lookups);
+
+    return crow::response((int)HttpStatus::OK, res);
+}
+
+auto AdminController::ledger_verify(const crow::request &req) -> crow::response
+{
+    try
+    {
+        bool repair = false;
+        if (req.url_params.get("repair"))
+            repair = utils::string_to_bool(req.url_params.get("repair")).value_or(false);
+
+        auto drifts = ledger_->verify(repair);
+
+        crow::json::wvalue res;
+        res["repaired"] = repair;
+        res["drift_count"] = drifts.size();
+        res["drifts"] = crow::json::wvalue::list();
+
+        for (size_t i = 0; i < drifts.size(); ++i)
+        {
+            const auto &drift = drifts[i];
+            res["drifts"][i]["order_id"] = drift.order_id;
+            res["drifts"][i]["cached"]["total_cents"] = drift.cached.total_cents;
+            res["drifts"][i]["cached"]["paid_cents"] = drift.cached.paid_cents;
+            res["drifts"][i]["cached"]["status"] = utils::order_status_to_string(drift.cached.status);
+
+            if (drift.database.has_value())
+            {
+                res["drifts"][i]["database"]["total_cents"] = drift.database->total_cents;
+                res["drifts"][i]["database"]["paid_cents"] = drift.database->paid_cents;
+                res["drifts"][i]["database"]["status"] = utils::order_status_to_string(drift.database->status);
+            }
+            else
+            {
+                res["drifts"][i]["database"] = nullptr;
+            }
+        }
+
+        return crow::response((int)HttpStatus::OK, res);
+    }
+    catch (const exceptions::CustomError &e)
+    {
+        return crow::response(static_cast<int>(e.status_code()), e.to_json());
+    }
+}
+
+auto AdminController::query_stats(const crow::request &req) -> crow::response
+{
+    try
+    {
+        std::string sort = "total";
+        if (req.url_params.get("sort"))
+            sort = req.url_params.get("sort");
+
+        if (sort != "total" && sort != "p99" && sort != "max" && sort != "count" && sort != "rows")
+            throw exceptions::BadRequestError("sort must be one of: total, p99, max, count, rows");
+
+        size_t limit = 50;
+        if (req.url_params.get("limit"))
+        {
+            const auto parsed = utils::string_to_int_or_throw(req.url_params.get("limit"));
+            if (parsed <= 0)
+                throw exceptions::BadRequestError("limit must be a positive integer");
+            limit = static_cast<size_t>(parsed);
+        }
+
+        auto stats = query_profiler_->snapshot();
+        const auto dropped = query_profiler_->slow_dropped();
+
+        if (req.url_params.get("reset") && utils::string_to_bool(req.url_params.get("reset")).value_or(false))
+            query_profiler_->reset();
+
+        const auto key = [&sort](const database::QueryStats &q) -> uint64_t {
+            if (sort == "p99")
+                return q.p99_ns;
+            if (sort == "max")
+                return q.max_ns;
+            if (sort == "count")
+                return q.count;
+            if (sort == "rows")
+                return q.rows;
+            return q.total_ns;
+        };
+        std::sort(stats.begin(), stats.end(), [&key](const auto &a, const auto &b) { return key(a) > key(b); });
+
+        if (stats.size() > limit)
+            stats.resize(limit);
+
+        crow::json::wvalue res;
+        res["slow_dropped"] = dropped;
+        res["statements"] = crow::json::wvalue::list();
+
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            const auto &q = stats[i];
+            auto &item = res["statements"][i];
+            item["sql"] = q.sql;
+            item["count"] = q.count;
+            item["total_ms"] = static_cast<double>(q.total_ns) / 1e6;
+            item["mean_ms"] = q.count == 0 ? 0.0 : static_cast<double>(q.total_ns) / 1e6 / static_cast<double>(q.count);
+            item["p99_ms"] = static_cast<double>(q.p99_ns) / 1e6;
+            item["max_ms"] = static_cast<double>(q.max_ns) / 1e6;
+            item["rows"] = q.rows;
+            item["fullscan_steps"] = q.fullscan_steps;
+            item["sorts"] = q.sorts;
+            item["autoindexes"] = q.autoindexes;
+            item["vm_steps"] = q.vm_steps;
+            item["slow_count"] = q.slow_count;
+
+            if (q.plan.has_value())
+                item["plan"] = *q.plan;
+            else
+                item["plan"] = nullptr;
+        }
+
+        return crow::response((int)HttpStatus::OK, res);
+    }
+    catch (const exceptions::CustomError &e)
+    {
+        return crow::response(static_cast<int>(e.status_code()), e.to_json());
+    }
+}
+
+#ifdef LYNX_TRACING
+auto AdminController::trace_export(const crow::request &req) -> crow::response
+{
+    auto &buffer = tracing::TraceBuffer::get_instance();
+
+    // Formato trace-event do Chrome: abrir em chrome://tracing ou ui.perfetto.dev
+    crow::response res(static_cast<int>(HttpStatus::OK), buffer.to_chrome_json());
+    res.set_header("Content-Type", "application/json");
+
+    if (req.url_params.get("clear") && utils::string_to_bool(req.url_params.get("clear")).value_or(false))
+        buffer.clear();
+
+    return res;
+}
+#endif
+
+} // namespace lynx::controller
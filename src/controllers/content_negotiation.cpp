@@ -0,0 +1,79 @@
+#include "controllers/content_negotiation.h"
+
+namespace lynx::controller
+{
+
+namespace
+{
+
+auto is_msgpack(std::string_view media_type) -> bool
+{
+    return utils::http::equals_ignore_case(media_type, "application/msgpack") || utils::http::equals_ignore_case(media_type, "application/x-msgpack");
+}
+
+// Faixa do Accept que cobre um tipo: a mais específica decide o q (3 exata, 2 "application/*", 1 "*/*")
+struct RangeMatch
+{
+    int specificity = 0;
+    int quality = -1; // -1: nenhuma faixa cobre o tipo
+
+    auto consider(int range_specificity, int range_quality) -> void
+    {
+        if (range_specificity > specificity)
+        {
+            specificity = range_specificity;
+            quality = range_quality;
+        }
+        else if (range_specificity == specificity && range_quality > quality)
+        {
+            quality = range_quality;
+        }
+    }
+};
+
+} // namespace
+
+auto negotiate_format(std::string_view accept) -> BodyFormat
+{
+    RangeMatch json;
+    RangeMatch msgpack;
+
+    while (!accept.empty())
+    {
+        const auto comma = accept.find(',');
+        const auto item = accept.substr(0, comma);
+        accept = comma == std::string_view::npos ? std::string_view{} : accept.substr(comma + 1);
+
+        const auto semicolon = item.find(';');
+        const auto range = utils::http::trim(item.substr(0, semicolon));
+        const auto quality = semicolon == std::string_view::npos ? 1000 : utils::http::quality_of(item.substr(semicolon + 1));
+
+        if (utils::http::equals_ignore_case(range, "application/json"))
+        {
+            json.consider(3, quality);
+        }
+        else if (is_msgpack(range))
+        {
+            msgpack.consider(3, quality);
+        }
+        else if (utils::http::equals_ignore_case(range, "application/*"))
+        {
+            json.consider(2, quality);
+            msgpack.consider(2, quality);
+        }
+        else if (range == "*/*")
+        {
+            json.consider(1, quality);
+            msgpack.consider(1, quality);
+        }
+    }
+
+    return msgpack.quality > 0 && msgpack.quality > json.quality ? BodyFormat::msgpack : BodyFormat::json;
+}
+
+auto content_type_format(std::string_view content_type) -> BodyFormat
+{
+    return is_msgpack(utils::http::trim(content_type.substr(0, content_type.find(';')))) ? BodyFormat::msgpack : BodyFormat::json;
+}
+
+} // namespace lynx::controller
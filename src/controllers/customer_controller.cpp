@@ -1,7 +1,9 @@
 #include "controllers/customer_controller.h"
+#include "controllers/content_negotiation.h"
+#include "controllers/error_response.h"
 #include "errors/http_handle_error.h"
 #include "utils/enums.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <iostream>
 
 namespace lynx::controller
@@ -14,32 +16,29 @@ CustomerController::CustomerController(std::shared_ptr<services::CustomerService
 
 auto CustomerController::register_routes(App &app) -> void
 {
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->create(req); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return negotiated(this->create(req)); });
 
-    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return this->get(id); });
+    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return negotiated(this->get(req, id)); });
 }
 
 auto CustomerController::create(const crow::request &req) -> crow::response
 {
     try
     {
-        auto body = crow::json::load(req.body);
-        if (!body.has("name") || !body.has("email"))
-        {
-            throw exceptions::BadRequestError("Missing required fields");
-        }
-
-        models::dto::CustomerCreateDTO dto;
-        dto.name = body["name"].s();
-        dto.email = body["email"].s();
+        auto dto = parse_body<models::dto::CustomerCreateDTO>(req);
 
         auto result = services_->create_customer(dto);
+        if (!result)
+            return error_response(result.error());
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response((int)HttpStatus::CREATED, *result);
 
         crow::json::wvalue res;
-        res["id"] = result.id;
-        res["name"] = result.name;
-        res["email"] = result.email;
-        res["created_at"] = utils::time::time_point_to_string(result.created_at);
+        res["id"] = result->id;
+        res["name"] = result->name;
+        res["email"] = result->email;
+        res["created_at"] = utils::time::format_time(result->created_at, utils::time::TimeFormat::iso8601);
 
         return crow::response((int)HttpStatus::CREATED, res);
     }
@@ -49,17 +48,22 @@ auto CustomerController::create(const crow::request &req) -> crow::response
     }
 }
 
-auto CustomerController::get(const int &id) -> crow::response
+auto CustomerController::get(const crow::request &req, const int &id) -> crow::response
 {
     try
     {
         auto result = services_->get_customer_by_id(id);
+        if (!result)
+            return error_response(result.error());
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response((int)HttpStatus::OK, *result);
 
         crow::json::wvalue res;
-        res["id"] = result.id;
-        res["name"] = result.name;
-        res["email"] = result.email;
-        res["created_at"] = utils::time::time_point_to_string(result.created_at);
+        res["id"] = result->id;
+        res["name"] = result->name;
+        res["email"] = result->email;
+        res["created_at"] = utils::time::format_time(result->created_at, utils::time::TimeFormat::iso8601);
 
         return crow::response((int)HttpStatus::OK, res);
     }
@@ -82,7 +86,7 @@ auto CustomerController::list(const crow::request &req) -> crow::response
             res[i]["id"] = customers[i].id;
             res[i]["name"] = customers[i].name;
             res[i]["email"] = customers[i].email;
-            res[i]["created_at"] = utils::time::time_point_to_string(customers[i].created_at);
+            res[i]["created_at"] = utils::time::format_time(customers[i].created_at, utils::time::TimeFormat::iso8601);
         }
 
         return crow::response((int)HttpStatus::OK, res);
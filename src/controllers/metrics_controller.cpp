@@ -0,0 +1,25 @@
+#include "controllers/metrics_controller.h"
+#include "utils/enums.h"
+
+namespace lynx::controller
+{
+
+MetricsController::MetricsController(std::shared_ptr<metrics::MetricsRegistry> registry)
+    : registry_(registry)
+{
+}
+
+auto MetricsController::register_routes(App &app) -> void
+{
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->scrape(); });
+}
+
+auto MetricsController::scrape() -> crow::response
+{
+    crow::response res(static_cast<int>(HttpStatus::OK), registry_->render());
+    res.set_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+
+    return res;
+}
+
+} // namespace lynx::controller
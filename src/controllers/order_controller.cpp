@@ -1,53 +1,53 @@
 #include "controllers/order_controller.h"
+#include "controllers/content_negotiation.h"
+#include "controllers/error_response.h"
 #include "errors/handle_error.h"
+#include "tracing/trace.h"
 #include "utils/convert.h"
 #include "utils/enums.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 
 namespace lynx::controller
 {
 
-OrderController::OrderController(std::shared_ptr<services::OrderServices> services)
+OrderController::OrderController(std::shared_ptr<services::OrderServices> services, std::shared_ptr<cache::OrderDetailsCache> details_cache)
     : services_(services)
+    , details_cache_(details_cache)
 {
 }
 
 auto OrderController::register_routes(App &app) -> void
 {
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->create(req); });
-    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return this->get(id); });
-    app.route_dynamic(this->base_path_ + "/summary").methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->list(req); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return negotiated(this->create(req)); });
+    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return negotiated(this->get(req, id)); });
+    app.route_dynamic(this->base_path_ + "/summary").methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return negotiated(this->list(req)); });
 }
 
 auto OrderController::create(const crow::request &req) -> crow::response
 {
     try
     {
-        auto body = crow::json::load(req.body);
-        if (!body)
-            return crow::response(400, "Invalid JSON");
-
         models::dto::OrderCreateDTO dto;
-        if (!body.has("customer_id") || !body.has("items"))
         {
-            throw exceptions::BadRequestError("Missing required fields");
+            LYNX_TRACE_SPAN("order_controller.parse");
+            dto = parse_body<models::dto::OrderCreateDTO>(req);
         }
 
-        dto.customer_id = body["customer_id"].i();
+        auto created_order = services_->create_order(dto);
+        if (!created_order)
+            return error_response(created_order.error());
 
-        for (const auto &jitem : body["items"])
+        LYNX_TRACE_SPAN("order_controller.serialize");
+        if (response_format(req) == BodyFormat::msgpack)
         {
-            models::dto::OrderItemDTO item_dto;
-            item_dto.product_id = jitem["product_id"].i();
-            item_dto.quantity = jitem["quantity"].i();
-            dto.items.push_back(item_dto);
+            utils::msgpack::MsgPackWriter writer(48);
+            writer.begin_map(2).key("message").value("Order created successfully").key("order_id").value(static_cast<int64_t>(created_order->id));
+            return msgpack_response((int)HttpStatus::CREATED, writer);
         }
 
-        auto created_order = services_->create_order(dto);
-
         crow::json::wvalue res;
         res["message"] = "Order created successfully";
-        res["order_id"] = created_order.id;
+        res["order_id"] = created_order->id;
 
         return crow::response((int)HttpStatus::CREATED, res);
     }
@@ -57,32 +57,53 @@ auto OrderController::create(const crow::request &req) -> crow::response
     }
 }
 
-auto OrderController::get(const int order_id) -> crow::response
+auto OrderController::get(const crow::request &req, const int order_id) -> crow::response
 {
     try
     {
-        auto order = services_->get_order_details(order_id);
+        const auto format = response_format(req);
+        const auto encoding = format == BodyFormat::msgpack ? cache::Encoding::msgpack : cache::Encoding::json;
+        const auto content_type = format == BodyFormat::msgpack ? "application/msgpack" : "application/json";
 
-        crow::json::wvalue res;
-        res["order_id"] = order.order_id;
-        res["customer_id"] = order.customer_id;
-        res["status"] = order.status;
-        res["created_at"] = utils::time::time_point_to_string(order.created_at);
+        // Pedido encerrado já servido nesse formato: só a cópia do corpo pronto
+        if (auto cached = details_cache_->find(order_id, encoding))
+        {
+            crow::response res((int)HttpStatus::OK, *cached);
+            res.set_header("Content-Type", content_type);
+            return res;
+        }
+
+        // Antes da leitura: uma invalidação durante a montagem impede o store abaixo
+        const auto generation = details_cache_->generation(order_id);
 
-        res["items"] = crow::json::wvalue::list();
-        for (size_t i = 0; i < order.items.size(); ++i)
+        auto order = services_->get_order_details(order_id);
+        if (!order)
+            return error_response(order.error());
+
+        LYNX_TRACE_SPAN("order_controller.serialize");
+        std::string body;
+        if (format == BodyFormat::msgpack)
         {
-            const auto &item = order.items[i];
-            res["items"][i]["product_id"] = item.product_id;
-            res["items"][i]["product_name"] = item.product_name;
-            res["items"][i]["quantity"] = item.quantity;
-            res["items"][i]["unit_price_cents"] = item.unit_price_cents;
-            res["items"][i]["subtotal_cents"] = item.subtotal_cents;
+            utils::msgpack::MsgPackWriter writer(96 + order->items.size() * 80);
+            utils::msgpack::write(writer, *order);
+            body = writer.take();
         }
+        else
+        {
+            utils::json::JsonWriter writer(160 + order->items.size() * 128);
+            utils::json::write(writer, *order);
+            body = writer.take();
+        }
+
+        // PAID e CANCELLED não mudam mais; pedidos em aberto sempre vão ao banco
+        const auto status = utils::string_to_order_status(order->status);
+        if (details_cache_->enabled() && (status == models::OrderStatus::PAID || status == models::OrderStatus::CANCELLED))
+            details_cache_->store(order_id, encoding, generation, body);
 
-        res["total_cents"] = order.total_cents;
+        crow::response res((int)(HttpStatus::OK), std::move(body));
+        res.set_header("Content-Type", content_type);
 
-        return crow::response((int)(HttpStatus::OK), res);
+        return res;
     }
     catch (const lynx::exceptions::CustomError &e)
     {
@@ -110,20 +131,18 @@ auto OrderController::list(const crow::request &req) -> crow::response
         // 2️⃣ Buscar dados do serviço com filtros
         auto summary_orders = services_->get_all_orders_summary(status_filter, customer_id_filter, limit);
 
-        // 3️⃣ Montar JSON de resposta
-        crow::json::wvalue res = crow::json::wvalue::list();
-        for (size_t i = 0; i < summary_orders.size(); ++i)
-        {
-            const auto &order = summary_orders[i];
-            res[i]["id"] = order.id;
-            res[i]["customer_id"] = order.customer_id;
-            res[i]["status"] = order.status;
-            res[i]["created_at"] = utils::time::time_point_to_string(order.created_at);
-            res[i]["total_cents"] = order.total_cents;
-            res[i]["total_paid_cents"] = order.total_paid_cents;
-        }
+        // 3️⃣ Escrever o JSON direto no buffer, sem árvore intermediária
+        LYNX_TRACE_SPAN("order_controller.serialize");
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response((int)HttpStatus::OK, summary_orders, 5 + summary_orders.size() * 96);
+
+        utils::json::JsonWriter writer(2 + summary_orders.size() * 144);
+        utils::json::write(writer, summary_orders);
+
+        crow::response res((int)HttpStatus::OK, writer.take());
+        res.set_header("Content-Type", "application/json");
 
-        return crow::response((int)HttpStatus::OK, res);
+        return res;
     }
     catch (const exceptions::CustomError &e)
     {
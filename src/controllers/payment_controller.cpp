@@ -1,8 +1,12 @@
 #include "controllers/payment_controller.h"
+#include "controllers/content_negotiation.h"
+#include "controllers/error_response.h"
 #include "errors/handle_error.h"
 #include "utils/convert.h"
 #include "utils/enums.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
+#include <algorithm>
+#include <string_view>
 
 namespace lynx::controller
 {
@@ -14,23 +18,26 @@ PaymentController::PaymentController(std::shared_ptr<services::PaymentServices>
 
 auto PaymentController::register_routes(App &app) -> void
 {
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->create(req); });
-    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return this->get(id); });
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->list(req); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return negotiated(this->create(req)); });
+    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return negotiated(this->get(req, id)); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return negotiated(this->list(req)); });
+    app.route_dynamic(this->base_path_ + "/confirmations").methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->confirm(req); });
 }
 
 auto PaymentController::create(const crow::request &req) -> crow::response
 {
     try
     {
-        auto body = crow::json::load(req.body);
+        auto dto = parse_body<models::dto::PaymentCreateDTO>(req);
 
-        models::dto::PaymentCreateDTO dto;
-        dto.method = utils::string_to_payment_method(body["method"].s());
-        dto.amount_cents = body["amount_cents"].i();
-        dto.order_id = body["order_id"].i();
+        auto created = services_->create_payment(dto);
+        if (!created)
+            return error_response(created.error());
 
-        auto payment_res = services_->create_payment(dto);
+        const auto &payment_res = *created;
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response((int)HttpStatus::CREATED, payment_res);
 
         crow::json::wvalue res;
         res["id"] = payment_res.id;
@@ -40,7 +47,7 @@ auto PaymentController::create(const crow::request &req) -> crow::response
 
         if (payment_res.paid_at.has_value())
         {
-            res["paid_at"] = utils::time::time_point_to_string(payment_res.paid_at.value());
+            res["paid_at"] = utils::time::format_time(payment_res.paid_at.value(), utils::time::TimeFormat::iso8601);
         }
 
         if (payment_res.still_missing.has_value())
@@ -56,11 +63,18 @@ auto PaymentController::create(const crow::request &req) -> crow::response
     }
 }
 
-auto PaymentController::get(const int &payment_id) -> crow::response
+auto PaymentController::get(const crow::request &req, const int &payment_id) -> crow::response
 {
     try
     {
-        auto payment_res = services_->get_payment_by_id(payment_id);
+        auto found = services_->get_payment_by_id(payment_id);
+        if (!found)
+            return error_response(found.error());
+
+        const auto &payment_res = *found;
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response((int)HttpStatus::OK, payment_res);
 
         crow::json::wvalue res;
         res["id"] = payment_res.id;
@@ -70,7 +84,7 @@ auto PaymentController::get(const int &payment_id) -> crow::response
 
         if (payment_res.paid_at.has_value())
         {
-            res["paid_at"] = utils::time::time_point_to_string(payment_res.paid_at.value());
+            res["paid_at"] = utils::time::format_time(payment_res.paid_at.value(), utils::time::TimeFormat::iso8601);
         }
 
         return crow::response((int)(HttpStatus::OK), res);
@@ -81,9 +95,129 @@ auto PaymentController::get(const int &payment_id) -> crow::response
     }
 }
 
+namespace
+{
+
+// Aceita "YYYY-MM-DD" ou o horário completo de utils::time::parse_time (UTC sem fuso explícito)
+auto parse_date_param(const std::string &name, std::string value) -> std::chrono::system_clock::time_point
+{
+    if (value.size() == 10)
+    {
+        value += " 00:00:00";
+    }
+
+    std::chrono::system_clock::time_point tp;
+    if (!utils::time::parse_time(value, tp))
+    {
+        throw exceptions::BadRequestError("Invalid date for '" + name + "': " + value);
+    }
+
+    return tp;
+}
+
+// Cursor opaco: "<id>" ou "<paid_at epoch>:<id>" quando a paginação é por data
+auto parse_cursor(const std::string &cursor) -> models::PaymentCursor
+{
+    models::PaymentCursor result{};
+    const auto separator = cursor.find(':');
+
+    if (separator == std::string::npos)
+    {
+        result.id = utils::string_to_int_or_throw(cursor);
+        return result;
+    }
+
+    try
+    {
+        const auto epoch = std::stoll(cursor.substr(0, separator));
+        result.paid_at = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(epoch));
+    }
+    catch (const std::exception &)
+    {
+        throw exceptions::BadRequestError("Invalid cursor: " + cursor);
+    }
+
+    result.id = utils::string_to_int_or_throw(cursor.substr(separator + 1));
+    return result;
+}
+
+auto format_cursor(const models::PaymentCursor &cursor) -> std::string
+{
+    if (!cursor.paid_at.has_value())
+        return std::to_string(cursor.id);
+
+    return std::to_string(std::chrono::system_clock::to_time_t(*cursor.paid_at)) + ":" + std::to_string(cursor.id);
+}
+
+} // namespace
+
 auto PaymentController::list(const crow::request &req) -> crow::response
 {
-    return crow::response((int)HttpStatus::OK, "res");
+    try
+    {
+        models::PaymentFilters filters;
+
+        if (req.url_params.get("order_id"))
+            filters.order_id = utils::string_to_int_or_throw(req.url_params.get("order_id"));
+
+        if (req.url_params.get("method"))
+            filters.method = utils::string_to_payment_method(req.url_params.get("method"));
+
+        if (req.url_params.get("from"))
+            filters.paid_from = parse_date_param("from", req.url_params.get("from"));
+
+        if (req.url_params.get("to"))
+            filters.paid_to = parse_date_param("to", req.url_params.get("to"));
+
+        if (req.url_params.get("limit"))
+            filters.limit = utils::string_to_int_or_throw(req.url_params.get("limit"));
+
+        if (req.url_params.get("cursor"))
+            filters.after = parse_cursor(req.url_params.get("cursor"));
+
+        auto page_result = services_->get_all_payments(filters);
+        if (!page_result)
+            return error_response(page_result.error());
+
+        const auto &page = *page_result;
+
+        if (response_format(req) == BodyFormat::msgpack)
+        {
+            utils::msgpack::MsgPackWriter writer(32 + page.items.size() * 64);
+            writer.begin_map(2).key("data");
+            utils::msgpack::write(writer, page.items);
+
+            writer.key("next_cursor");
+            if (page.next_cursor.has_value())
+                writer.value(format_cursor(*page.next_cursor));
+            else
+                writer.null();
+
+            return msgpack_response((int)HttpStatus::OK, writer);
+        }
+
+        // Mesmo corpo do MessagePack, escrito direto no buffer pelo JsonWriter, sem árvore intermediária.
+        // A página (limit <= 1000) limita o corpo; o Crow não envia resposta dinâmica em chunks
+        utils::json::JsonWriter writer(32 + page.items.size() * 128);
+        writer.begin_object().key("data");
+        utils::json::write(writer, page.items);
+
+        writer.key("next_cursor");
+        if (page.next_cursor.has_value())
+            writer.value(format_cursor(*page.next_cursor));
+        else
+            writer.null();
+        writer.end_object();
+
+        crow::response res((int)HttpStatus::OK, writer.take());
+        res.set_header("Content-Type", "application/json");
+
+        return res;
+    }
+    catch (const exceptions::CustomError &e)
+    {
+        return crow::response(static_cast<int>(e.status_code()), e.to_json());
+    }
 }
 auto PaymentController::update(const crow::request &req, int &id) -> crow::response
 {
@@ -94,4 +228,103 @@ auto PaymentController::remove(const crow::request &req) -> crow::response
     return crow::response((int)HttpStatus::OK, "res");
 }
 
+
+auto PaymentController::confirm(const crow::request &req) -> crow::response
+{
+    try
+    {
+        // 1. Lê o corpo NDJSON linha a linha: {"payment_id": 1, "paid_at": "2025-01-01 10:00:00"}
+        std::vector<models::dto::PaymentConfirmationDTO> confirmations;
+        std::vector<models::dto::PaymentConfirmationResultDTO> rejected;
+
+        std::string_view body(req.body);
+        int line_number = 0;
+
+        while (!body.empty())
+        {
+            const auto newline = body.find('\n');
+            auto line = body.substr(0, newline);
+            body = (newline == std::string_view::npos) ? std::string_view{} : body.substr(newline + 1);
+            line_number++;
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            if (line.find_first_not_of(" \t") == std::string_view::npos)
+                continue;
+
+            // Direto no DTO pelo JsonFields, sem árvore; o erro fica na linha e o payment_id já lido vai junto
+            models::dto::PaymentConfirmationDTO dto{};
+
+            try
+            {
+                utils::json::JsonReader reader(line);
+                utils::json::read(reader, dto);
+                reader.finish();
+            }
+            catch (const exceptions::CustomError &e)
+            {
+                rejected.push_back({line_number, dto.payment_id, models::ConfirmationStatus::INVALID, std::nullopt, e.what()});
+                continue;
+            }
+
+            dto.line = line_number;
+            confirmations.push_back(dto);
+        }
+
+        if (confirmations.empty() && rejected.empty())
+        {
+            throw exceptions::BadRequestError("Empty confirmation file");
+        }
+
+        // 2. Aplica as confirmações em lotes
+        auto summary = services_->confirm_payments(confirmations);
+
+        summary.received += static_cast<int>(rejected.size());
+        summary.invalid += static_cast<int>(rejected.size());
+
+        if (!rejected.empty())
+        {
+            summary.results.insert(summary.results.end(), rejected.begin(), rejected.end());
+            std::sort(summary.results.begin(), summary.results.end(), [](const auto &a, const auto &b) { return a.line < b.line; });
+        }
+
+        // 3. Resumo por linha
+        crow::json::wvalue res;
+        res["received"] = summary.received;
+        res["confirmed"] = summary.confirmed;
+        res["already_paid"] = summary.already_paid;
+        res["not_found"] = summary.not_found;
+        res["invalid"] = summary.invalid;
+        res["orders_paid"] = summary.orders_paid;
+
+        std::vector<crow::json::wvalue> results;
+        results.reserve(summary.results.size());
+
+        for (const auto &result : summary.results)
+        {
+            crow::json::wvalue item;
+            item["line"] = result.line;
+            item["payment_id"] = result.payment_id;
+            item["status"] = utils::confirmation_status_to_string(result.status);
+
+            if (result.order_id.has_value())
+                item["order_id"] = result.order_id.value();
+
+            if (result.error.has_value())
+                item["error"] = result.error.value();
+
+            results.push_back(std::move(item));
+        }
+
+        res["results"] = std::move(results);
+
+        return crow::response((int)HttpStatus::OK, res);
+    }
+    catch (const exceptions::CustomError &e)
+    {
+        return crow::response(static_cast<int>(e.status_code()), e.to_json());
+    }
+}
+
 } // namespace lynx::controller
\ No newline at end of file
@@ -1,41 +1,42 @@
 #include "controllers/product_controller.h"
+#include "controllers/content_negotiation.h"
+#include "controllers/error_response.h"
 #include "utils/convert.h"
 #include "utils/enums.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <iostream>
 
 namespace lynx::controller
 {
 
-ProductController::ProductController(std::shared_ptr<services::ProductServices> services)
+ProductController::ProductController(std::shared_ptr<services::ProductServices> services, std::shared_ptr<cache::ProductFragmentStore> fragments)
     : services_(services)
+    , fragments_(fragments)
 {
 }
 
 auto ProductController::register_routes(App &app) -> void
 {
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return this->create(req); });
-    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return this->get(id); });
-    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return this->list(req); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::POST)([this](const crow::request &req) { return negotiated(this->create(req)); });
+    app.route_dynamic(this->base_path_ + "/<int>").methods(crow::HTTPMethod::GET)([this](const crow::request &req, int id) { return negotiated(this->get(req, id)); });
+    app.route_dynamic(this->base_path_).methods(crow::HTTPMethod::GET)([this](const crow::request &req) { return negotiated(this->list(req)); });
+    app.route_dynamic(this->base_path_ + "/<int>/stock").methods(crow::HTTPMethod::POST)([this](const crow::request &req, int id) { return negotiated(this->adjust_stock(req, id)); });
 }
 
 auto ProductController::create(const crow::request &req) -> crow::response
 {
-    auto body = crow::json::load(req.body);
-    if (!body)
-    {
-        return crow::response((int)HttpStatus::BAD_REQUEST, "Invalid Json");
-    }
-
     try
     {
-        models::dto::ProductCreateDTO dto;
-        dto.name = body["name"].s();
-        dto.category = utils::string_to_category(body["category"].s());
-        dto.price_cents = body["price_cents"].i();
-        dto.active = body.has("active") ? body["active"].b() : true;
+        auto dto = parse_body<models::dto::ProductCreateDTO>(req);
+
+        auto created = services_->create_product(dto);
+        if (!created)
+            return error_response(created.error());
 
-        auto response_dto = services_->create_product(dto);
+        const auto &response_dto = *created;
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response(static_cast<int>(HttpStatus::CREATED), response_dto);
 
         crow::json::wvalue res;
         res["id"] = response_dto.id;
@@ -43,6 +44,10 @@ auto ProductController::create(const crow::request &req) -> crow::response
         res["category"] = utils::category_to_string(response_dto.category);
         res["price_cents"] = response_dto.price_cents;
         res["active"] = response_dto.active;
+        if (response_dto.stock)
+            res["stock"] = *response_dto.stock;
+        else
+            res["stock"] = nullptr;
 
         return crow::response(static_cast<int>(HttpStatus::CREATED), res);
     }
@@ -52,20 +57,24 @@ auto ProductController::create(const crow::request &req) -> crow::response
     }
 }
 
-auto ProductController::get(const int &id) -> crow::response
+auto ProductController::get(const crow::request &req, const int &id) -> crow::response
 {
     try
     {
         auto found_product = services_->get_product_by_id(id);
+        if (!found_product)
+        {
+            fragments_->forget(id);
+            return error_response(found_product.error());
+        }
 
-        crow::json::wvalue res;
-        res["id"] = found_product.id;
-        res["name"] = found_product.name;
-        res["category"] = utils::category_to_string(found_product.category);
-        res["price_cents"] = found_product.price_cents;
-        res["active"] = found_product.active;
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response(static_cast<int>(HttpStatus::OK), *found_product);
 
-        return crow::response(static_cast<int>(HttpStatus::OK), res);
+        crow::response res(static_cast<int>(HttpStatus::OK), fragments_->to_json(*found_product));
+        res.set_header("Content-Type", "application/json");
+
+        return res;
     }
     catch (const exceptions::CustomError &e)
     {
@@ -93,17 +102,38 @@ auto ProductController::list(const crow::request &req) -> crow::response
 
         auto products = services_->get_all_products(filters);
 
-        crow::json::wvalue res;
-        for (size_t i = 0; i < products.size(); ++i)
-        {
-            res[i]["id"] = products[i].id;
-            res[i]["name"] = products[i].name;
-            res[i]["category"] = utils::category_to_string(products[i].category);
-            res[i]["price_cents"] = products[i].price_cents;
-            res[i]["active"] = products[i].active;
-        }
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response(static_cast<int>(HttpStatus::OK), products, 5 + products.size() * 80);
 
-        return crow::response(static_cast<int>(HttpStatus::OK), res);
+        // Fragmentos prontos concatenados: só os produtos alterados desde a última resposta são formatados
+        crow::response res(static_cast<int>(HttpStatus::OK), fragments_->to_json(products));
+        res.set_header("Content-Type", "application/json");
+
+        return res;
+    }
+    catch (const exceptions::CustomError &e)
+    {
+        return crow::response(static_cast<int>(e.status_code()), e.to_json());
+    }
+}
+
+auto ProductController::adjust_stock(const crow::request &req, int id) -> crow::response
+{
+    try
+    {
+        auto dto = parse_body<models::dto::StockAdjustmentDTO>(req);
+
+        auto adjusted = services_->adjust_stock(id, dto);
+        if (!adjusted)
+            return error_response(adjusted.error());
+
+        if (response_format(req) == BodyFormat::msgpack)
+            return msgpack_response(static_cast<int>(HttpStatus::OK), *adjusted);
+
+        crow::response res(static_cast<int>(HttpStatus::OK), fragments_->to_json(*adjusted));
+        res.set_header("Content-Type", "application/json");
+
+        return res;
     }
     catch (const exceptions::CustomError &e)
     {
@@ -134,7 +164,11 @@ auto ProductController::update(const crow::request &req, int &id) -> crow::respo
         if (body.has("active"))
             dto.active = body["active"].b();
 
-        auto response_dto = services_->update_product(id, dto);
+        auto updated = services_->update_product(id, dto);
+        if (!updated)
+            return error_response(updated.error());
+
+        const auto &response_dto = *updated;
 
         crow::json::wvalue res;
         res["id"] = response_dto.id;
@@ -142,6 +176,10 @@ auto ProductController::update(const crow::request &req, int &id) -> crow::respo
         res["category"] = utils::category_to_string(response_dto.category);
         res["price_cents"] = response_dto.price_cents;
         res["active"] = response_dto.active;
+        if (response_dto.stock)
+            res["stock"] = *response_dto.stock;
+        else
+            res["stock"] = nullptr;
 
         return crow::response(static_cast<int>(HttpStatus::OK), res);
     }
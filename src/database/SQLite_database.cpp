@@ -8,7 +8,7 @@ namespace lynx::database
 SQLiteDatabase::SQLiteDatabase()
     : database_(nullptr)
 {
-    const std::string database_path = "C:\\Dev\\Lynx-api\\data\\lynx.db";
+    const auto &database_path = configured_path();
 
     if (sqlite3_open(database_path.c_str(), &database_) != SQLITE_OK)
     {
@@ -27,6 +27,18 @@ SQLiteDatabase::~SQLiteDatabase()
     };
 }
 
+auto SQLiteDatabase::configured_path() -> std::string &
+{
+    static std::string path = "C:\\Dev\\Lynx-api\\data\\lynx.db";
+
+    return path;
+}
+
+auto SQLiteDatabase::set_path(std::string path) -> void
+{
+    configured_path() = std::move(path);
+}
+
 auto SQLiteDatabase::get_instance() -> SQLiteDatabase &
 {
     static SQLiteDatabase instance;
@@ -39,4 +51,21 @@ auto SQLiteDatabase::get_connection() const -> sqlite3 *
     return database_;
 }
 
+auto SQLiteDatabase::stats() const -> DatabaseStats
+{
+    DatabaseStats stats{sqlite3_memory_used(), 0, 0, 0};
+
+    int current = 0;
+    int highwater = 0;
+
+    if (sqlite3_db_status(database_, SQLITE_DBSTATUS_CACHE_USED, &current, &highwater, 0) == SQLITE_OK)
+        stats.cache_used_bytes = current;
+    if (sqlite3_db_status(database_, SQLITE_DBSTATUS_CACHE_HIT, &current, &highwater, 0) == SQLITE_OK)
+        stats.cache_hits = current;
+    if (sqlite3_db_status(database_, SQLITE_DBSTATUS_CACHE_MISS, &current, &highwater, 0) == SQLITE_OK)
+        stats.cache_misses = current;
+
+    return stats;
+}
+
 } // namespace lynx::database
@@ -0,0 +1,140 @@
+#include "database/migrations.h"
+#include "database/transaction.h"
+#include "errors/http_handle_error.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace lynx::database
+{
+
+namespace
+{
+
+auto exec(sqlite3 *db, const char *sql) -> void
+{
+    if (sqlite3_exec(db, sql, nullptr, nullptr, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+}
+
+// Bancos criados pelo init.sql desde o estoque já têm a coluna; ALTER TABLE falharia neles
+auto products_without_stock(sqlite3 *db) -> bool
+{
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM pragma_table_info('products') WHERE name = 'stock'", -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+
+    const bool found = sqlite3_step(stmt) == SQLITE_ROW;
+
+    sqlite3_finalize(stmt);
+    return !found;
+}
+
+struct Migration
+{
+    const char *name;
+    const char *sql;
+    bool (*pending)(sqlite3 *db) = nullptr; // false: o schema já está como a migração deixaria, só registrar
+};
+
+// Só acrescentar no fim: o nome é a chave em schema_migrations
+constexpr Migration migrations_[] = {
+    // Datas gravadas antes do time_format em UTC estão na hora local do servidor que as escreveu.
+    // datetime(..., 'utc') converte pelo fuso desta máquina; valores que não são data ficam como estão
+    {"timestamps_utc", R"sql(
+        UPDATE customers SET created_at = datetime(created_at, 'utc') WHERE datetime(created_at, 'utc') IS NOT NULL;
+        UPDATE orders SET created_at = datetime(created_at, 'utc') WHERE datetime(created_at, 'utc') IS NOT NULL;
+        UPDATE payments SET paid_at = datetime(paid_at, 'utc') WHERE datetime(paid_at, 'utc') IS NOT NULL;
+    )sql"},
+    // NULL: estoque não controlado. Produtos que já existiam continuam vendendo sem limite até um
+    // POST /api/products/<id>/stock; um DEFAULT 0 os deixaria todos esgotados
+    {"products_stock", "ALTER TABLE products ADD COLUMN stock INTEGER;", products_without_stock},
+    // O write-back parte do último item já existente: vendas anteriores não descontam do estoque
+    {"inventory_checkpoint", R"sql(
+        CREATE TABLE IF NOT EXISTS inventory_checkpoint (
+          id INTEGER PRIMARY KEY CHECK (id = 1),
+          last_order_item_id INTEGER NOT NULL
+        );
+        INSERT OR IGNORE INTO inventory_checkpoint (id, last_order_item_id)
+        VALUES (1, (SELECT COALESCE(MAX(id), 0) FROM order_items));
+    )sql"},
+};
+
+auto create_table(sqlite3 *db) -> void
+{
+    exec(db, R"sql(
+        CREATE TABLE IF NOT EXISTS schema_migrations (
+          name TEXT PRIMARY KEY,
+          applied_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
+        )
+    )sql");
+}
+
+auto is_applied(sqlite3 *db, const char *name) -> bool
+{
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM schema_migrations WHERE name = ?", -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+
+    sqlite3_bind_text(stmt, 1, name, -1, SQLITE_STATIC);
+    const bool applied = sqlite3_step(stmt) == SQLITE_ROW;
+
+    sqlite3_finalize(stmt);
+    return applied;
+}
+
+auto mark_applied(sqlite3 *db, const char *name) -> void
+{
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "INSERT OR IGNORE INTO schema_migrations (name) VALUES (?)", -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+
+    sqlite3_bind_text(stmt, 1, name, -1, SQLITE_STATIC);
+    const auto rc = sqlite3_step(stmt);
+
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE)
+        throw std::runtime_error(sqlite3_errmsg(db));
+}
+
+} // namespace
+
+auto apply_migrations(sqlite3 *db) -> void
+{
+    const char *current = "schema_migrations";
+
+    try
+    {
+        create_table(db);
+
+        for (const auto &migration : migrations_)
+        {
+            current = migration.name;
+
+            Transaction transaction(db, "BEGIN IMMEDIATE TRANSACTION;");
+            if (is_applied(db, migration.name))
+                continue;
+
+            if (migration.pending == nullptr || migration.pending(db))
+                exec(db, migration.sql);
+            mark_applied(db, migration.name);
+            transaction.commit();
+
+            std::cerr << "Migration applied: " << migration.name << '\n';
+        }
+    }
+    catch (const std::exception &e)
+    {
+        throw exceptions::InternalServerError(std::string("Migration ") + current + " failed: " + e.what());
+    }
+}
+
+auto mark_migrations_applied(sqlite3 *db) -> void
+{
+    create_table(db);
+
+    for (const auto &migration : migrations_)
+        mark_applied(db, migration.name);
+}
+
+} // namespace lynx::database
@@ -0,0 +1,219 @@
+#include "database/query_cache.h"
+#include "metrics/metrics_registry.h"
+#include <algorithm>
+
+namespace lynx::database
+{
+
+namespace
+{
+
+// Nós do mapa e do LRU, além da chave (guardada nos dois) e do valor estimado pelo chamador
+constexpr size_t entry_overhead_ = 160;
+
+} // namespace
+
+auto table_from_name(std::string_view name) -> std::optional<Table>
+{
+    for (size_t i = 0; i < table_count_; ++i)
+    {
+        if (name == table_names_[i])
+            return static_cast<Table>(i);
+    }
+    return std::nullopt;
+}
+
+QueryCache::QueryCache(const QueryCacheConfig &config)
+    : config_(config)
+{
+    config_.shards = std::max<size_t>(config_.shards, 1);
+    shard_budget_ = config_.max_bytes / config_.shards;
+    shards_ = std::make_unique<Shard[]>(config_.shards);
+}
+
+QueryCache::~QueryCache()
+{
+    detach();
+}
+
+auto QueryCache::attach(sqlite3 *connection) -> void
+{
+    connections_.push_back(connection);
+    sqlite3_update_hook(connection, &QueryCache::on_update, this);
+    sqlite3_rollback_hook(connection, &QueryCache::on_rollback, this);
+}
+
+auto QueryCache::detach() -> void
+{
+    for (auto *connection : connections_)
+    {
+        sqlite3_update_hook(connection, nullptr, nullptr);
+        sqlite3_rollback_hook(connection, nullptr, nullptr);
+    }
+    connections_.clear();
+}
+
+auto QueryCache::config() const -> const QueryCacheConfig &
+{
+    return config_;
+}
+
+// Roda dentro do sqlite3_step de quem escreve: só um incremento atômico
+auto QueryCache::on_update(void *context, int operation, const char *database, const char *table, sqlite3_int64 rowid) -> void
+{
+    if (const auto known = table_from_name(table))
+        static_cast<QueryCache *>(context)->invalidate(*known);
+}
+
+auto QueryCache::on_rollback(void *context) -> void
+{
+    static_cast<QueryCache *>(context)->invalidate_all();
+}
+
+auto QueryCache::versions() const -> TableVersions
+{
+    TableVersions versions;
+    for (size_t i = 0; i < table_count_; ++i)
+        versions[i] = versions_[i].load(std::memory_order_acquire);
+
+    return versions;
+}
+
+auto QueryCache::invalidate(Table table) -> void
+{
+    versions_[static_cast<size_t>(table)].fetch_add(1, std::memory_order_acq_rel);
+}
+
+auto QueryCache::invalidate_all() -> void
+{
+    for (auto &version : versions_)
+        version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+auto QueryCache::shard_for(std::string_view key) -> Shard &
+{
+    return shards_[KeyHash{}(key) % config_.shards];
+}
+
+auto QueryCache::is_current(TableMask tables, const TableVersions &versions) const -> bool
+{
+    for (size_t i = 0; i < table_count_; ++i)
+    {
+        if ((tables & table_bit(static_cast<Table>(i))) && versions_[i].load(std::memory_order_acquire) != versions[i])
+            return false;
+    }
+    return true;
+}
+
+auto QueryCache::erase(Shard &shard, std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>::iterator it) -> void
+{
+    shard.bytes -= it->second.bytes;
+    shard.lru.erase(it->second.lru);
+    shard.entries.erase(it);
+}
+
+auto QueryCache::find(std::string_view key) -> std::shared_ptr<const void>
+{
+    auto &shard = shard_for(key);
+    std::lock_guard lock(shard.mutex);
+
+    const auto it = shard.entries.find(key);
+    if (it == shard.entries.end())
+        return nullptr;
+
+    auto &entry = it->second;
+
+    if (!is_current(entry.tables, entry.versions))
+    {
+        stale_.fetch_add(1, std::memory_order_relaxed);
+        erase(shard, it);
+        return nullptr;
+    }
+
+    if (config_.ttl.count() > 0 && Clock::now() - entry.stored_at > config_.ttl)
+    {
+        expired_.fetch_add(1, std::memory_order_relaxed);
+        erase(shard, it);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry.lru);
+    return entry.value;
+}
+
+auto QueryCache::store(std::string key, TableMask tables, const TableVersions &versions, std::shared_ptr<const void> value, size_t bytes)
+    -> void
+{
+    bytes += 2 * key.size() + entry_overhead_;
+
+    // Já velho (escrita durante a consulta) ou maior que o shard inteiro: não vale guardar
+    if (bytes > shard_budget_ || !is_current(tables, versions))
+        return;
+
+    auto &shard = shard_for(key);
+    std::lock_guard lock(shard.mutex);
+
+    if (const auto it = shard.entries.find(key); it != shard.entries.end())
+        erase(shard, it);
+
+    while (shard.bytes + bytes > shard_budget_ && !shard.lru.empty())
+    {
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+        erase(shard, shard.entries.find(shard.lru.back()));
+    }
+
+    shard.lru.push_front(key);
+    shard.bytes += bytes;
+    shard.entries.emplace(std::move(key), Entry{std::move(value), tables, versions, Clock::now(), bytes, shard.lru.begin()});
+}
+
+auto QueryCache::stats() -> QueryCacheStats
+{
+    QueryCacheStats stats;
+    stats.stale = stale_.load(std::memory_order_relaxed);
+    stats.expired = expired_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+    stats.versions = versions();
+
+    for (size_t i = 0; i < config_.shards; ++i)
+    {
+        std::lock_guard lock(shards_[i].mutex);
+        stats.entries += shards_[i].entries.size();
+        stats.bytes += shards_[i].bytes;
+    }
+
+    return stats;
+}
+
+auto QueryCache::clear() -> void
+{
+    for (size_t i = 0; i < config_.shards; ++i)
+    {
+        std::lock_guard lock(shards_[i].mutex);
+        shards_[i].entries.clear();
+        shards_[i].lru.clear();
+        shards_[i].bytes = 0;
+    }
+}
+
+auto QueryCache::render(std::string &out) -> void
+{
+    const auto current = stats();
+
+    metrics::write_header(out, "lynx_query_cache_invalidations_total", "counter", "Entradas descartadas do cache de consultas, por motivo.");
+    metrics::write_sample(out, "lynx_query_cache_invalidations_total", "reason=\"version\"", static_cast<int64_t>(current.stale));
+    metrics::write_sample(out, "lynx_query_cache_invalidations_total", "reason=\"ttl\"", static_cast<int64_t>(current.expired));
+    metrics::write_sample(out, "lynx_query_cache_invalidations_total", "reason=\"evicted\"", static_cast<int64_t>(current.evicted));
+    metrics::write_header(out, "lynx_query_cache_entries", "gauge", "Resultados guardados no cache de consultas.");
+    metrics::write_sample(out, "lynx_query_cache_entries", "", static_cast<int64_t>(current.entries));
+    metrics::write_header(out, "lynx_query_cache_bytes", "gauge", "Memória estimada dos resultados guardados.");
+    metrics::write_sample(out, "lynx_query_cache_bytes", "", static_cast<int64_t>(current.bytes));
+    metrics::write_header(out, "lynx_query_cache_table_version", "counter", "Versão de cada tabela: sobe a cada linha escrita e em todo rollback.");
+    for (size_t i = 0; i < table_count_; ++i)
+    {
+        metrics::write_sample(out, "lynx_query_cache_table_version", "table=\"" + std::string(table_names_[i]) + "\"",
+                              static_cast<int64_t>(current.versions[i]));
+    }
+}
+
+} // namespace lynx::database
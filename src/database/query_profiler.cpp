@@ -0,0 +1,361 @@
+#include "database/query_profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace lynx::database
+{
+
+namespace
+{
+
+constexpr std::string_view overflow_key = "<other>";
+
+struct OpenStatement
+{
+    sqlite3_stmt *stmt;
+    std::chrono::steady_clock::time_point started;
+    uint64_t rows;
+};
+
+// Statements em execução nesta thread; em geral um só, às vezes aninhados
+thread_local std::vector<OpenStatement> open_statements;
+
+// Os EXPLAIN da thread do log não entram nas estatísticas
+thread_local bool explaining = false;
+
+auto find_open(sqlite3_stmt *stmt) -> std::vector<OpenStatement>::iterator
+{
+    return std::find_if(open_statements.begin(), open_statements.end(), [stmt](const OpenStatement &open) { return open.stmt == stmt; });
+}
+
+auto stmt_counter(sqlite3_stmt *stmt, int op) -> uint64_t
+{
+    // Lê e zera: o mesmo statement pode ser executado de novo depois de um reset
+    return static_cast<uint64_t>(sqlite3_stmt_status(stmt, op, 1));
+}
+
+} // namespace
+
+auto normalize_sql(std::string_view sql) -> std::string
+{
+    std::string out;
+    out.reserve(sql.size());
+
+    bool pending_space = false;
+    for (const auto c : sql)
+    {
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+        {
+            pending_space = !out.empty();
+            continue;
+        }
+
+        if (pending_space)
+            out += ' ';
+        pending_space = false;
+        out += c;
+    }
+
+    return out;
+}
+
+QueryProfiler::QueryProfiler(const QueryProfilerConfig &config)
+    : config_(config)
+{
+}
+
+QueryProfiler::~QueryProfiler()
+{
+    stop();
+}
+
+auto QueryProfiler::attach(sqlite3 *connection) -> void
+{
+    if (!config_.enabled)
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        connections_.push_back(connection);
+    }
+
+    sqlite3_trace_v2(connection, SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &QueryProfiler::on_trace, this);
+}
+
+auto QueryProfiler::start() -> void
+{
+    if (!config_.enabled || worker_.joinable())
+        return;
+
+    stopping_ = false;
+    worker_ = std::thread([this] { run(); });
+}
+
+auto QueryProfiler::stop() -> void
+{
+    std::vector<sqlite3 *> connections;
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        connections.swap(connections_);
+    }
+    cv_.notify_all();
+
+    for (auto *connection : connections)
+    {
+        sqlite3_trace_v2(connection, 0, nullptr, nullptr);
+    }
+
+    if (worker_.joinable())
+        worker_.join();
+}
+
+auto QueryProfiler::on_trace(unsigned type, void *context, void *p, void *x) -> int
+{
+    if (explaining)
+        return 0;
+
+    auto *stmt = static_cast<sqlite3_stmt *>(p);
+
+    if (type == SQLITE_TRACE_STMT)
+    {
+        // Triggers disparam TRACE_STMT de novo com "-- <trigger>"; o relógio continua o do statement
+        const auto *text = static_cast<const char *>(x);
+        if (text && text[0] == '-' && text[1] == '-')
+            return 0;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (auto it = find_open(stmt); it != open_statements.end())
+            *it = OpenStatement{stmt, now, 0};
+        else
+            open_statements.push_back(OpenStatement{stmt, now, 0});
+        return 0;
+    }
+
+    if (type == SQLITE_TRACE_ROW)
+    {
+        if (auto it = find_open(stmt); it != open_statements.end())
+            ++it->rows;
+        return 0;
+    }
+
+    if (type == SQLITE_TRACE_PROFILE)
+    {
+        // O tempo do próprio SQLite tem resolução de milissegundos no unix; ele só é usado sem o início registrado
+        auto elapsed_ns = static_cast<uint64_t>(*static_cast<sqlite3_int64 *>(x));
+        uint64_t rows = 0;
+
+        if (auto it = find_open(stmt); it != open_statements.end())
+        {
+            elapsed_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - it->started).count());
+            rows = it->rows;
+            open_statements.erase(it);
+        }
+
+        static_cast<QueryProfiler *>(context)->on_profile(stmt, elapsed_ns, rows);
+    }
+
+    return 0;
+}
+
+auto QueryProfiler::on_profile(sqlite3_stmt *stmt, uint64_t elapsed_ns, uint64_t rows) -> void
+{
+    const auto fullscan_steps = stmt_counter(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP);
+    const auto sorts = stmt_counter(stmt, SQLITE_STMTSTATUS_SORT);
+    const auto autoindexes = stmt_counter(stmt, SQLITE_STMTSTATUS_AUTOINDEX);
+    const auto vm_steps = stmt_counter(stmt, SQLITE_STMTSTATUS_VM_STEP);
+
+    const char *sql = sqlite3_sql(stmt);
+    const std::string_view key = sql ? sql : "";
+
+    const auto slow = elapsed_ns >= static_cast<uint64_t>(std::chrono::nanoseconds(config_.slow_threshold).count());
+
+    // Com os valores dos parâmetros, só para o log; montado fora da trava
+    std::string expanded_sql;
+    if (slow)
+    {
+        if (char *expanded = sqlite3_expanded_sql(stmt))
+        {
+            expanded_sql = expanded;
+            sqlite3_free(expanded);
+        }
+        else
+        {
+            expanded_sql = std::string(key);
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+        const auto stored_key = entries_.size() < config_.max_statements ? key : overflow_key;
+
+        it = entries_.try_emplace(std::string(stored_key)).first;
+        if (it->second.sql.empty())
+            it->second.sql = stored_key == overflow_key ? std::string(overflow_key) : normalize_sql(key);
+    }
+
+    auto &entry = it->second;
+    ++entry.count;
+    entry.total_ns += elapsed_ns;
+    entry.max_ns = std::max(entry.max_ns, elapsed_ns);
+    entry.rows += rows;
+    entry.fullscan_steps += fullscan_steps;
+    entry.sorts += sorts;
+    entry.autoindexes += autoindexes;
+    entry.vm_steps += vm_steps;
+    entry.latency.record(elapsed_ns / 1000, true);
+
+    if (!slow)
+        return;
+
+    ++entry.slow_count;
+
+    if (slow_queue_.size() >= config_.max_pending_slow)
+    {
+        ++slow_dropped_;
+        return;
+    }
+
+    slow_queue_.push_back(SlowQuery{sqlite3_db_handle(stmt), std::string(key), std::move(expanded_sql), elapsed_ns, rows});
+    cv_.notify_one();
+}
+
+auto QueryProfiler::run() -> void
+{
+    while (true)
+    {
+        SlowQuery query;
+        std::optional<std::string> plan;
+
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !slow_queue_.empty(); });
+
+            if (stopping_)
+                return;
+
+            query = std::move(slow_queue_.front());
+            slow_queue_.pop_front();
+
+            if (auto it = entries_.find(query.key); it != entries_.end())
+                plan = it->second.plan;
+        }
+
+        // O plano é o mesmo para o mesmo SQL: só o primeiro lento de cada um paga o EXPLAIN
+        if (!plan.has_value())
+        {
+            plan = explain(query.connection, query.key);
+
+            std::lock_guard lock(mutex_);
+            if (auto it = entries_.find(query.key); it != entries_.end())
+                it->second.plan = plan;
+        }
+
+        std::cerr << "Slow query (" << static_cast<double>(query.elapsed_ns) / 1e6 << " ms, " << query.rows
+                  << " rows): " << normalize_sql(query.expanded_sql) << '\n'
+                  << *plan << '\n';
+    }
+}
+
+auto QueryProfiler::explain(sqlite3 *connection, const std::string &sql) -> std::string
+{
+    explaining = true;
+
+    const auto query = "EXPLAIN QUERY PLAN " + sql;
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(connection, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        explaining = false;
+        return std::string("  (EXPLAIN falhou: ") + sqlite3_errmsg(connection) + ")";
+    }
+
+    // Colunas: id, parent, notused, detail; a profundidade vem da cadeia de parents
+    std::vector<std::pair<int, int>> depths;
+    std::string plan;
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const auto id = sqlite3_column_int(stmt, 0);
+        const auto parent = sqlite3_column_int(stmt, 1);
+        const auto *detail = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
+
+        int depth = 0;
+        for (const auto &[known_id, known_depth] : depths)
+        {
+            if (known_id == parent)
+                depth = known_depth + 1;
+        }
+        depths.emplace_back(id, depth);
+
+        if (!plan.empty())
+            plan += '\n';
+        plan.append(static_cast<size_t>(depth + 1) * 2, ' ').append("- ").append(detail ? detail : "");
+    }
+
+    sqlite3_finalize(stmt);
+    explaining = false;
+
+    return plan.empty() ? "  (sem plano)" : plan;
+}
+
+auto QueryProfiler::snapshot() -> std::vector<QueryStats>
+{
+    std::lock_guard lock(mutex_);
+
+    std::vector<QueryStats> result;
+    result.reserve(entries_.size());
+
+    for (const auto &[key, entry] : entries_)
+    {
+        QueryStats stats;
+        stats.sql = entry.sql;
+        stats.count = entry.count;
+        stats.total_ns = entry.total_ns;
+        stats.max_ns = entry.max_ns;
+        stats.rows = entry.rows;
+        stats.fullscan_steps = entry.fullscan_steps;
+        stats.sorts = entry.sorts;
+        stats.autoindexes = entry.autoindexes;
+        stats.vm_steps = entry.vm_steps;
+        stats.slow_count = entry.slow_count;
+        stats.plan = entry.plan;
+
+        // p99 pelo histograma: limite superior do bucket que cruza 99% das execuções
+        const auto target = (entry.count * 99 + 99) / 100;
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < metrics::LatencyHistogram::bucket_count_; ++b)
+        {
+            cumulative += entry.latency.bucket(b);
+            if (cumulative >= target)
+            {
+                stats.p99_ns = std::min(metrics::LatencyHistogram::upper_bound(b) * 1000, entry.max_ns);
+                break;
+            }
+        }
+
+        result.push_back(std::move(stats));
+    }
+
+    return result;
+}
+
+auto QueryProfiler::slow_dropped() -> uint64_t
+{
+    std::lock_guard lock(mutex_);
+    return slow_dropped_;
+}
+
+auto QueryProfiler::reset() -> void
+{
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+    slow_dropped_ = 0;
+}
+
+} // namespace lynx::database
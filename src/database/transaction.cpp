@@ -0,0 +1,39 @@
+#include "database/transaction.h"
+#include <stdexcept>
+#include <string>
+
+namespace lynx::database
+{
+
+auto Transaction::mutex() -> std::mutex &
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+Transaction::Transaction(sqlite3 *db, const char *begin)
+    : db_(db)
+    , lock_(mutex())
+{
+    if (sqlite3_exec(db_, begin, nullptr, nullptr, nullptr) != SQLITE_OK)
+        throw std::runtime_error(std::string("BEGIN failed: ") + sqlite3_errmsg(db_));
+
+    open_ = true;
+}
+
+Transaction::~Transaction()
+{
+    if (open_)
+        sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+}
+
+auto Transaction::commit() -> void
+{
+    if (sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK)
+        throw std::runtime_error(std::string("COMMIT failed: ") + sqlite3_errmsg(db_));
+
+    open_ = false;
+}
+
+} // namespace lynx::database
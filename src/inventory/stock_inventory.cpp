@@ -0,0 +1,312 @@
+#include "inventory/stock_inventory.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <map>
+
+namespace lynx::inventory
+{
+
+StockCounter::StockCounter(int64_t stock)
+{
+    const auto share = stock / static_cast<int64_t>(stripe_count_);
+
+    for (auto &stripe : stripes_)
+    {
+        stripe.available.store(share, std::memory_order_relaxed);
+    }
+
+    stripes_[0].available.fetch_add(stock - share * static_cast<int64_t>(stripe_count_), std::memory_order_relaxed);
+}
+
+auto StockCounter::home_stripe() -> size_t
+{
+    thread_local const size_t stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % stripe_count_;
+    return stripe;
+}
+
+auto StockCounter::try_reserve(int64_t quantity) -> bool
+{
+    const auto home = home_stripe();
+    int64_t taken = 0;
+
+    for (size_t i = 0; i < stripe_count_ && taken < quantity; ++i)
+    {
+        auto &available = stripes_[(home + i) % stripe_count_].available;
+        auto current = available.load(std::memory_order_relaxed);
+
+        while (current > 0)
+        {
+            const auto take = std::min(current, quantity - taken);
+            if (available.compare_exchange_weak(current, current - take, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                taken += take;
+                break;
+            }
+        }
+    }
+
+    if (taken == quantity)
+        return true;
+
+    // Saldo insuficiente: devolve o que foi tirado das faixas
+    if (taken > 0)
+        release(taken);
+
+    return false;
+}
+
+auto StockCounter::release(int64_t quantity) -> void
+{
+    stripes_[home_stripe()].available.fetch_add(quantity, std::memory_order_acq_rel);
+}
+
+auto StockCounter::available() const -> int64_t
+{
+    int64_t total = 0;
+    for (const auto &stripe : stripes_)
+    {
+        total += stripe.available.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+StockInventory::StockInventory(std::shared_ptr<repository::interface::IInventoryRepository> repository, const InventoryConfig &config)
+    : repository_(repository)
+    , config_(config)
+{
+}
+
+StockInventory::~StockInventory()
+{
+    stop();
+}
+
+auto StockInventory::counter_for(int product_id) -> StockCounter *
+{
+    {
+        std::shared_lock lock(counters_mutex_);
+        if (auto it = counters_.find(product_id); it != counters_.end())
+            return it->second.get();
+    }
+
+    // Produto criado depois do start(): nenhuma venda dele passou por aqui, o banco está em dia.
+    // Sem estoque controlado fica registrado como nullptr, para não voltar ao banco a cada pedido
+    std::unique_lock lock(counters_mutex_);
+    if (auto it = counters_.find(product_id); it != counters_.end())
+        return it->second.get();
+
+    auto stock = repository_->find_stock(product_id);
+    auto [it, inserted] = counters_.emplace(product_id, stock ? std::make_unique<StockCounter>(*stock) : nullptr);
+    return it->second.get();
+}
+
+auto StockInventory::start() -> void
+{
+    if (worker_.joinable())
+        return;
+
+    // Reconciliação: aplica as vendas que ficaram sem write-back (ex.: crash) antes de ler o estoque
+    flush();
+
+    {
+        std::unique_lock lock(counters_mutex_);
+        counters_.clear();
+
+        for (const auto &product : repository_->find_all_stock())
+        {
+            counters_.emplace(product.product_id, std::make_unique<StockCounter>(product.stock));
+        }
+    }
+
+    stopping_ = false;
+    worker_ = std::thread([this] { run(); });
+}
+
+auto StockInventory::stop() -> void
+{
+    {
+        std::lock_guard lock(worker_mutex_);
+        stopping_ = true;
+    }
+    stop_cv_.notify_all();
+
+    if (!worker_.joinable())
+        return;
+
+    worker_.join();
+
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Inventory write-back failed: " << e.what() << '\n';
+    }
+}
+
+auto StockInventory::try_reserve(const std::vector<models::OrderItem> &items) -> std::optional<int>
+{
+    // Um mesmo produto pode aparecer em mais de um item
+    std::map<int, int64_t> quantities;
+    for (const auto &item : items)
+    {
+        quantities[item.product_id] += item.quantity;
+    }
+
+    std::vector<std::pair<StockCounter *, int64_t>> reserved;
+    reserved.reserve(quantities.size());
+
+    for (const auto &[product_id, quantity] : quantities)
+    {
+        // Existência do produto já validada por quem chama; sem contador não há o que reservar
+        auto counter = counter_for(product_id);
+        if (counter == nullptr)
+            continue;
+
+        if (!counter->try_reserve(quantity))
+        {
+            for (const auto &[reserved_counter, reserved_quantity] : reserved)
+            {
+                reserved_counter->release(reserved_quantity);
+            }
+            return product_id;
+        }
+
+        reserved.emplace_back(counter, quantity);
+    }
+
+    return std::nullopt;
+}
+
+auto StockInventory::release(const std::vector<models::OrderItem> &items) -> void
+{
+    for (const auto &item : items)
+    {
+        if (auto counter = counter_for(item.product_id))
+            counter->release(item.quantity);
+    }
+}
+
+auto StockInventory::restock_orders(const std::vector<int> &order_ids) -> void
+{
+    const auto deltas = repository_->sum_items_by_orders(order_ids);
+
+    std::lock_guard lock(restocks_mutex_);
+
+    for (const auto &delta : deltas)
+    {
+        if (auto counter = counter_for(delta.product_id))
+            counter->release(delta.quantity);
+
+        pending_restocks_[delta.product_id] += delta.quantity;
+    }
+}
+
+auto StockInventory::available(int product_id) -> std::optional<int64_t>
+{
+    auto counter = counter_for(product_id);
+    if (counter == nullptr)
+        return std::nullopt;
+
+    return counter->available();
+}
+
+auto StockInventory::adjust(int product_id, int64_t delta) -> bool
+{
+    // Fora de um write-back: o UPDATE lê o checkpoint que ele avança
+    std::lock_guard flush_lock(flush_mutex_);
+
+    auto counter = counter_for(product_id);
+
+    // A baixa sai do contador antes do banco, para nenhuma reserva concorrente vender o mesmo saldo
+    if (delta < 0 && (counter == nullptr || !counter->try_reserve(-delta)))
+        return false;
+
+    bool updated = false;
+    try
+    {
+        updated = repository_->adjust_stock(product_id, delta);
+    }
+    catch (...)
+    {
+        if (delta < 0)
+            counter->release(-delta);
+        throw;
+    }
+
+    if (!updated)
+    {
+        if (delta < 0)
+            counter->release(-delta);
+        return false;
+    }
+
+    if (counter == nullptr)
+    {
+        std::unique_lock lock(counters_mutex_);
+        counters_[product_id] = std::make_unique<StockCounter>(delta);
+    }
+    else if (delta > 0)
+    {
+        counter->release(delta);
+    }
+
+    return true;
+}
+
+auto StockInventory::flush() -> void
+{
+    std::lock_guard flush_lock(flush_mutex_);
+
+    std::vector<models::StockDelta> restocks;
+    {
+        std::lock_guard lock(restocks_mutex_);
+        restocks.reserve(pending_restocks_.size());
+
+        for (const auto &[product_id, quantity] : pending_restocks_)
+        {
+            restocks.push_back({product_id, quantity});
+        }
+        pending_restocks_.clear();
+    }
+
+    try
+    {
+        repository_->write_back(restocks);
+    }
+    catch (...)
+    {
+        // Reposições voltam para a fila e entram no próximo write-back
+        std::lock_guard lock(restocks_mutex_);
+        for (const auto &restock : restocks)
+        {
+            pending_restocks_[restock.product_id] += restock.quantity;
+        }
+        throw;
+    }
+}
+
+auto StockInventory::run() -> void
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(worker_mutex_);
+            if (stop_cv_.wait_for(lock, config_.flush_interval, [this] { return stopping_; }))
+                return;
+        }
+
+        try
+        {
+            flush();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Inventory write-back failed: " << e.what() << '\n';
+        }
+    }
+}
+
+} // namespace lynx::inventory
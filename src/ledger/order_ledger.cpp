@@ -0,0 +1,191 @@
+#include "ledger/order_ledger.h"
+#include <string>
+
+namespace lynx::ledger
+{
+
+OrderLedger::OrderLedger(std::shared_ptr<repository::interface::IOrderRepository> order_repository,
+                         std::shared_ptr<repository::interface::IPaymentRepository> payment_repository)
+    : order_repository_(order_repository)
+    , payment_repository_(payment_repository)
+{
+}
+
+auto OrderLedger::shard_for(int order_id) -> Shard &
+{
+    return shards_[static_cast<uint32_t>(order_id) % shard_count_];
+}
+
+auto OrderLedger::load(int order_id) -> std::optional<OrderBalance>
+{
+    auto order = order_repository_->find_by_id(order_id);
+    if (!order.has_value())
+        return std::nullopt;
+
+    OrderBalance balance{0, 0, order->status};
+
+    for (const auto &item : order->items)
+    {
+        balance.total_cents += static_cast<int64_t>(item.quantity) * item.unit_price_cents;
+    }
+
+    balance.paid_cents = payment_repository_->sum_by_order(order_id);
+
+    return balance;
+}
+
+auto OrderLedger::find_locked(Shard &shard, int order_id) -> std::optional<OrderBalance>
+{
+    if (auto it = shard.entries.find(order_id); it != shard.entries.end())
+    {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
+    // O carregamento acontece com o shard travado para que nenhuma escrita concorrente
+    // do mesmo pedido se perca entre a leitura do banco e a inserção
+    auto balance = load(order_id);
+    if (balance.has_value() && balance->status == models::OrderStatus::NEW)
+    {
+        shard.entries.emplace(order_id, *balance);
+    }
+
+    return balance;
+}
+
+auto OrderLedger::get(int order_id) -> std::optional<OrderBalance>
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    return find_locked(shard, order_id);
+}
+
+auto OrderLedger::on_order_created(int order_id, int64_t total_cents) -> void
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    shard.entries.insert_or_assign(order_id, OrderBalance{total_cents, 0, models::OrderStatus::NEW});
+}
+
+auto OrderLedger::try_apply_payment(int order_id, int64_t amount_cents) -> errors::Result<OrderBalance>
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    const auto balance = find_locked(shard, order_id);
+    if (!balance.has_value())
+        return errors::not_found("Order not found for order id: " + std::to_string(order_id));
+
+    if (balance->status == models::OrderStatus::CANCELLED)
+        return errors::bad_request("Cannot pay a cancelled order");
+
+    const int64_t remaining = balance->remaining_cents();
+
+    if (balance->status != models::OrderStatus::NEW || remaining <= 0)
+        return errors::bad_request("This order is already fully paid");
+
+    if (amount_cents > remaining)
+        return errors::bad_request("Payment amount exceeds order total. Remaining: " + std::to_string(remaining) + " cents");
+
+    // NEW: find_locked deixou a entrada no shard
+    auto &entry = shard.entries.at(order_id);
+    entry.paid_cents += amount_cents;
+
+    return entry;
+}
+
+auto OrderLedger::revert_payment(int order_id, int64_t amount_cents) -> void
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    if (auto it = shard.entries.find(order_id); it != shard.entries.end())
+    {
+        it->second.paid_cents -= amount_cents;
+    }
+}
+
+auto OrderLedger::on_status_changed(int order_id, models::OrderStatus status) -> void
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.entries.find(order_id);
+    if (it == shard.entries.end())
+        return;
+
+    if (status == models::OrderStatus::NEW)
+    {
+        it->second.status = status;
+        return;
+    }
+
+    // Pedidos finalizados não recebem mais pagamentos
+    shard.entries.erase(it);
+}
+
+auto OrderLedger::invalidate(int order_id) -> void
+{
+    auto &shard = shard_for(order_id);
+    std::lock_guard lock(shard.mutex);
+
+    shard.entries.erase(order_id);
+}
+
+auto OrderLedger::stats() const -> LedgerStats
+{
+    LedgerStats stats{hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed), 0};
+
+    for (const auto &shard : shards_)
+    {
+        std::lock_guard lock(shard.mutex);
+        stats.entries += shard.entries.size();
+    }
+
+    return stats;
+}
+
+auto OrderLedger::verify(bool repair) -> std::vector<LedgerDrift>
+{
+    std::vector<LedgerDrift> drifts;
+
+    for (auto &shard : shards_)
+    {
+        std::lock_guard lock(shard.mutex);
+
+        for (auto it = shard.entries.begin(); it != shard.entries.end();)
+        {
+            auto database = load(it->first);
+
+            if (database.has_value() && *database == it->second)
+            {
+                ++it;
+                continue;
+            }
+
+            drifts.push_back({it->first, it->second, database});
+
+            if (!repair)
+            {
+                ++it;
+            }
+            else if (database.has_value() && database->status == models::OrderStatus::NEW)
+            {
+                it->second = *database;
+                ++it;
+            }
+            else
+            {
+                it = shard.entries.erase(it);
+            }
+        }
+    }
+
+    return drifts;
+}
+
+} // namespace lynx::ledger
@@ -1,22 +1,6 @@
-/* Controllers */
-#include "controllers/customer_controller.h"
-#include "controllers/order_controller.h"
-#include "controllers/payment_controller.h"
-#include "controllers/product_controller.h"
+#include "application.h"
 
-// Repositories
-#include "repository/customer_repository.h"
-#include "repository/order_repository.h"
-#include "repository/payment_repository.h"
-#include "repository/product_repository.h"
-
-// Services
-#include "services/customer_services.h"
-#include "services/order_services.h"
-#include "services/payment_services.h"
-#include "services/product_services.h"
-
-#include "server.h"
+#include <iostream>
 
 int main()
 {
@@ -24,49 +8,66 @@ int main()
 
     try
     {
+        app::ApplicationConfig config;
+
         // ======================
         // Server configuration
         // ======================
-        server::ServerConfig config;
-        config.port = 8000;
-        config.threads = 4;
-        config.log_level = "debug";
-        config.cors = true;
-        config.cors_origin = "*";
+        config.server.port = 8000;
+        config.server.threads = 4;
+        config.server.log_level = "info";
+        config.server.cors = true;
+        config.server.cors_origin = "*";
+        config.server.compression = true;
+        config.server.compression_level = 6;
+        config.server.compression_min_bytes = 1024;
 
-        auto server = std::make_unique<server::Server>(config);
+        // Limites de concorrência adaptativos (leitura/escrita); sem vaga a requisição recebe 503 com Retry-After
+        config.admission.read.initial_limit = 32;
+        config.admission.write.initial_limit = 8;
+        config.admission.retry_after = std::chrono::seconds(1);
 
-        // ======================
-        // Repositories
-        // ======================
-        auto customer_repository = std::make_shared<repository::CustomerRepository>();
-        auto product_repository = std::make_shared<repository::ProductRepository>();
-        auto order_repository = std::make_shared<repository::OrderRepository>();
-        auto payment_repository = std::make_shared<repository::PaymentRepository>();
+        // Tempo, linhas e contadores por SQL; execuções acima do limite são logadas com o EXPLAIN QUERY PLAN
+        config.profiler.slow_threshold = std::chrono::milliseconds(50);
 
-        // ======================
-        // Services
-        // ======================
-        auto customer_service = std::make_shared<services::CustomerServices>(customer_repository);
-        auto product_service = std::make_shared<services::ProductServices>(product_repository);
-        auto order_service = std::make_shared<services::OrderServices>(order_repository, product_repository, customer_repository);
-        auto payment_service = std::make_shared<services::PaymentServices>(payment_repository, order_service);
+        // Cache das leituras repetidas dos repositórios, invalidado pelas escritas em cada tabela
+        config.query_cache.enabled = true;
+        config.query_cache.max_bytes = 64 * 1024 * 1024;
+        config.query_cache.ttl = std::chrono::seconds(10);
 
-        // ======================
-        // Controllers (Handlers)
-        // ======================
-        server->add_handler(std::make_shared<controller::CustomerController>(customer_service));
+        // Leituras idênticas simultâneas de produtos e do resumo de pedidos viram uma só consulta
+        config.coalescing.enabled = true;
+        config.coalescing.products = true;
+        config.coalescing.orders_summary = true;
+
+        // Corpos prontos do detalhe de pedidos PAID/CANCELLED, por formato
+        config.order_details_cache.enabled = true;
+        config.order_details_cache.max_bytes = 32 * 1024 * 1024;
+        config.order_details_cache.shards = 16;
+
+        // JSON pronto de cada produto para /api/products; desligado, cada resposta formata tudo
+        config.product_fragments.enabled = true;
+        config.product_fragments.max_entries = 100000;
 
-        server->add_handler(std::make_shared<controller::ProductController>(product_service));
+        // Estoque (reservas em memória, write-back em lote)
+        config.inventory.flush_interval = std::chrono::milliseconds(500);
 
-        server->add_handler(std::make_shared<controller::OrderController>(order_service));
+        // Expiração de pedidos não pagos
+        config.expiry.enabled = true;
+        config.expiry.payment_deadline = std::chrono::hours(24);
+        config.expiry.tick = std::chrono::seconds(1);
+        config.expiry.batch_size = 1000;
 
-        server->add_handler(std::make_shared<controller::PaymentController>(payment_service));
+        // Captura de tráfego amostrado (NDJSON) para o lynx_replay; desligada por padrão
+        config.capture.enabled = false;
+        config.capture.path = "capture.ndjson";
+        config.capture.sample_every = 100;
 
         // ======================
         // Start server
         // ======================
-        server->start();
+        app::Application application(config);
+        application.run();
         return 0;
     }
     catch (const std::exception &e)
@@ -74,4 +75,4 @@ int main()
         std::cerr << e.what() << '\n';
         return -1;
     }
-}
\ No newline at end of file
+}
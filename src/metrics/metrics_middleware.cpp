@@ -0,0 +1,29 @@
+#include "metrics/metrics_middleware.h"
+
+namespace lynx::metrics
+{
+
+auto MetricsMiddleware::set_registry(std::shared_ptr<MetricsRegistry> registry) -> void
+{
+    registry_ = registry;
+}
+
+void MetricsMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!registry_)
+        return;
+
+    ctx.started_at = std::chrono::steady_clock::now();
+    registry_->request_started();
+}
+
+void MetricsMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    if (!registry_)
+        return;
+
+    const auto elapsed = std::chrono::steady_clock::now() - ctx.started_at;
+    registry_->request_finished(crow::method_name(req.method), req.url, res.code, elapsed);
+}
+
+} // namespace lynx::metrics
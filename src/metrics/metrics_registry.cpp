@@ -0,0 +1,419 @@
+#include "metrics/metrics_registry.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+
+namespace lynx::metrics
+{
+
+namespace
+{
+
+constexpr size_t max_path_length = 256;
+
+constexpr uint64_t fnv_offset = 14695981039346656037ull;
+constexpr uint64_t fnv_prime = 1099511628211ull;
+
+constexpr std::string_view int_placeholder = "<int>";
+
+auto fnv1a(uint64_t hash, char c) -> uint64_t
+{
+    return (hash ^ static_cast<unsigned char>(c)) * fnv_prime;
+}
+
+auto fnv1a(uint64_t hash, std::string_view text) -> uint64_t
+{
+    for (const auto c : text)
+    {
+        hash = fnv1a(hash, c);
+    }
+    return hash;
+}
+
+/*
+ * Hash da rota normalizada numa única passada e sem cópia: o estado do hash no início de cada segmento
+ * é guardado e, se o segmento for todo numérico, o hash volta a ele e recebe <int> no lugar dos dígitos.
+ */
+auto route_key(std::string_view method, std::string_view path) -> uint64_t
+{
+    auto hash = fnv1a(fnv1a(fnv_offset, method), ' ');
+    auto segment_start = hash;
+    size_t segment_length = 0;
+    bool numeric = true;
+
+    for (const auto c : path)
+    {
+        if (c != '/')
+        {
+            numeric = numeric && c >= '0' && c <= '9';
+            ++segment_length;
+            hash = fnv1a(hash, c);
+            continue;
+        }
+
+        if (numeric && segment_length > 0)
+            hash = fnv1a(segment_start, int_placeholder);
+
+        hash = fnv1a(hash, c);
+        segment_start = hash;
+        segment_length = 0;
+        numeric = true;
+    }
+
+    if (numeric && segment_length > 0)
+        hash = fnv1a(segment_start, int_placeholder);
+
+    return hash;
+}
+
+// Percorre o caminho já normalizado (segmentos só com dígitos viram <int>) sem copiá-lo
+template <typename Visitor> auto for_each_route_piece(std::string_view path, Visitor &&visit) -> void
+{
+    size_t start = 0;
+    bool numeric = true;
+
+    for (size_t i = 0; i <= path.size(); ++i)
+    {
+        if (i < path.size() && path[i] != '/')
+        {
+            numeric = numeric && path[i] >= '0' && path[i] <= '9';
+            continue;
+        }
+
+        const auto segment = path.substr(start, i - start);
+        visit(numeric && !segment.empty() ? int_placeholder : segment);
+
+        if (i == path.size())
+            break;
+
+        visit(std::string_view("/"));
+        start = i + 1;
+        numeric = true;
+    }
+}
+
+struct ShardSlot
+{
+    size_t index;
+    bool exclusive; // só esta thread escreve no shard
+};
+
+auto shard_slot() -> ShardSlot
+{
+    static std::atomic<size_t> next_shard{0};
+
+    // As primeiras threads ganham um shard só delas; as demais dividem o último, sempre com fetch_add
+    thread_local const ShardSlot slot = [] {
+        constexpr auto shared_shard = RouteMetrics::shard_count_ - 1;
+
+        const auto n = next_shard.fetch_add(1, std::memory_order_relaxed);
+        return n < shared_shard ? ShardSlot{n, true} : ShardSlot{shared_shard, false};
+    }();
+
+    return slot;
+}
+
+// Com shard exclusivo basta load + store (sem instrução travada); o leitor só precisa de valores não rasgados
+template <typename T> auto increment(std::atomic<T> &counter, T value, bool exclusive) -> void
+{
+    if (exclusive)
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    else
+        counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+auto escape_label(std::string_view value) -> std::string
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (const auto c : value)
+    {
+        if (c == '\\' || c == '"')
+            escaped += '\\';
+
+        if (c == '\n')
+            escaped += "\\n";
+        else
+            escaped += c;
+    }
+
+    return escaped;
+}
+
+auto format_seconds(uint64_t micros) -> std::string
+{
+    std::array<char, 32> buffer;
+    auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<double>(micros) / 1e6);
+    return std::string(buffer.data(), end);
+}
+
+} // namespace
+
+auto LatencyHistogram::bucket_for(uint64_t micros) -> size_t
+{
+    if (micros < sub_buckets_)
+        return static_cast<size_t>(micros);
+
+    micros = std::min(micros, (uint64_t{1} << (max_exponent_ + 1)) - 1);
+
+    const int exponent = std::bit_width(micros) - 1;
+    const auto sub_bucket = (micros >> (exponent - sub_bucket_bits_)) & (sub_buckets_ - 1);
+
+    return static_cast<size_t>((exponent - sub_bucket_bits_ + 1) * sub_buckets_ + sub_bucket);
+}
+
+auto LatencyHistogram::upper_bound(size_t bucket) -> uint64_t
+{
+    if (bucket < sub_buckets_)
+        return bucket + 1;
+
+    const int exponent = static_cast<int>(bucket / sub_buckets_) + sub_bucket_bits_ - 1;
+    const auto sub_bucket = bucket % sub_buckets_;
+
+    return (sub_buckets_ + sub_bucket + 1) << (exponent - sub_bucket_bits_);
+}
+
+auto LatencyHistogram::record(uint64_t micros, bool exclusive) -> void
+{
+    increment<uint64_t>(buckets_[bucket_for(micros)], 1, exclusive);
+    increment<uint64_t>(sum_micros_, micros, exclusive);
+}
+
+auto LatencyHistogram::bucket(size_t index) const -> uint64_t
+{
+    return buckets_[index].load(std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::sum_micros() const -> uint64_t
+{
+    return sum_micros_.load(std::memory_order_relaxed);
+}
+
+auto StatusSlots::slot_for(int status) -> size_t
+{
+    for (size_t i = 0; i < codes_.size(); ++i)
+    {
+        if (codes_[i] == status)
+            return i;
+    }
+
+    const auto status_class = std::clamp(status / 100, 1, 5);
+    return codes_.size() + static_cast<size_t>(status_class - 1);
+}
+
+auto StatusSlots::label(size_t slot) -> std::string
+{
+    if (slot < codes_.size())
+        return std::to_string(codes_[slot]);
+
+    return std::to_string(slot - codes_.size() + 1) + "xx";
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+    unmatched_.method = "ANY";
+    unmatched_.route = "<unmatched>";
+    unmatched_.key.store(1, std::memory_order_relaxed);
+    unmatched_.ready.store(true, std::memory_order_release);
+}
+
+auto MetricsRegistry::route_for(std::string_view method, std::string_view path) -> RouteMetrics &
+{
+    if (path.size() > max_path_length)
+        return unmatched_;
+
+    auto key = route_key(method, path);
+
+    if (key == 0)
+        key = 1;
+
+    for (size_t probe = 0; probe < route_capacity_; ++probe)
+    {
+        auto &entry = routes_[(key + probe) & (route_capacity_ - 1)];
+
+        auto current = entry.key.load(std::memory_order_acquire);
+        if (current == 0)
+        {
+            if (entry.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+            {
+                // Só a primeira requisição de cada rota aloca
+                entry.method = method;
+                for_each_route_piece(path, [&entry](std::string_view piece) { entry.route.append(piece); });
+                entry.ready.store(true, std::memory_order_release);
+                return entry;
+            }
+        }
+
+        if (current == key)
+        {
+            // Outra thread acabou de reservar a mesma rota e ainda está copiando os nomes
+            while (!entry.ready.load(std::memory_order_acquire))
+            {
+            }
+            return entry;
+        }
+    }
+
+    return unmatched_;
+}
+
+auto MetricsRegistry::request_started() -> void
+{
+    const auto slot = shard_slot();
+    increment<int64_t>(in_flight_[slot.index].value, 1, slot.exclusive);
+}
+
+auto MetricsRegistry::request_finished(std::string_view method, std::string_view path, int status, std::chrono::nanoseconds elapsed)
+    -> void
+{
+    const auto slot = shard_slot();
+    increment<int64_t>(in_flight_[slot.index].value, -1, slot.exclusive);
+
+    auto &entry = status == 404 ? unmatched_ : route_for(method, path);
+    auto &shard = entry.shards[slot.index];
+
+    increment<uint64_t>(shard.status[StatusSlots::slot_for(status)], 1, slot.exclusive);
+    shard.latency.record(static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count() / 1000)), slot.exclusive);
+}
+
+auto MetricsRegistry::add_collector(Collector collector) -> void
+{
+    std::lock_guard lock(collectors_mutex_);
+    collectors_.push_back(std::move(collector));
+}
+
+auto MetricsRegistry::render() -> std::string
+{
+    std::string out;
+    out.reserve(16 * 1024);
+
+    std::vector<const RouteMetrics *> routes;
+    routes.reserve(route_capacity_ + 1);
+
+    for (const auto &entry : routes_)
+    {
+        if (entry.ready.load(std::memory_order_acquire))
+            routes.push_back(&entry);
+    }
+    routes.push_back(&unmatched_);
+
+    std::vector<std::string> labels;
+    labels.reserve(routes.size());
+
+    for (const auto *entry : routes)
+    {
+        labels.push_back("method=\"" + escape_label(entry->method) + "\",route=\"" + escape_label(entry->route) + "\"");
+    }
+
+    write_header(out, "lynx_http_requests_total", "counter", "Requisições HTTP por rota, método e status.");
+    for (size_t i = 0; i < routes.size(); ++i)
+    {
+        for (size_t slot = 0; slot < StatusSlots::count_; ++slot)
+        {
+            uint64_t count = 0;
+            for (const auto &shard : routes[i]->shards)
+            {
+                count += shard.status[slot].load(std::memory_order_relaxed);
+            }
+
+            if (count == 0)
+                continue;
+
+            write_sample(out, "lynx_http_requests_total", labels[i] + ",status=\"" + StatusSlots::label(slot) + "\"",
+                         static_cast<int64_t>(count));
+        }
+    }
+
+    write_header(out, "lynx_http_request_duration_seconds", "histogram", "Latência das requisições HTTP por rota.");
+    for (size_t i = 0; i < routes.size(); ++i)
+    {
+        std::array<uint64_t, LatencyHistogram::bucket_count_> buckets{};
+        uint64_t sum_micros = 0;
+
+        for (const auto &shard : routes[i]->shards)
+        {
+            for (size_t b = 0; b < buckets.size(); ++b)
+            {
+                buckets[b] += shard.latency.bucket(b);
+            }
+            sum_micros += shard.latency.sum_micros();
+        }
+
+        write_histogram(out, "lynx_http_request_duration_seconds", labels[i], buckets, sum_micros);
+    }
+
+    int64_t in_flight = 0;
+    for (const auto &shard : in_flight_)
+    {
+        in_flight += shard.value.load(std::memory_order_relaxed);
+    }
+
+    write_header(out, "lynx_http_requests_in_flight", "gauge", "Requisições HTTP em andamento.");
+    write_sample(out, "lynx_http_requests_in_flight", "", in_flight);
+
+    std::lock_guard lock(collectors_mutex_);
+    for (const auto &collector : collectors_)
+    {
+        collector(out);
+    }
+
+    return out;
+}
+
+auto write_header(std::string &out, std::string_view name, std::string_view type, std::string_view help) -> void
+{
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+auto write_sample(std::string &out, std::string_view name, std::string_view labels, double value) -> void
+{
+    std::array<char, 32> buffer;
+    auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+
+    out.append(name);
+    if (!labels.empty())
+        out.append("{").append(labels).append("}");
+    out.append(" ").append(buffer.data(), end).append("\n");
+}
+
+auto write_sample(std::string &out, std::string_view name, std::string_view labels, int64_t value) -> void
+{
+    out.append(name);
+    if (!labels.empty())
+        out.append("{").append(labels).append("}");
+    out.append(" ").append(std::to_string(value)).append("\n");
+}
+
+auto write_histogram(std::string &out, std::string_view name, const std::string &labels,
+                     const std::array<uint64_t, LatencyHistogram::bucket_count_> &buckets, uint64_t sum_micros) -> void
+{
+    const std::string bucket_name = std::string(name) + "_bucket";
+    const std::string separator = labels.empty() ? "" : ",";
+
+    // Os buckets finos são somados e publicados só nas potências de 2, que coincidem com as bordas deles
+    uint64_t cumulative = 0;
+    std::string bucket_lines;
+
+    for (size_t b = 0; b < buckets.size(); ++b)
+    {
+        cumulative += buckets[b];
+
+        const auto upper = LatencyHistogram::upper_bound(b);
+        if (!std::has_single_bit(upper))
+            continue;
+
+        write_sample(bucket_lines, bucket_name, labels + separator + "le=\"" + format_seconds(upper) + "\"", static_cast<int64_t>(cumulative));
+    }
+
+    if (cumulative == 0)
+        return;
+
+    out.append(bucket_lines);
+    write_sample(out, bucket_name, labels + separator + "le=\"+Inf\"", static_cast<int64_t>(cumulative));
+    write_sample(out, std::string(name) + "_sum", labels, static_cast<double>(sum_micros) / 1e6);
+    write_sample(out, std::string(name) + "_count", labels, static_cast<int64_t>(cumulative));
+}
+
+} // namespace lynx::metrics
@@ -1,6 +1,6 @@
 #include "repository/customer_repository.h"
 #include "errors/http_handle_error.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <stdexcept>
 
 namespace lynx::repository
@@ -26,7 +26,7 @@ auto CustomerRepository::create(models::Customer &customer) -> void
     sqlite3_bind_text(stmt, 1, customer.name.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, customer.email.c_str(), -1, SQLITE_TRANSIENT);
 
-    const auto created_at_str = utils::time::time_point_to_string(customer.created_at);
+    const auto created_at_str = utils::time::format_time(customer.created_at, utils::time::TimeFormat::sql);
     sqlite3_bind_text(stmt, 3, created_at_str.c_str(), -1, SQLITE_TRANSIENT);
 
     if (sqlite3_step(stmt) != SQLITE_DONE)
@@ -64,7 +64,7 @@ auto CustomerRepository::find_by_id(int id) -> std::optional<models::Customer>
         customer.email = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
 
         std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-        customer.created_at = utils::time::string_to_time_point(created_at_str);
+        customer.created_at = utils::time::parse_time_or_throw(created_at_str);
 
         result = customer;
     }
@@ -101,7 +101,7 @@ auto CustomerRepository::find_by_email(const std::string &email) -> std::optiona
         customer.email = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
 
         std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-        customer.created_at = utils::time::string_to_time_point(created_at_str);
+        customer.created_at = utils::time::parse_time_or_throw(created_at_str);
 
         result = customer;
     }
@@ -0,0 +1,79 @@
+#include "repository/decorators/repository_instrumentation.h"
+
+namespace lynx::repository::decorators
+{
+
+namespace
+{
+
+template <typename Series>
+auto write_counter(std::string &out, const std::vector<Series> &series, std::string_view name, std::string_view help,
+                   std::atomic<uint64_t> MethodStats::*counter) -> void
+{
+    metrics::write_header(out, name, "counter", help);
+    for (const auto &[labels, stats] : series)
+    {
+        metrics::write_sample(out, name, labels, static_cast<int64_t>((stats->*counter).load(std::memory_order_relaxed)));
+    }
+}
+
+} // namespace
+
+RepositoryInstrumentation::RepositoryInstrumentation(std::string repository, std::span<const char *const> method_names)
+    : repository_(std::move(repository))
+    , method_names_(method_names.begin(), method_names.end())
+    , methods_(std::make_unique<MethodStats[]>(method_names.size()))
+{
+}
+
+auto RepositoryInstrumentation::record(MethodStats &stats, std::chrono::steady_clock::time_point started, uint64_t rows) -> void
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    if (rows > 0)
+        stats.rows.fetch_add(rows, std::memory_order_relaxed);
+    stats.latency.record(static_cast<uint64_t>(elapsed.count()), false);
+}
+
+auto RepositoryInstrumentation::render(std::string &out, std::span<const std::shared_ptr<RepositoryInstrumentation>> instrumentations)
+    -> void
+{
+    struct Series
+    {
+        std::string labels;
+        const MethodStats *stats;
+    };
+
+    std::vector<Series> series;
+    for (const auto &instrumentation : instrumentations)
+    {
+        for (size_t i = 0; i < instrumentation->method_names_.size(); ++i)
+        {
+            const auto &stats = instrumentation->methods_[i];
+            if (stats.calls.load(std::memory_order_relaxed) == 0)
+                continue;
+
+            series.push_back(
+                Series{"repository=\"" + instrumentation->repository_ + "\",method=\"" + instrumentation->method_names_[i] + "\"", &stats});
+        }
+    }
+
+    write_counter(out, series, "lynx_repository_calls_total", "Chamadas aos repositórios por método.", &MethodStats::calls);
+    write_counter(out, series, "lynx_repository_errors_total", "Chamadas aos repositórios que lançaram exceção.", &MethodStats::errors);
+    write_counter(out, series, "lynx_repository_rows_total", "Linhas devolvidas pelos repositórios por método.", &MethodStats::rows);
+
+    metrics::write_header(out, "lynx_repository_duration_seconds", "histogram", "Latência das chamadas aos repositórios.");
+    for (const auto &[labels, stats] : series)
+    {
+        std::array<uint64_t, metrics::LatencyHistogram::bucket_count_> buckets{};
+        for (size_t b = 0; b < buckets.size(); ++b)
+        {
+            buckets[b] = stats->latency.bucket(b);
+        }
+
+        metrics::write_histogram(out, "lynx_repository_duration_seconds", labels, buckets, stats->latency.sum_micros());
+    }
+}
+
+} // namespace lynx::repository::decorators
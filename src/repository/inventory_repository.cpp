@@ -0,0 +1,254 @@
+#include "repository/inventory_repository.h"
+#include "database/transaction.h"
+#include "errors/http_handle_error.h"
+#include "utils/convert.h"
+#include <stdexcept>
+#include <utility>
+
+namespace lynx::repository
+{
+
+namespace
+{
+
+/* (último order_item já descontado, maior order_item gravado) */
+auto read_watermark(sqlite3 *db) -> std::pair<int64_t, int64_t>
+{
+    const char *query = R"sql(
+        SELECT c.last_order_item_id, COALESCE((SELECT MAX(id) FROM order_items), c.last_order_item_id)
+        FROM inventory_checkpoint c
+        WHERE c.id = 1
+    )sql";
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+
+    if (sqlite3_step(stmt) != SQLITE_ROW)
+    {
+        sqlite3_finalize(stmt);
+        throw std::runtime_error("Inventory checkpoint not initialized");
+    }
+
+    std::pair<int64_t, int64_t> watermark{sqlite3_column_int64(stmt, 0), sqlite3_column_int64(stmt, 1)};
+
+    sqlite3_finalize(stmt);
+    return watermark;
+}
+
+} // namespace
+
+InventoryRepository::InventoryRepository()
+{
+}
+
+auto InventoryRepository::find_stock(int product_id) -> std::optional<int64_t>
+{
+    const auto db = get_db();
+    const char *query = "SELECT stock FROM products WHERE id = ? AND stock IS NOT NULL";
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_bind_int(stmt, 1, product_id);
+
+    std::optional<int64_t> result;
+
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        result = sqlite3_column_int64(stmt, 0);
+    }
+
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+auto InventoryRepository::find_all_stock() -> std::vector<models::ProductStock>
+{
+    const auto db = get_db();
+    const char *query = "SELECT id, stock FROM products WHERE stock IS NOT NULL";
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    std::vector<models::ProductStock> result;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        result.push_back({sqlite3_column_int(stmt, 0), sqlite3_column_int64(stmt, 1)});
+    }
+
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+auto InventoryRepository::sum_items_by_orders(const std::vector<int> &order_ids) -> std::vector<models::StockDelta>
+{
+    std::vector<models::StockDelta> result;
+
+    if (order_ids.empty())
+        return result;
+
+    const auto db = get_db();
+    const char *query = R"sql(
+        SELECT product_id, SUM(quantity)
+        FROM order_items
+        WHERE order_id IN (SELECT value FROM json_each(?))
+        GROUP BY product_id
+    )sql";
+
+    const auto ids = utils::ids_to_json_array(order_ids);
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_bind_text(stmt, 1, ids.c_str(), static_cast<int>(ids.size()), SQLITE_STATIC);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        result.push_back({sqlite3_column_int(stmt, 0), sqlite3_column_int64(stmt, 1)});
+    }
+
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+auto InventoryRepository::write_back(const std::vector<models::StockDelta> &restocks) -> void
+{
+    const auto db = get_db();
+
+    // As baixas vêm dos order_items gravados depois do checkpoint, na mesma transação que avança o checkpoint:
+    // se o processo cair antes do COMMIT, o próximo write_back reaplica exatamente as mesmas linhas
+    const char *sold_query = R"sql(
+        UPDATE products
+        SET stock = stock - (
+            SELECT SUM(oi.quantity)
+            FROM order_items oi
+            WHERE oi.product_id = products.id AND oi.id > ?1 AND oi.id <= ?2
+        )
+        WHERE id IN (SELECT product_id FROM order_items WHERE id > ?1 AND id <= ?2)
+    )sql";
+
+    const char *restock_query = "UPDATE products SET stock = stock + ? WHERE id = ?";
+    const char *checkpoint_query = "UPDATE inventory_checkpoint SET last_order_item_id = ? WHERE id = 1";
+
+    sqlite3_stmt *stmt = nullptr;
+
+    try
+    {
+        // Nada vendido nem reposto desde o último write-back: nem abre transação
+        if (restocks.empty())
+        {
+            const auto [from_item_id, to_item_id] = read_watermark(db);
+            if (to_item_id <= from_item_id)
+                return;
+        }
+
+        database::Transaction transaction(db, "BEGIN IMMEDIATE TRANSACTION;");
+
+        const auto [from_item_id, to_item_id] = read_watermark(db);
+
+        if (to_item_id > from_item_id)
+        {
+            if (sqlite3_prepare_v2(db, sold_query, -1, &stmt, nullptr) != SQLITE_OK)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            sqlite3_bind_int64(stmt, 1, from_item_id);
+            sqlite3_bind_int64(stmt, 2, to_item_id);
+
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+
+            if (sqlite3_prepare_v2(db, checkpoint_query, -1, &stmt, nullptr) != SQLITE_OK)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            sqlite3_bind_int64(stmt, 1, to_item_id);
+
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+        }
+
+        if (!restocks.empty())
+        {
+            if (sqlite3_prepare_v2(db, restock_query, -1, &stmt, nullptr) != SQLITE_OK)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            for (const auto &restock : restocks)
+            {
+                sqlite3_bind_int64(stmt, 1, restock.quantity);
+                sqlite3_bind_int(stmt, 2, restock.product_id);
+
+                if (sqlite3_step(stmt) != SQLITE_DONE)
+                    throw std::runtime_error(sqlite3_errmsg(db));
+
+                sqlite3_reset(stmt);
+            }
+
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+        }
+
+        transaction.commit();
+    }
+    catch (const std::exception &e)
+    {
+        // O ROLLBACK fica com o destrutor da transação, que já saiu de escopo
+        sqlite3_finalize(stmt);
+        throw exceptions::InternalServerError(std::string("Failed to write back inventory: ") + e.what());
+    }
+}
+
+auto InventoryRepository::adjust_stock(int product_id, int64_t delta) -> bool
+{
+    const auto db = get_db();
+
+    // Produto sem controle de estoque passa a ter: soma as vendas ainda sem write-back, que o próximo
+    // write_back vai descontar, para o saldo depois dele ser exatamente delta
+    const char *query = R"sql(
+        UPDATE products
+        SET stock = CASE
+            WHEN stock IS NOT NULL THEN stock + ?1
+            ELSE ?1 + COALESCE((
+                SELECT SUM(oi.quantity)
+                FROM order_items oi
+                WHERE oi.product_id = products.id
+                  AND oi.id > (SELECT last_order_item_id FROM inventory_checkpoint WHERE id = 1)
+            ), 0)
+        END
+        WHERE id = ?2
+    )sql";
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_bind_int64(stmt, 1, delta);
+    sqlite3_bind_int(stmt, 2, product_id);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE)
+    {
+        sqlite3_finalize(stmt);
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_finalize(stmt);
+    return sqlite3_changes(db) > 0;
+}
+
+} // namespace lynx::repository
@@ -1,7 +1,9 @@
 #include "repository/order_repository.h"
+#include "database/transaction.h"
 #include "errors/http_handle_error.h"
+#include "tracing/trace.h"
 #include "utils/convert.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <map>
 
 namespace lynx::repository
@@ -13,12 +15,14 @@ OrderRepository::OrderRepository()
 
 auto OrderRepository::create(models::Order &order) -> void
 {
-    const auto db = get_db();
+    LYNX_TRACE_SPAN("order_repository.create");
 
-    sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+    const auto db = get_db();
 
     try
     {
+        database::Transaction transaction(db);
+
         // 1. Insert order
         const char *order_query = "INSERT INTO orders (customer_id, status, created_at) VALUES (?, ?, ?)";
 
@@ -29,7 +33,7 @@ auto OrderRepository::create(models::Order &order) -> void
         sqlite3_bind_int(order_stmt, 1, order.customer_id);
         sqlite3_bind_text(order_stmt, 2, utils::order_status_to_string(order.status).c_str(), -1, SQLITE_TRANSIENT);
 
-        auto created_at_str = utils::time::time_point_to_string(order.created_at);
+        auto created_at_str = utils::time::format_time(order.created_at, utils::time::TimeFormat::sql);
 
         sqlite3_bind_text(order_stmt, 3, created_at_str.c_str(), -1, SQLITE_TRANSIENT);
 
@@ -62,17 +66,18 @@ auto OrderRepository::create(models::Order &order) -> void
             sqlite3_finalize(item_stmt);
         }
 
-        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        transaction.commit();
     }
     catch (...)
     {
-        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
         throw exceptions::InternalServerError("Failed to create order");
     }
 }
 
 auto OrderRepository::find_by_id(int id) -> std::optional<models::Order>
 {
+    LYNX_TRACE_SPAN("order_repository.find_by_id");
+
     auto const db = get_db();
     const char *query = R"sql(
         SELECT o.id AS order_id, o.customer_id, o.status, o.created_at,
@@ -103,7 +108,7 @@ auto OrderRepository::find_by_id(int id) -> std::optional<models::Order>
             order.status = utils::string_to_order_status(status_str);
 
             std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-            order.created_at = utils::time::string_to_time_point(created_at_str);
+            order.created_at = utils::time::parse_time_or_throw(created_at_str);
 
             order_created = true;
         }
@@ -131,6 +136,8 @@ auto OrderRepository::find_by_id(int id) -> std::optional<models::Order>
 
 auto OrderRepository::find_by_id_with_customer(int id) -> std::optional<models::Order>
 {
+    LYNX_TRACE_SPAN("order_repository.find_by_id_with_customer");
+
     const auto db = get_db();
     const char *query = "SELECT "
                         "  o.id AS order_id, "
@@ -165,18 +172,18 @@ auto OrderRepository::find_by_id_with_customer(int id) -> std::optional<models::
         order.status = utils::string_to_order_status(status_str);
 
         std::string order_created_at = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-        order.created_at = utils::time::string_to_time_point(order_created_at);
+        order.created_at = utils::time::parse_time_or_throw(order_created_at);
 
         // Customer
         models::Customer customer;
-        customer.id = sqlite3_column_int(stmt, 4);
+        customer.id = order.customer_id;
 
-        customer.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 5));
+        customer.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 4));
 
-        customer.email = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 6));
+        customer.email = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 5));
 
-        std::string customer_created_at = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 7));
-        customer.created_at = utils::time::string_to_time_point(customer_created_at);
+        std::string customer_created_at = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 6));
+        customer.created_at = utils::time::parse_time_or_throw(customer_created_at);
 
         order.customer = customer;
         result = order;
@@ -209,7 +216,7 @@ auto OrderRepository::find_all() -> std::vector<models::Order>
         order.status = utils::string_to_order_status(status_str);
 
         std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt_order, 3));
-        order.created_at = utils::time::string_to_time_point(created_at_str);
+        order.created_at = utils::time::parse_time_or_throw(created_at_str);
 
         // --- Busca os itens desse pedido ---
         sqlite3_stmt *stmt_items = nullptr;
@@ -238,9 +245,39 @@ auto OrderRepository::find_all() -> std::vector<models::Order>
     return orders;
 }
 
+auto OrderRepository::find_pending_deadlines() -> std::vector<models::PendingOrder>
+{
+    const auto db = get_db();
+    const char *query = "SELECT id, created_at FROM orders WHERE status = 'NEW'";
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    std::vector<models::PendingOrder> orders;
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        models::PendingOrder order;
+        order.id = sqlite3_column_int(stmt, 0);
+
+        std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        order.created_at = utils::time::parse_time_or_throw(created_at_str);
+
+        orders.push_back(order);
+    }
+
+    sqlite3_finalize(stmt);
+    return orders;
+}
+
 auto OrderRepository::find_all_summary(const std::optional<std::string> &status_filter, const std::optional<int> &customer_id_filter,
                                        const std::optional<int> &limit) -> std::vector<models::OrderSummary>
 {
+    LYNX_TRACE_SPAN("order_repository.find_all_summary");
+
     const auto db = get_db();
     sqlite3_stmt *stmt = nullptr;
 
@@ -307,7 +344,7 @@ auto OrderRepository::find_all_summary(const std::optional<std::string> &status_
         order.status = utils::string_to_order_status(status_str);
 
         std::string created_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-        order.created_at = utils::time::string_to_time_point(created_at_str);
+        order.created_at = utils::time::parse_time_or_throw(created_at_str);
 
         order.total_cents = sqlite3_column_int64(stmt, 4);
         order.total_paid_cents = sqlite3_column_int64(stmt, 5);
@@ -323,8 +360,10 @@ auto OrderRepository::update(const int &id, const models::Order &Order) -> void
 {
 }
 
-auto OrderRepository::update_status(int order_id, const models::OrderStatus &status) -> void
+auto OrderRepository::update_status(int order_id, const models::OrderStatus &status) -> errors::Result<void>
 {
+    LYNX_TRACE_SPAN("order_repository.update_status");
+
     const auto db = get_db();
     const char *query = "UPDATE orders SET status = ? WHERE id = ?";
     sqlite3_stmt *stmt = nullptr;
@@ -349,10 +388,116 @@ auto OrderRepository::update_status(int order_id, const models::OrderStatus &sta
     if (sqlite3_changes(db) == 0)
     {
         sqlite3_finalize(stmt);
-        throw exceptions::NotFoundError("Order not found: id = " + std::to_string(order_id));
+        return errors::not_found("Order not found: id = " + std::to_string(order_id));
+    }
+
+    sqlite3_finalize(stmt);
+    return {};
+}
+
+auto OrderRepository::mark_settled_as_paid(const std::vector<int> &order_ids) -> std::vector<int>
+{
+    std::vector<int> paid;
+
+    if (order_ids.empty())
+        return paid;
+
+    const auto db = get_db();
+
+    // Um único UPDATE para todos os pedidos afetados: os ids chegam como array JSON
+    const char *query = R"sql(
+        UPDATE orders
+        SET status = 'PAID'
+        WHERE status = 'NEW'
+          AND id IN (SELECT value FROM json_each(?))
+          AND (
+              SELECT COALESCE(SUM(p.amount_cents), 0)
+              FROM payments p
+              WHERE p.order_id = orders.id AND p.paid_at IS NOT NULL
+          ) >= (
+              SELECT COALESCE(SUM(oi.quantity * oi.unit_price_cents), 0)
+              FROM order_items oi
+              WHERE oi.order_id = orders.id
+          )
+        RETURNING id
+    )sql";
+
+    const auto ids = utils::ids_to_json_array(order_ids);
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_bind_text(stmt, 1, ids.c_str(), static_cast<int>(ids.size()), SQLITE_STATIC);
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        paid.push_back(sqlite3_column_int(stmt, 0));
+    }
+
+    if (rc != SQLITE_DONE)
+    {
+        sqlite3_finalize(stmt);
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
     }
 
     sqlite3_finalize(stmt);
+    return paid;
+}
+
+auto OrderRepository::cancel_expired(const std::vector<int> &order_ids, const std::chrono::system_clock::time_point &created_before)
+    -> std::vector<int>
+{
+    std::vector<int> cancelled;
+
+    if (order_ids.empty())
+        return cancelled;
+
+    const auto db = get_db();
+
+    // Só cancela o que continua NEW e realmente venceu: pagamentos concluídos depois do agendamento vencem a corrida.
+    // Pedido com algum pagamento (parcial) não expira: cancelá-lo deixaria o dinheiro registrado num pedido
+    // cancelado; ele segue NEW, pagável até o total
+    const char *query = R"sql(
+        UPDATE orders
+        SET status = 'CANCELLED'
+        WHERE status = 'NEW'
+          AND created_at <= ?
+          AND id IN (SELECT value FROM json_each(?))
+          AND NOT EXISTS (SELECT 1 FROM payments p WHERE p.order_id = orders.id)
+        RETURNING id
+    )sql";
+
+    const auto ids = utils::ids_to_json_array(order_ids);
+
+    const auto created_before_str = utils::time::format_time(created_before, utils::time::TimeFormat::sql);
+
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_bind_text(stmt, 1, created_before_str.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, ids.c_str(), static_cast<int>(ids.size()), SQLITE_STATIC);
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        cancelled.push_back(sqlite3_column_int(stmt, 0));
+    }
+
+    if (rc != SQLITE_DONE)
+    {
+        sqlite3_finalize(stmt);
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    sqlite3_finalize(stmt);
+    return cancelled;
 }
 
 auto OrderRepository::remove(int id) -> void
@@ -362,6 +507,8 @@ auto OrderRepository::remove(int id) -> void
 /* Order Items */
 auto OrderRepository::find_items_by_order_id(int order_id) -> std::vector<models::OrderItem>
 {
+    LYNX_TRACE_SPAN("order_repository.find_items_by_order_id");
+
     const auto db = get_db();
     const char *query = "SELECT id, order_id, product_id, quantity, unit_price_cents "
                         "FROM order_items WHERE order_id = ?";
@@ -410,9 +557,10 @@ auto OrderRepository::sum_items_total_by_order(int order_id) -> int64_t
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
-        total = sqlite3_column_int(stmt, 0);
+        total = sqlite3_column_int64(stmt, 0);
     }
 
+    sqlite3_finalize(stmt);
     return total;
 }
 
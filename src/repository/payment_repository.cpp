@@ -1,8 +1,10 @@
 #include "repository/payment_repository.h"
+#include "database/transaction.h"
 #include "errors/http_handle_error.h"
 #include "utils/convert.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <stdexcept>
+#include <variant>
 
 namespace lynx::repository
 {
@@ -14,9 +16,12 @@ PaymentRepository::PaymentRepository()
 auto PaymentRepository::create(models::Payment &payment) -> void
 {
     const auto db = get_db();
+
+    // Só grava em pedido ainda NEW: a expiração pode ter cancelado o pedido depois que o ledger conferiu o status
     const char *query = R"(
         INSERT INTO payments (order_id, method, amount_cents, paid_at)
-        VALUES (?, ?, ?, ?)
+        SELECT ?1, ?2, ?3, ?4
+        WHERE EXISTS (SELECT 1 FROM orders WHERE id = ?1 AND status = 'NEW')
     )";
 
     sqlite3_stmt *stmt = nullptr;
@@ -34,7 +39,7 @@ auto PaymentRepository::create(models::Payment &payment) -> void
 
     if (payment.paid_at.has_value()) // verifica se existe valor
     {
-        const auto paid_at_str = utils::time::time_point_to_string(*payment.paid_at);
+        const auto paid_at_str = utils::time::format_time(*payment.paid_at, utils::time::TimeFormat::sql);
         sqlite3_bind_text(stmt, 4, paid_at_str.c_str(), -1, SQLITE_TRANSIENT);
     }
     else
@@ -50,6 +55,9 @@ auto PaymentRepository::create(models::Payment &payment) -> void
 
     sqlite3_finalize(stmt);
 
+    if (sqlite3_changes(db) == 0)
+        throw exceptions::ConflictError("Order is no longer open for payment");
+
     payment.id = static_cast<int>(sqlite3_last_insert_rowid(db));
 }
 
@@ -81,7 +89,7 @@ auto PaymentRepository::find_by_id(int id) -> std::optional<models::Payment>
         if (sqlite3_column_type(stmt, 4) != SQLITE_NULL)
         {
             std::string paid_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 4));
-            payment.paid_at = utils::time::string_to_time_point(paid_at_str);
+            payment.paid_at = utils::time::parse_time_or_throw(paid_at_str);
         }
 
         result = payment;
@@ -91,18 +99,77 @@ auto PaymentRepository::find_by_id(int id) -> std::optional<models::Payment>
     return result;
 }
 
-auto PaymentRepository::find_all() -> std::vector<models::Payment>
+auto PaymentRepository::find_all(const models::PaymentFilters &filters) -> std::vector<models::Payment>
 {
     const auto db = get_db();
-    const char *query = "SELECT id, order_id, method, amount_cents, paid_at FROM payments";
+    std::string query = "SELECT id, order_id, method, amount_cents, paid_at FROM payments WHERE 1=1";
+    std::vector<std::variant<int, std::string>> params; // na ordem dos placeholders
+
+    auto bind_int = [&](int value) { params.emplace_back(value); };
+    auto bind_text = [&](std::string value) { params.emplace_back(std::move(value)); };
+
+    // Intervalos de data sem order_id são paginados por (paid_at, id) para usar idx_payments_paid_at /
+    // idx_payments_method_paid_at como range scan; os demais filtros paginam pela chave primária
+    const bool by_paid_at = filters.pages_by_paid_at();
+
+    if (filters.order_id.has_value())
+    {
+        query += " AND order_id = ?";
+        bind_int(filters.order_id.value());
+    }
+    if (filters.method.has_value())
+    {
+        query += " AND method = ?";
+        bind_text(utils::payment_method_to_string(filters.method.value()));
+    }
+    if (filters.paid_from.has_value())
+    {
+        query += " AND paid_at >= ?";
+        bind_text(utils::time::format_time(filters.paid_from.value(), utils::time::TimeFormat::sql));
+    }
+    if (filters.paid_to.has_value())
+    {
+        query += " AND paid_at < ?";
+        bind_text(utils::time::format_time(filters.paid_to.value(), utils::time::TimeFormat::sql));
+    }
+
+    if (filters.after.has_value())
+    {
+        // O service recusa cursor de uma paginação usado na outra
+        if (by_paid_at)
+        {
+            query += " AND (paid_at, id) > (?, ?)";
+            bind_text(utils::time::format_time(filters.after->paid_at.value(), utils::time::TimeFormat::sql));
+            bind_int(filters.after->id);
+        }
+        else
+        {
+            query += " AND id > ?";
+            bind_int(filters.after->id);
+        }
+    }
+
+    query += by_paid_at ? " ORDER BY paid_at, id" : " ORDER BY id";
+    query += " LIMIT ?";
+    bind_int(filters.limit);
 
     sqlite3_stmt *stmt = nullptr;
-    if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
+    if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
     {
         throw exceptions::InternalServerError(sqlite3_errmsg(db));
     }
 
+    int bind_index = 1;
+    for (const auto &param : params)
+    {
+        if (const auto *text = std::get_if<std::string>(&param))
+            sqlite3_bind_text(stmt, bind_index++, text->c_str(), -1, SQLITE_TRANSIENT);
+        else
+            sqlite3_bind_int(stmt, bind_index++, std::get<int>(param));
+    }
+
     std::vector<models::Payment> payments;
+    payments.reserve(static_cast<size_t>(filters.limit));
 
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -118,7 +185,7 @@ auto PaymentRepository::find_all() -> std::vector<models::Payment>
         if (sqlite3_column_type(stmt, 4) != SQLITE_NULL)
         {
             std::string paid_at_str = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 4));
-            payment.paid_at = utils::time::string_to_time_point(paid_at_str);
+            payment.paid_at = utils::time::parse_time_or_throw(paid_at_str);
         }
 
         payments.push_back(payment);
@@ -181,6 +248,90 @@ auto PaymentRepository::mark_as_paid(int payment_id, const std::string &paid_at)
     sqlite3_finalize(stmt);
 }
 
+auto PaymentRepository::mark_as_paid_batch(const std::vector<models::PaymentConfirmation> &confirmations)
+    -> std::vector<models::PaymentConfirmationResult>
+{
+    const auto db = get_db();
+
+    // O UPDATE e o SELECT de fallback são preparados uma única vez e reutilizados em todo o lote
+    const char *update_query = "UPDATE payments SET paid_at = ? WHERE id = ? AND paid_at IS NULL RETURNING order_id";
+    const char *lookup_query = "SELECT order_id FROM payments WHERE id = ?";
+
+    sqlite3_stmt *update_stmt = nullptr;
+    sqlite3_stmt *lookup_stmt = nullptr;
+
+    if (sqlite3_prepare_v2(db, update_query, -1, &update_stmt, nullptr) != SQLITE_OK)
+    {
+        throw exceptions::InternalServerError(sqlite3_errmsg(db));
+    }
+
+    if (sqlite3_prepare_v2(db, lookup_query, -1, &lookup_stmt, nullptr) != SQLITE_OK)
+    {
+        std::string error = sqlite3_errmsg(db);
+        sqlite3_finalize(update_stmt);
+        throw exceptions::InternalServerError(error);
+    }
+
+    std::vector<models::PaymentConfirmationResult> results;
+    results.reserve(confirmations.size());
+
+    try
+    {
+        database::Transaction transaction(db, "BEGIN IMMEDIATE TRANSACTION;");
+
+        for (const auto &confirmation : confirmations)
+        {
+            models::PaymentConfirmationResult result{confirmation.payment_id, models::ConfirmationStatus::NOT_FOUND, std::nullopt};
+
+            sqlite3_bind_text(update_stmt, 1, confirmation.paid_at.c_str(), static_cast<int>(confirmation.paid_at.size()), SQLITE_STATIC);
+            sqlite3_bind_int(update_stmt, 2, confirmation.payment_id);
+
+            int rc = sqlite3_step(update_stmt);
+            if (rc == SQLITE_ROW)
+            {
+                result.status = models::ConfirmationStatus::CONFIRMED;
+                result.order_id = sqlite3_column_int(update_stmt, 0);
+                rc = sqlite3_step(update_stmt);
+            }
+
+            if (rc != SQLITE_DONE)
+                throw std::runtime_error(sqlite3_errmsg(db));
+
+            sqlite3_reset(update_stmt);
+            sqlite3_clear_bindings(update_stmt);
+
+            // Nenhuma linha alterada: pagamento inexistente ou já confirmado
+            if (result.status != models::ConfirmationStatus::CONFIRMED)
+            {
+                sqlite3_bind_int(lookup_stmt, 1, confirmation.payment_id);
+
+                if (sqlite3_step(lookup_stmt) == SQLITE_ROW)
+                {
+                    result.status = models::ConfirmationStatus::ALREADY_PAID;
+                    result.order_id = sqlite3_column_int(lookup_stmt, 0);
+                }
+
+                sqlite3_reset(lookup_stmt);
+            }
+
+            results.push_back(result);
+        }
+
+        transaction.commit();
+    }
+    catch (const std::exception &e)
+    {
+        sqlite3_finalize(update_stmt);
+        sqlite3_finalize(lookup_stmt);
+        throw exceptions::InternalServerError(std::string("Failed to confirm payments: ") + e.what());
+    }
+
+    sqlite3_finalize(update_stmt);
+    sqlite3_finalize(lookup_stmt);
+
+    return results;
+}
+
 auto PaymentRepository::update(const int &id, const models::Payment &payment) -> void
 {
     const auto db = get_db();
@@ -205,7 +356,7 @@ auto PaymentRepository::update(const int &id, const models::Payment &payment) ->
 
     if (payment.paid_at.has_value()) // verifica se existe valor
     {
-        const auto paid_at_str = utils::time::time_point_to_string(*payment.paid_at);
+        const auto paid_at_str = utils::time::format_time(*payment.paid_at, utils::time::TimeFormat::sql);
         sqlite3_bind_text(stmt, 4, paid_at_str.c_str(), -1, SQLITE_TRANSIENT);
     }
     else
@@ -1,5 +1,6 @@
 #include "repository/product_repository.h"
 #include "errors/http_handle_error.h"
+#include "tracing/trace.h"
 #include "utils/convert.h"
 #include <stdexcept>
 
@@ -15,7 +16,7 @@ ProductRepository::ProductRepository()
 auto ProductRepository::create(models::Product &product) -> void
 {
     const auto db = get_db();
-    const char *query = "INSERT INTO products (name, category, price_cents, active) VALUES (?, ?, ?, ?)";
+    const char *query = "INSERT INTO products (name, category, price_cents, active, stock) VALUES (?, ?, ?, ?, ?)";
 
     sqlite3_stmt *stmt = nullptr;
     if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
@@ -27,6 +28,10 @@ auto ProductRepository::create(models::Product &product) -> void
     sqlite3_bind_text(stmt, 2, utils::category_to_string(product.category).c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 3, product.price_cents);
     sqlite3_bind_int(stmt, 4, product.active ? 1 : 0);
+    if (product.stock)
+        sqlite3_bind_int(stmt, 5, *product.stock);
+    else
+        sqlite3_bind_null(stmt, 5);
 
     if (sqlite3_step(stmt) != SQLITE_DONE)
     {
@@ -41,8 +46,10 @@ auto ProductRepository::create(models::Product &product) -> void
 
 auto ProductRepository::find_product_by_id(int id) -> std::optional<models::Product>
 {
+    LYNX_TRACE_SPAN("product_repository.find_by_id");
+
     const auto db = get_db();
-    const char *query = "SELECT id, name, category, price_cents, active FROM products WHERE id = ?";
+    const char *query = "SELECT id, name, category, price_cents, active, stock FROM products WHERE id = ?";
 
     sqlite3_stmt *stmt = nullptr;
     if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) != SQLITE_OK)
@@ -65,6 +72,8 @@ auto ProductRepository::find_product_by_id(int id) -> std::optional<models::Prod
 
         product.price_cents = sqlite3_column_int(stmt, 3);
         product.active = sqlite3_column_int(stmt, 4) != 0;
+        if (sqlite3_column_type(stmt, 5) != SQLITE_NULL)
+            product.stock = sqlite3_column_int(stmt, 5);
 
         result = product;
     }
@@ -76,7 +85,7 @@ auto ProductRepository::find_product_by_id(int id) -> std::optional<models::Prod
 auto ProductRepository::find_all(const models::ProductFilters &filters) -> std::vector<models::Product>
 {
     const auto db = get_db();
-    std::string query = "SELECT id, name, category, price_cents, active FROM products WHERE 1=1";
+    std::string query = "SELECT id, name, category, price_cents, active, stock FROM products WHERE 1=1";
     std::vector<std::pair<int, int>> int_params;
     std::vector<std::string> string_params;
 
@@ -120,6 +129,8 @@ auto ProductRepository::find_all(const models::ProductFilters &filters) -> std::
         product.category = utils::string_to_category(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2)));
         product.price_cents = sqlite3_column_int(stmt, 3);
         product.active = sqlite3_column_int(stmt, 4) != 0;
+        if (sqlite3_column_type(stmt, 5) != SQLITE_NULL)
+            product.stock = sqlite3_column_int(stmt, 5);
         result.push_back(product);
     }
 
@@ -127,11 +138,11 @@ auto ProductRepository::find_all(const models::ProductFilters &filters) -> std::
     return result;
 }
 
-auto ProductRepository::update(const int &id, const std::optional<models::Product> &product) -> void
+auto ProductRepository::update(const int &id, const std::optional<models::Product> &product) -> errors::Result<void>
 {
     if (!product)
     {
-        throw exceptions::BadRequestError("No fields to update");
+        return errors::bad_request("No fields to update");
     }
 
     const auto db = get_db();
@@ -170,6 +181,7 @@ auto ProductRepository::update(const int &id, const std::optional<models::Produc
     }
 
     sqlite3_finalize(stmt);
+    return {};
 }
 
 auto ProductRepository::remove(int id) -> void
@@ -0,0 +1,110 @@
+#include "scheduler/timer_wheel.h"
+
+namespace lynx::scheduler
+{
+
+TimerWheel::TimerWheel(uint64_t now_tick)
+    : now_(now_tick)
+{
+}
+
+auto TimerWheel::place(const Entry &entry) -> void
+{
+    // O nível é o menor em que prazo e tempo atual compartilham todos os bits superiores;
+    // assim o slot escolhido é sempre alcançado antes do prazo
+    const uint64_t diff = entry.deadline ^ now_;
+
+    for (int level = 0; level < levels_; ++level)
+    {
+        if ((diff >> (level_bits_ * (level + 1))) == 0)
+        {
+            const auto slot = (entry.deadline >> (level_bits_ * level)) & slot_mask_;
+            wheel_[level][slot].push_back(entry);
+            return;
+        }
+    }
+
+    overflow_.push_back(entry);
+}
+
+auto TimerWheel::cascade(int level) -> void
+{
+    const auto slot = (now_ >> (level_bits_ * level)) & slot_mask_;
+
+    std::vector<Entry> entries;
+    entries.swap(wheel_[level][slot]);
+
+    for (const auto &entry : entries)
+    {
+        place(entry);
+    }
+}
+
+auto TimerWheel::schedule(int id, uint64_t deadline_tick) -> void
+{
+    // Prazos já vencidos disparam no próximo tick
+    if (deadline_tick <= now_)
+        deadline_tick = now_ + 1;
+
+    deadlines_.insert_or_assign(id, deadline_tick);
+    place(Entry{id, deadline_tick});
+}
+
+auto TimerWheel::cancel(int id) -> bool
+{
+    return deadlines_.erase(id) > 0;
+}
+
+auto TimerWheel::advance(uint64_t now_tick, std::vector<int> &expired) -> void
+{
+    while (now_ < now_tick)
+    {
+        ++now_;
+
+        // Ao virar um nível, os slots do nível acima descem para os níveis inferiores
+        for (int level = 1; level < levels_; ++level)
+        {
+            if ((now_ & ((uint64_t{1} << (level_bits_ * level)) - 1)) != 0)
+                break;
+
+            cascade(level);
+
+            if (level == levels_ - 1)
+            {
+                std::vector<Entry> entries;
+                entries.swap(overflow_);
+
+                for (const auto &entry : entries)
+                {
+                    place(entry);
+                }
+            }
+        }
+
+        auto &slot = wheel_[0][now_ & slot_mask_];
+
+        for (const auto &entry : slot)
+        {
+            auto it = deadlines_.find(entry.id);
+            if (it == deadlines_.end() || it->second != entry.deadline)
+                continue; // cancelado ou reagendado
+
+            deadlines_.erase(it);
+            expired.push_back(entry.id);
+        }
+
+        slot.clear();
+    }
+}
+
+auto TimerWheel::now() const -> uint64_t
+{
+    return now_;
+}
+
+auto TimerWheel::size() const -> size_t
+{
+    return deadlines_.size();
+}
+
+} // namespace lynx::scheduler
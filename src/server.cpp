@@ -47,6 +47,14 @@ Server::Server(const ServerConfig &config)
             .prefix("/api")
             .max_age(86400);
     }
+
+    // Config compression
+    compression::CompressionConfig compression_config;
+    compression_config.enabled = this->config_.compression;
+    compression_config.level = this->config_.compression_level;
+    compression_config.min_bytes = this->config_.compression_min_bytes;
+
+    this->app_->get_middleware<compression::CompressionMiddleware>().configure(compression_config);
 }
 
 auto Server::setup() -> void
@@ -63,9 +71,34 @@ auto Server::add_handler(std::shared_ptr<interface::IHandler> handler) -> void
     this->handlers_.push_back(std::move(handler));
 }
 
+auto Server::set_metrics(std::shared_ptr<metrics::MetricsRegistry> registry) -> void
+{
+    this->app_->get_middleware<metrics::MetricsMiddleware>().set_registry(registry);
+}
+
+auto Server::set_admission(std::shared_ptr<admission::AdmissionControl> control) -> void
+{
+    this->app_->get_middleware<admission::AdmissionMiddleware>().set_control(control);
+}
+
+auto Server::set_capture(std::shared_ptr<capture::TrafficRecorder> recorder) -> void
+{
+    this->app_->get_middleware<capture::CaptureMiddleware>().set_recorder(recorder);
+}
+
 auto Server::start() -> void
 {
     this->setup();
     this->app_->port(this->config_.port).multithreaded().concurrency(this->config_.threads).run_async();
 }
+
+auto Server::wait_until_ready() -> void
+{
+    this->app_->wait_for_server_start();
+}
+
+auto Server::stop() -> void
+{
+    this->app_->stop();
+}
 } // namespace lynx::server
\ No newline at end of file
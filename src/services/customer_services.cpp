@@ -1,6 +1,4 @@
 #include "services/customer_services.h"
-#include "errors/http_handle_error.h"
-#include <stdexcept>
 
 namespace lynx::services
 {
@@ -10,28 +8,30 @@ CustomerServices::CustomerServices(std::shared_ptr<repository::interface::ICusto
 {
 }
 
-auto CustomerServices::validate_customer(const models::Customer &customer) -> void
+auto CustomerServices::validate_customer(const models::Customer &customer) -> errors::Result<void>
 {
     if (customer.name.empty())
     {
-        throw exceptions::BadRequestError("Customer name cannot be empty");
+        return errors::bad_request("Customer name cannot be empty");
     }
 
     if (customer.email.empty())
     {
-        throw exceptions::BadRequestError("Customer email cannot be empty");
+        return errors::bad_request("Customer email cannot be empty");
     }
 
     if (customer.email.find('@') == std::string::npos)
     {
-        throw exceptions::BadRequestError("Customer email is invalid");
+        return errors::bad_request("Customer email is invalid");
     }
 
     auto found_customer = repository_->find_by_email(customer.email);
     if (found_customer.has_value())
     {
-        throw exceptions::BadRequestError("Email is already registered");
+        return errors::bad_request("Email is already registered");
     }
+
+    return {};
 }
 
 auto CustomerServices::to_response_dto(const models::Customer &customer) -> models::dto::CustomerResponseDTO
@@ -39,37 +39,39 @@ auto CustomerServices::to_response_dto(const models::Customer &customer) -> mode
     return models::dto::CustomerResponseDTO{customer.id, customer.name, customer.email, customer.created_at};
 }
 
-auto CustomerServices::create_customer(const models::dto::CustomerCreateDTO &dto) -> models::dto::CustomerResponseDTO
+auto CustomerServices::create_customer(const models::dto::CustomerCreateDTO &dto) -> errors::Result<models::dto::CustomerResponseDTO>
 {
     models::Customer customer;
     customer.name = dto.name;
     customer.email = dto.email;
     customer.created_at = std::chrono::system_clock::now();
 
-    validate_customer(customer);
+    if (auto valid = validate_customer(customer); !valid)
+        return valid.error();
+
     repository_->create(customer);
 
     return to_response_dto(customer);
 }
 
-auto CustomerServices::get_customer_by_id(const int &id) -> models::dto::CustomerResponseDTO
+auto CustomerServices::get_customer_by_id(const int &id) -> errors::Result<models::dto::CustomerResponseDTO>
 {
     auto customer_opt = repository_->find_by_id(id);
 
     if (!customer_opt)
     {
-        throw exceptions::NotFoundError("Customer not found");
+        return errors::not_found("Customer not found");
     }
 
     return to_response_dto(customer_opt.value());
 }
 
-auto CustomerServices::get_customer_by_email(const std::string &email) -> models::dto::CustomerResponseDTO
+auto CustomerServices::get_customer_by_email(const std::string &email) -> errors::Result<models::dto::CustomerResponseDTO>
 {
     auto customer_opt = repository_->find_by_email(email);
     if (!customer_opt.has_value())
     {
-        throw exceptions::CustomError("Customer not found");
+        return errors::not_found("Customer not found");
     }
 
     return to_response_dto(customer_opt.value());
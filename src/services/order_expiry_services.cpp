@@ -0,0 +1,159 @@
+#include "services/order_expiry_services.h"
+#include <algorithm>
+#include <iostream>
+
+namespace lynx::services
+{
+
+OrderExpiryServices::OrderExpiryServices(std::shared_ptr<repository::interface::IOrderRepository> repository,
+                                         std::shared_ptr<ledger::OrderLedger> ledger,
+                                         std::shared_ptr<inventory::StockInventory> inventory,
+                                         std::shared_ptr<cache::OrderDetailsCache> details_cache, const OrderExpiryConfig &config)
+    : repository_(repository)
+    , ledger_(ledger)
+    , inventory_(inventory)
+    , details_cache_(details_cache)
+    , config_(config)
+    , wheel_(to_tick(std::chrono::system_clock::now()))
+{
+}
+
+OrderExpiryServices::~OrderExpiryServices()
+{
+    stop();
+}
+
+auto OrderExpiryServices::to_tick(const std::chrono::system_clock::time_point &tp) const -> uint64_t
+{
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+    const auto tick = std::max<int64_t>(1, config_.tick.count());
+
+    // Arredonda para cima: um prazo nunca dispara antes da hora
+    return static_cast<uint64_t>((ms + tick - 1) / tick);
+}
+
+auto OrderExpiryServices::start() -> void
+{
+    if (!config_.enabled || worker_.joinable())
+        return;
+
+    // Recarrega os prazos de todos os pedidos ainda em aberto
+    auto pending_orders = repository_->find_pending_deadlines();
+
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto &order : pending_orders)
+        {
+            wheel_.schedule(order.id, to_tick(order.created_at + config_.payment_deadline));
+        }
+    }
+
+    stopping_ = false;
+    worker_ = std::thread([this] { run(); });
+}
+
+auto OrderExpiryServices::stop() -> void
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    stop_cv_.notify_all();
+
+    if (worker_.joinable())
+        worker_.join();
+}
+
+auto OrderExpiryServices::schedule(int order_id, const std::chrono::system_clock::time_point &created_at) -> void
+{
+    if (!config_.enabled)
+        return;
+
+    std::lock_guard lock(mutex_);
+    wheel_.schedule(order_id, to_tick(created_at + config_.payment_deadline));
+}
+
+auto OrderExpiryServices::cancel(int order_id) -> void
+{
+    if (!config_.enabled)
+        return;
+
+    std::lock_guard lock(mutex_);
+    wheel_.cancel(order_id);
+}
+
+auto OrderExpiryServices::pending() -> size_t
+{
+    std::lock_guard lock(mutex_);
+    return wheel_.size();
+}
+
+auto OrderExpiryServices::run() -> void
+{
+    std::vector<int> expired;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            if (stop_cv_.wait_for(lock, config_.tick, [this] { return stopping_; }))
+                return;
+
+            wheel_.advance(to_tick(std::chrono::system_clock::now()), expired);
+        }
+
+        if (!expired.empty())
+        {
+            expire(expired);
+            expired.clear();
+        }
+    }
+}
+
+auto OrderExpiryServices::expire(const std::vector<int> &order_ids) -> void
+{
+    const auto created_before = std::chrono::system_clock::now() - config_.payment_deadline;
+
+    for (size_t start = 0; start < order_ids.size(); start += config_.batch_size)
+    {
+        const auto end = std::min(start + config_.batch_size, order_ids.size());
+        const std::vector<int> batch(order_ids.begin() + start, order_ids.begin() + end);
+
+        std::vector<int> cancelled;
+
+        try
+        {
+            cancelled = repository_->cancel_expired(batch, created_before);
+        }
+        catch (const std::exception &e)
+        {
+            // Lote volta para a roda e é tentado de novo no próximo tick
+            std::cerr << "Order expiry batch failed: " << e.what() << '\n';
+
+            std::lock_guard lock(mutex_);
+            for (const auto order_id : batch)
+            {
+                wheel_.schedule(order_id, wheel_.now() + 1);
+            }
+            continue;
+        }
+
+        for (const auto order_id : cancelled)
+        {
+            ledger_->on_status_changed(order_id, models::OrderStatus::CANCELLED);
+            details_cache_->invalidate(order_id);
+        }
+
+        // O cancelamento já foi gravado; uma falha aqui só deixa o estoque desses pedidos preso
+        try
+        {
+            inventory_->restock_orders(cancelled);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Order expiry restock failed: " << e.what() << '\n';
+        }
+    }
+}
+
+} // namespace lynx::services
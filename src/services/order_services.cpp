@@ -1,7 +1,7 @@
 #include "services/order_services.h"
-#include "errors/http_handle_error.h"
+#include "tracing/trace.h"
 #include "utils/convert.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
 #include <stdexcept>
 
 namespace lynx::services
@@ -9,8 +9,14 @@ namespace lynx::services
 
 OrderServices::OrderServices(std::shared_ptr<repository::interface::IOrderRepository> repository_order,
                              std::shared_ptr<repository::interface::IProductRepository> repository_product,
-                             std::shared_ptr<repository::interface::ICustomerRepository> customer_repository)
+                             std::shared_ptr<repository::interface::ICustomerRepository> customer_repository,
+                             std::shared_ptr<ledger::OrderLedger> ledger, std::shared_ptr<OrderExpiryServices> expiry_service,
+                             std::shared_ptr<inventory::StockInventory> inventory, std::shared_ptr<cache::OrderDetailsCache> details_cache)
     : repository_(repository_order)
+    , ledger_(ledger)
+    , expiry_service_(expiry_service)
+    , inventory_(inventory)
+    , details_cache_(details_cache)
 {
     product_service_ = std::make_shared<ProductServices>(repository_product);
     customer_service_ = std::make_shared<CustomerServices>(customer_repository);
@@ -43,42 +49,62 @@ auto OrderServices::to_summary_dto(const models::OrderSummary &summary) -> model
                                         summary.created_at, summary.total_cents, summary.total_paid_cents};
 }
 
-auto OrderServices::validate_order(const models::Order &order) -> void
+auto OrderServices::validate_order(const models::Order &order) -> errors::Result<void>
 {
     if (order.items.empty())
     {
-        throw exceptions::BadRequestError("Order must have at least one item");
+        return errors::bad_request("Order must have at least one item");
     }
 
     for (const auto &item : order.items)
     {
         if (item.quantity <= 0)
-            throw exceptions::BadRequestError("Item quantity must be greater than zero");
+            return errors::bad_request("Item quantity must be greater than zero");
     }
+
+    return {};
 }
 
-auto OrderServices::validate_products(std::vector<models::OrderItem> &items) -> void
+auto OrderServices::validate_products(std::vector<models::OrderItem> &items) -> errors::Result<void>
 {
+    LYNX_TRACE_SPAN("order_services.validate_products");
+
     for (auto &item : items)
     {
         auto product = product_service_->get_product_by_id(item.product_id);
+        if (!product)
+            return product.error();
 
-        if (!product.active)
+        if (!product->active)
         {
-            throw exceptions::BadRequestError("Product is not active: " + product.name);
+            return errors::bad_request("Product is not active: " + product->name);
         }
 
-        item.unit_price_cents = product.price_cents;
+        item.unit_price_cents = product->price_cents;
+    }
+
+    // Última validação: a partir daqui o estoque fica reservado e precisa ser devolvido se o pedido não for gravado
+    LYNX_TRACE_SPAN("inventory.try_reserve");
+    if (auto product_id = inventory_->try_reserve(items))
+    {
+        return errors::conflict("Insufficient stock for product id: " + std::to_string(*product_id));
     }
+
+    return {};
 }
 
-auto OrderServices::validate_customer(int customer_id) -> void
+auto OrderServices::validate_customer(int customer_id) -> errors::Result<void>
 {
-    customer_service_->get_customer_by_id(customer_id);
+    if (auto customer = customer_service_->get_customer_by_id(customer_id); !customer)
+        return customer.error();
+
+    return {};
 }
 
-auto OrderServices::create_order(const models::dto::OrderCreateDTO &dto) -> models::dto::OrderResponseDTO
+auto OrderServices::create_order(const models::dto::OrderCreateDTO &dto) -> errors::Result<models::dto::OrderResponseDTO>
 {
+    LYNX_TRACE_SPAN("order_services.create_order");
+
     models::Order order;
     order.customer_id = dto.customer_id;
     order.status = models::OrderStatus::NEW;
@@ -93,36 +119,59 @@ auto OrderServices::create_order(const models::dto::OrderCreateDTO &dto) -> mode
         order.items.push_back(item);
     }
 
-    validate_order(order);
-    validate_products(order.items);
-    validate_customer(order.customer_id);
+    if (auto valid = validate_order(order); !valid)
+        return valid.error();
+
+    if (auto valid = validate_customer(order.customer_id); !valid)
+        return valid.error();
+
+    if (auto valid = validate_products(order.items); !valid)
+        return valid.error();
+
+    try
+    {
+        repository_->create(order);
+    }
+    catch (...)
+    {
+        inventory_->release(order.items);
+        throw;
+    }
 
-    repository_->create(order);
+    int64_t total_cents = 0;
+    for (const auto &item : order.items)
+    {
+        total_cents += static_cast<int64_t>(item.quantity) * item.unit_price_cents;
+    }
+    ledger_->on_order_created(order.id, total_cents);
+    expiry_service_->schedule(order.id, order.created_at);
 
     return to_response_dto(order);
 }
 
-auto OrderServices::get_order_by_id(const int &id) -> models::Order
+auto OrderServices::get_order_by_id(const int &id) -> errors::Result<models::Order>
 {
+    LYNX_TRACE_SPAN("order_services.get_order_by_id");
+
     auto order_opt = repository_->find_by_id(id);
     if (!order_opt.has_value())
     {
-        throw exceptions::NotFoundError("Order not found for order id: " + std::to_string(id));
+        return errors::not_found("Order not found for order id: " + std::to_string(id));
     }
 
-    return *order_opt;
+    return std::move(*order_opt);
 }
 
-auto OrderServices::get_order_with_customer(const int &id) -> models::Order
+auto OrderServices::get_order_with_customer(const int &id) -> errors::Result<models::Order>
 {
 
     auto order_with_customer_opt = repository_->find_by_id_with_customer(id);
     if (!order_with_customer_opt.has_value())
     {
-        throw exceptions::NotFoundError("Order not found");
+        return errors::not_found("Order not found");
     }
 
-    return *order_with_customer_opt;
+    return std::move(*order_with_customer_opt);
 }
 
 auto OrderServices::get_all_orders() -> std::vector<models::Order>
@@ -147,6 +196,8 @@ auto OrderServices::calculate_total_cents(int order_id) -> int64_t
 auto OrderServices::get_all_orders_summary(const std::optional<std::string> &status_filter, const std::optional<int> &customer_id_filter,
                                            const std::optional<int> &limit) -> std::vector<models::dto::OrderSummaryDTO>
 {
+    LYNX_TRACE_SPAN("order_services.get_all_orders_summary");
+
     auto summaries = repository_->find_all_summary(status_filter, customer_id_filter, limit);
 
     std::vector<models::dto::OrderSummaryDTO> dtos;
@@ -160,45 +211,98 @@ auto OrderServices::get_all_orders_summary(const std::optional<std::string> &sta
     return dtos;
 }
 
-auto OrderServices::mark_order_as_paid(const int &order_id) -> void
+auto OrderServices::get_order_balance(int order_id) -> errors::Result<ledger::OrderBalance>
 {
-    auto order = get_order_by_id(order_id);
+    auto balance = ledger_->get(order_id);
+    if (!balance.has_value())
+    {
+        return errors::not_found("Order not found for order id: " + std::to_string(order_id));
+    }
+
+    return *balance;
+}
+
+auto OrderServices::mark_order_as_paid(const int &order_id) -> errors::Result<void>
+{
+    LYNX_TRACE_SPAN("order_services.mark_order_as_paid");
+
+    auto balance = get_order_balance(order_id);
+    if (!balance)
+        return balance.error();
+
+    if (balance->status == models::OrderStatus::CANCELLED)
+        return errors::bad_request("Cannot pay a cancelled order");
+
+    if (balance->status == models::OrderStatus::PAID)
+    {
+        return {}; // idempotente
+    }
+
+    if (auto updated = repository_->update_status(order_id, models::OrderStatus::PAID); !updated)
+        return updated.error();
 
-    if (order.status == models::OrderStatus::CANCELLED)
-        throw exceptions::BadRequestError("Cannot pay a cancelled order");
+    ledger_->on_status_changed(order_id, models::OrderStatus::PAID);
+    details_cache_->invalidate(order_id);
+    expiry_service_->cancel(order_id);
 
-    if (order.status == models::OrderStatus::PAID)
+    return {};
+}
+
+auto OrderServices::mark_settled_orders_as_paid(const std::vector<int> &order_ids) -> int
+{
+    const auto paid = repository_->mark_settled_as_paid(order_ids);
+
+    // Todos os pedidos afetados tiveram pagamentos confirmados; as entradas são recarregadas sob demanda
+    for (const auto order_id : order_ids)
     {
-        return; // idempotente
+        ledger_->invalidate(order_id);
+        details_cache_->invalidate(order_id);
     }
 
-    repository_->update_status(order.id, models::OrderStatus::PAID);
+    // Como em mark_order_as_paid: pedido pago não expira
+    for (const auto order_id : paid)
+    {
+        expiry_service_->cancel(order_id);
+    }
+
+    return static_cast<int>(paid.size());
 }
 
-auto OrderServices::get_order_details(int order_id) -> models::dto::OrderDetailsResponseDTO
+auto OrderServices::invalidate_order_details(int order_id) -> void
 {
+    details_cache_->invalidate(order_id);
+}
+
+auto OrderServices::get_order_details(int order_id) -> errors::Result<models::dto::OrderDetailsResponseDTO>
+{
+    LYNX_TRACE_SPAN("order_services.get_order_details");
+
     auto order = get_order_by_id(order_id);
+    if (!order)
+        return order.error();
 
     auto items = repository_->find_items_by_order_id(order_id);
     if (items.empty())
     {
-        throw exceptions::BadRequestError("Order has no items");
+        return errors::bad_request("Order has no items");
     }
 
     models::dto::OrderDetailsResponseDTO response;
-    response.order_id = order.id;
-    response.customer_id = order.customer_id;
-    response.status = utils::order_status_to_string(order.status);
-    response.created_at = order.created_at;
+    response.order_id = order->id;
+    response.customer_id = order->customer_id;
+    response.status = utils::order_status_to_string(order->status);
+    response.created_at = order->created_at;
     response.total_cents = 0;
 
     for (const auto &item : items)
     {
         auto product = product_service_->get_product_by_id(item.product_id);
+        if (!product)
+            return product.error();
 
         models::dto::OrderItemDetailsDTO item_dto;
         item_dto.product_id = item.product_id;
-        item_dto.product_name = product.name;
+        item_dto.product_name = std::move(product->name);
         item_dto.quantity = item.quantity;
         item_dto.unit_price_cents = item.unit_price_cents;
         item_dto.subtotal_cents = item.quantity * item.unit_price_cents;
@@ -1,14 +1,15 @@
 #include "services/payment_services.h"
-#include "errors/http_handle_error.h"
-#include "utils/time/time_utils.h"
+#include "utils/time/time_format.h"
+#include <algorithm>
 
 namespace lynx::services
 {
 
 PaymentServices::PaymentServices(std::shared_ptr<repository::interface::IPaymentRepository> payment_repository,
-                                 std::shared_ptr<OrderServices> order_service)
+                                 std::shared_ptr<OrderServices> order_service, std::shared_ptr<ledger::OrderLedger> ledger)
     : repository_(payment_repository)
     , order_service_(order_service)
+    , ledger_(ledger)
 {
 }
 
@@ -17,76 +18,184 @@ auto PaymentServices::to_response_dto(const models::Payment &payment) -> models:
     return models::dto::PaymentResponseDTO{payment.id, payment.order_id, payment.method, payment.amount_cents, payment.paid_at};
 }
 
-auto PaymentServices::validate_payment(const models::Payment &payment, int total_order_cents, int total_already_paid) -> void
+auto PaymentServices::validate_payment(const models::Payment &payment) -> errors::Result<void>
 {
     if (payment.amount_cents <= 0)
     {
-        throw exceptions::BadRequestError("Payment amount must be positive");
+        return errors::bad_request("Payment amount must be positive");
     }
 
     if (payment.method == models::PaymentMethod::UNKNOWN)
     {
-        throw exceptions::BadRequestError("Invalid payment method");
+        return errors::bad_request("Invalid payment method");
     }
 
-    int remaining = total_order_cents - total_already_paid;
-
-    if (remaining <= 0)
-    {
-        throw exceptions::BadRequestError("This order is already fully paid");
-    }
-
-    if (payment.amount_cents > remaining)
-    {
-        auto message = "Payment amount exceeds order total. Remaining: " + std::to_string(remaining) + " cents";
-        throw exceptions::BadRequestError(message);
-    }
+    return {};
 }
 
-auto PaymentServices::create_payment(const models::dto::PaymentCreateDTO &dto) -> models::dto::PaymentResponseDTO
+auto PaymentServices::create_payment(const models::dto::PaymentCreateDTO &dto) -> errors::Result<models::dto::PaymentResponseDTO>
 {
-    // 1. Centraliza busca de dados (Evita múltiplas chamadas ao DB)
-    const int total_order = order_service_->calculate_total_cents(dto.order_id);
-    const int total_paid_before = repository_->sum_by_order(dto.order_id);
-
-    // 2. Mapeamento DTO -> Model
+    // 1. Mapeamento DTO -> Model
     models::Payment payment;
     payment.order_id = dto.order_id;
     payment.amount_cents = dto.amount_cents;
     payment.method = dto.method;
     payment.paid_at = std::nullopt;
 
-    // 3. Validação (Passando os valores já consultados)
-    validate_payment(payment, total_order, total_paid_before);
+    // 2. Validação do próprio pagamento
+    if (auto valid = validate_payment(payment); !valid)
+        return valid.error();
+
+    // 3. Status e restante conferidos e o valor reservado no ledger de uma vez (o banco só é
+    //    consultado no primeiro acesso ao pedido)
+    const auto balance = ledger_->try_apply_payment(payment.order_id, payment.amount_cents);
+    if (!balance)
+        return balance.error();
 
-    // 4. Persistência
-    repository_->create(payment);
+    // 4. Persistência; sem a linha, a reserva é desfeita
+    try
+    {
+        repository_->create(payment);
+    }
+    catch (...)
+    {
+        ledger_->revert_payment(payment.order_id, payment.amount_cents);
+        throw;
+    }
 
-    // 5. Cálculo do novo estado
-    int total_paid_after = total_paid_before + payment.amount_cents;
-    int remaining = std::max(0, total_order - total_paid_after);
+    order_service_->invalidate_order_details(payment.order_id);
+
+    // 5. Novo estado, do saldo que já inclui este pagamento
+    const int64_t remaining = std::max<int64_t>(0, balance->remaining_cents());
 
     auto res_dto = to_response_dto(payment);
-    res_dto.still_missing = (remaining > 0) ? std::make_optional(remaining) : std::nullopt;
+    res_dto.still_missing = (remaining > 0) ? std::make_optional(static_cast<int>(remaining)) : std::nullopt;
 
     // 6. Se atingiu o total, atualiza o status do pedido
-    if (total_paid_after >= total_order)
+    if (remaining == 0)
     {
-        order_service_->mark_order_as_paid(payment.order_id);
+        if (auto paid = order_service_->mark_order_as_paid(payment.order_id); !paid)
+            return paid.error();
     }
 
     return res_dto;
 }
 
-auto PaymentServices::get_payment_by_id(int payment_id) -> models::dto::PaymentResponseDTO
+auto PaymentServices::get_payment_by_id(int payment_id) -> errors::Result<models::dto::PaymentResponseDTO>
 {
     auto payment_opt = repository_->find_by_id(payment_id);
     if (!payment_opt)
     {
-        throw exceptions::NotFoundError("Payment not found");
+        return errors::not_found("Payment not found");
     }
 
     return to_response_dto(*payment_opt);
 }
 
+auto PaymentServices::get_all_payments(models::PaymentFilters filters) -> errors::Result<models::dto::PaymentPageDTO>
+{
+    if (filters.limit <= 0 || filters.limit > max_page_size_)
+    {
+        return errors::bad_request("limit must be between 1 and " + std::to_string(max_page_size_));
+    }
+
+    if (filters.paid_from.has_value() && filters.paid_to.has_value() && *filters.paid_to <= *filters.paid_from)
+    {
+        return errors::bad_request("'to' must be after 'from'");
+    }
+
+    // "<id>" sob ORDER BY paid_at, id (ou o contrário) pularia ou repetiria linhas
+    const bool by_paid_at = filters.pages_by_paid_at();
+    if (filters.after.has_value() && filters.after->paid_at.has_value() != by_paid_at)
+    {
+        return errors::bad_request("cursor does not match these filters; restart from the first page");
+    }
+
+    // Busca uma linha a mais para saber se existe próxima página
+    const auto page_size = static_cast<size_t>(filters.limit);
+    filters.limit++;
+
+    auto payments = repository_->find_all(filters);
+
+    models::dto::PaymentPageDTO page;
+
+    if (payments.size() > page_size)
+    {
+        payments.resize(page_size);
+
+        const auto &last = payments.back();
+        page.next_cursor = models::PaymentCursor{last.id, by_paid_at ? last.paid_at : std::nullopt};
+    }
+
+    page.items.reserve(payments.size());
+    for (const auto &payment : payments)
+    {
+        page.items.push_back(to_response_dto(payment));
+    }
+
+    return page;
+}
+
+auto PaymentServices::confirm_payments(const std::vector<models::dto::PaymentConfirmationDTO> &confirmations)
+    -> models::dto::PaymentConfirmationSummaryDTO
+{
+    models::dto::PaymentConfirmationSummaryDTO summary;
+    summary.received = static_cast<int>(confirmations.size());
+    summary.results.reserve(confirmations.size());
+
+    // Confirmações sem paid_at usam o horário de recebimento do arquivo
+    const auto received_at = utils::time::format_time(std::chrono::system_clock::now(), utils::time::TimeFormat::sql);
+
+    std::vector<int> affected_orders;
+    std::vector<models::PaymentConfirmation> batch;
+    batch.reserve(std::min(confirmations.size(), confirmation_batch_size_));
+
+    for (size_t start = 0; start < confirmations.size(); start += confirmation_batch_size_)
+    {
+        const size_t end = std::min(start + confirmation_batch_size_, confirmations.size());
+
+        batch.clear();
+        for (size_t i = start; i < end; ++i)
+        {
+            const auto &confirmation = confirmations[i];
+            batch.push_back({confirmation.payment_id,
+                             confirmation.paid_at.has_value() ? utils::time::format_time(*confirmation.paid_at, utils::time::TimeFormat::sql) : received_at});
+        }
+
+        // Uma transação por lote
+        auto results = repository_->mark_as_paid_batch(batch);
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &result = results[i];
+            summary.results.push_back({confirmations[start + i].line, result.payment_id, result.status, result.order_id, std::nullopt});
+
+            switch (result.status)
+            {
+            case models::ConfirmationStatus::CONFIRMED:
+                summary.confirmed++;
+                affected_orders.push_back(*result.order_id);
+                break;
+            case models::ConfirmationStatus::ALREADY_PAID:
+                summary.already_paid++;
+                break;
+            case models::ConfirmationStatus::NOT_FOUND:
+                summary.not_found++;
+                break;
+            case models::ConfirmationStatus::INVALID:
+                summary.invalid++;
+                break;
+            }
+        }
+    }
+
+    // Recalcula o status de todos os pedidos afetados de uma só vez
+    std::sort(affected_orders.begin(), affected_orders.end());
+    affected_orders.erase(std::unique(affected_orders.begin(), affected_orders.end()), affected_orders.end());
+
+    summary.orders_paid = order_service_->mark_settled_orders_as_paid(affected_orders);
+
+    return summary;
+}
+
 } // namespace lynx::services
\ No newline at end of file
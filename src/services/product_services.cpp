@@ -1,22 +1,27 @@
 #include "services/product_services.h"
-#include "errors/http_handle_error.h"
-#include <stdexcept>
 
 namespace lynx::services
 {
 
-ProductServices::ProductServices(std::shared_ptr<repository::interface::IProductRepository> repository)
+ProductServices::ProductServices(std::shared_ptr<repository::interface::IProductRepository> repository,
+                                 std::shared_ptr<cache::OrderDetailsCache> details_cache,
+                                 std::shared_ptr<inventory::StockInventory> inventory)
     : repository_(repository)
+    , details_cache_(details_cache)
+    , inventory_(inventory)
 {
 }
 
-auto ProductServices::validate_product(const models::Product &product) -> void
+auto ProductServices::validate_product(const models::Product &product) -> errors::Result<void>
 {
     if (product.name.empty())
-        throw exceptions::BadRequestError("Product name cannot be empty");
+        return errors::bad_request("Product name cannot be empty");
 
     if (product.price_cents < 0)
-        throw exceptions::BadRequestError("Product price cannot be negative");
+        return errors::bad_request("Product price cannot be negative");
+
+    if (product.stock && *product.stock < 0)
+        return errors::bad_request("Product stock cannot be negative");
 
     switch (product.category)
     {
@@ -35,13 +40,15 @@ auto ProductServices::validate_product(const models::Product &product) -> void
     case models::Category::OTHER:
         break; // categoria válida
     default:
-        throw exceptions::BadRequestError("Invalid product category");
+        return errors::bad_request("Invalid product category");
     }
+
+    return {};
 }
 
 auto ProductServices::to_response_dto(const models::Product &product) -> models::dto::ProductResponseDTO
 {
-    return models::dto::ProductResponseDTO{product.id, product.name, product.category, product.price_cents, product.active};
+    return models::dto::ProductResponseDTO{product.id, product.name, product.category, product.price_cents, product.active, product.stock};
 }
 
 auto ProductServices::from_create_dto(const models::dto::ProductCreateDTO &dto) -> models::Product
@@ -51,25 +58,28 @@ auto ProductServices::from_create_dto(const models::dto::ProductCreateDTO &dto)
     product.category = dto.category;
     product.price_cents = dto.price_cents;
     product.active = dto.active;
+    product.stock = dto.stock;
     return product;
 }
 
-auto ProductServices::create_product(const models::dto::ProductCreateDTO &dto) -> models::dto::ProductResponseDTO
+auto ProductServices::create_product(const models::dto::ProductCreateDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>
 {
     models::Product product = from_create_dto(dto);
-    validate_product(product);
+
+    if (auto valid = validate_product(product); !valid)
+        return valid.error();
 
     repository_->create(product);
 
     return to_response_dto(product);
 }
 
-auto ProductServices::get_product_by_id(const int &id) -> models::dto::ProductResponseDTO
+auto ProductServices::get_product_by_id(const int &id) -> errors::Result<models::dto::ProductResponseDTO>
 {
     auto product_opt = repository_->find_product_by_id(id);
     if (!product_opt.has_value())
     {
-        throw exceptions::NotFoundError("Product not found");
+        return errors::not_found("Product not found");
     }
 
     return to_response_dto(*product_opt);
@@ -87,12 +97,12 @@ auto ProductServices::get_all_products(const models::ProductFilters &filters) ->
     return result;
 }
 
-auto ProductServices::update_product(int product_id, const models::dto::ProductCreateDTO &dto) -> models::dto::ProductResponseDTO
+auto ProductServices::update_product(int product_id, const models::dto::ProductCreateDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>
 {
     auto product_opt = repository_->find_product_by_id(product_id);
     if (!product_opt)
     {
-        throw exceptions::NotFoundError("Product not found");
+        return errors::not_found("Product not found");
     }
 
     models::Product updated = *product_opt;
@@ -101,11 +111,35 @@ auto ProductServices::update_product(int product_id, const models::dto::ProductC
     updated.price_cents = dto.price_cents;
     updated.active = dto.active;
 
-    validate_product(updated);
+    if (auto valid = validate_product(updated); !valid)
+        return valid.error();
+
+    if (auto updated_row = repository_->update(product_id, updated); !updated_row)
+        return updated_row.error();
 
-    repository_->update(product_id, updated);
+    // Sem índice produto -> pedidos: renomear é raro, o cache inteiro é descartado
+    if (details_cache_ && updated.name != product_opt->name)
+        details_cache_->invalidate_all();
 
     return to_response_dto(updated);
 }
 
+auto ProductServices::adjust_stock(int product_id, const models::dto::StockAdjustmentDTO &dto) -> errors::Result<models::dto::ProductResponseDTO>
+{
+    if (dto.delta == 0)
+        return errors::bad_request("Stock delta cannot be zero");
+
+    if (!repository_->find_product_by_id(product_id))
+        return errors::not_found("Product not found");
+
+    if (!inventory_->adjust(product_id, dto.delta))
+        return errors::conflict("Insufficient stock for product id: " + std::to_string(product_id));
+
+    auto product_opt = repository_->find_product_by_id(product_id);
+    if (!product_opt)
+        return errors::not_found("Product not found");
+
+    return to_response_dto(*product_opt);
+}
+
 } // namespace lynx::services
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "tracing/trace.h"
+
+#ifdef LYNX_TRACING
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <string_view>
+#include <utility>
+
+namespace lynx::tracing
+{
+
+namespace
+{
+
+constexpr size_t max_spans_per_request = 256;
+
+struct RequestTrace
+{
+    bool active = false;
+    uint32_t depth = 0;
+    uint32_t thread = 0;
+    uint64_t requests = 0;
+    std::vector<Span> spans;
+};
+
+auto current() -> RequestTrace &
+{
+    static std::atomic<uint32_t> next_thread{1};
+
+    thread_local RequestTrace trace = [] {
+        RequestTrace created;
+        created.thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+        created.spans.reserve(max_spans_per_request);
+        return created;
+    }();
+
+    return trace;
+}
+
+auto append_ms(std::string &out, int64_t ns) -> void
+{
+    std::array<char, 32> buffer;
+    auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<double>(ns) / 1e6,
+                                   std::chars_format::fixed, 3);
+    out.append(buffer.data(), end);
+}
+
+auto append_us(std::string &out, int64_t ns) -> void
+{
+    std::array<char, 32> buffer;
+    auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<double>(ns) / 1e3,
+                                   std::chars_format::fixed, 3);
+    out.append(buffer.data(), end);
+}
+
+} // namespace
+
+auto now_ns() -> int64_t
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+auto TraceBuffer::get_instance() -> TraceBuffer &
+{
+    static TraceBuffer instance;
+
+    return instance;
+}
+
+auto TraceBuffer::configure(size_t capacity, uint32_t sample_every) -> void
+{
+    std::lock_guard lock(mutex_);
+    capacity_ = capacity;
+    sample_every_.store(sample_every, std::memory_order_relaxed);
+    spans_.clear();
+    spans_.reserve(capacity_);
+    next_ = 0;
+}
+
+auto TraceBuffer::sample_every() const -> uint32_t
+{
+    return sample_every_.load(std::memory_order_relaxed);
+}
+
+auto TraceBuffer::push(const std::vector<Span> &spans) -> void
+{
+    std::lock_guard lock(mutex_);
+
+    if (capacity_ == 0)
+        return;
+
+    for (const auto &span : spans)
+    {
+        if (spans_.size() < capacity_)
+        {
+            spans_.push_back(span);
+            continue;
+        }
+
+        // Cheio: sobrescreve o span mais antigo
+        spans_[next_] = span;
+        next_ = (next_ + 1) % capacity_;
+    }
+}
+
+auto TraceBuffer::clear() -> void
+{
+    std::lock_guard lock(mutex_);
+    spans_.clear();
+    next_ = 0;
+}
+
+auto TraceBuffer::to_chrome_json() const -> std::string
+{
+    std::lock_guard lock(mutex_);
+
+    std::string out;
+    out.reserve(spans_.size() * 96 + 64);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    for (size_t i = 0; i < spans_.size(); ++i)
+    {
+        // Do mais antigo para o mais novo
+        const auto &span = spans_[(next_ + i) % spans_.size()];
+
+        if (i > 0)
+            out += ',';
+
+        out.append("{\"name\":\"").append(span.name).append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+        out.append(std::to_string(span.thread)).append(",\"ts\":");
+        append_us(out, span.start_ns);
+        out.append(",\"dur\":");
+        append_us(out, span.duration_ns);
+        out.append(",\"args\":{\"depth\":").append(std::to_string(span.depth)).append("}}");
+    }
+
+    out.append("]}");
+    return out;
+}
+
+ScopedSpan::ScopedSpan(const char *name)
+    : index_(-1)
+{
+    auto &trace = current();
+    if (!trace.active || trace.spans.size() >= max_spans_per_request)
+        return;
+
+    index_ = static_cast<int64_t>(trace.spans.size());
+    trace.spans.push_back(Span{name, now_ns(), 0, trace.depth++, trace.thread});
+}
+
+ScopedSpan::~ScopedSpan()
+{
+    if (index_ < 0)
+        return;
+
+    auto &trace = current();
+    auto &span = trace.spans[static_cast<size_t>(index_)];
+    span.duration_ns = now_ns() - span.start_ns;
+    --trace.depth;
+}
+
+auto begin_request() -> void
+{
+    auto &trace = current();
+    trace.spans.clear();
+    trace.depth = 1;
+    trace.active = true;
+
+    // Span raiz da requisição, fechado em end_request
+    trace.spans.push_back(Span{"request", now_ns(), 0, 0, trace.thread});
+}
+
+auto end_request() -> std::string
+{
+    auto &trace = current();
+    if (!trace.active)
+        return {};
+
+    trace.active = false;
+
+    auto &root = trace.spans.front();
+    root.duration_ns = now_ns() - root.start_ns;
+
+    // Server-Timing agrega por nome, na ordem em que cada nome apareceu
+    std::vector<std::pair<const char *, int64_t>> totals;
+    for (size_t i = 1; i < trace.spans.size(); ++i)
+    {
+        const auto &span = trace.spans[i];
+
+        auto it = totals.begin();
+        while (it != totals.end() && std::string_view(it->first) != span.name)
+            ++it;
+
+        if (it == totals.end())
+            totals.emplace_back(span.name, span.duration_ns);
+        else
+            it->second += span.duration_ns;
+    }
+
+    std::string header;
+    header.reserve(32 * (totals.size() + 1));
+
+    for (const auto &[name, duration_ns] : totals)
+    {
+        header.append(name).append(";dur=");
+        append_ms(header, duration_ns);
+        header.append(", ");
+    }
+    header.append("total;dur=");
+    append_ms(header, root.duration_ns);
+
+    const auto sample_every = TraceBuffer::get_instance().sample_every();
+    if (sample_every > 0 && ++trace.requests % sample_every == 0)
+    {
+        TraceBuffer::get_instance().push(trace.spans);
+    }
+
+    return header;
+}
+
+} // namespace lynx::tracing
+
+#endif
@@ -0,0 +1,22 @@
+#include "tracing/tracing_middleware.h"
+
+#ifdef LYNX_TRACING
+
+namespace lynx::tracing
+{
+
+void TracingMiddleware::before_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    begin_request();
+}
+
+void TracingMiddleware::after_handle(crow::request &req, crow::response &res, context &ctx)
+{
+    auto server_timing = end_request();
+    if (!server_timing.empty())
+        res.set_header("Server-Timing", server_timing);
+}
+
+} // namespace lynx::tracing
+
+#endif
@@ -0,0 +1,83 @@
+#include "utils/http_header.h"
+#include <cctype>
+
+namespace utils::http
+{
+
+auto trim(std::string_view text) -> std::string_view
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+        text.remove_suffix(1);
+    return text;
+}
+
+auto equals_ignore_case(std::string_view a, std::string_view b) -> bool
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    }
+    return true;
+}
+
+auto quality_of(std::string_view params) -> int
+{
+    while (!params.empty())
+    {
+        const auto semicolon = params.find(';');
+        const auto param = trim(params.substr(0, semicolon));
+        params = semicolon == std::string_view::npos ? std::string_view{} : params.substr(semicolon + 1);
+
+        if (param.size() < 2 || std::tolower(static_cast<unsigned char>(param[0])) != 'q' || param[1] != '=')
+            continue;
+
+        const auto value = param.substr(2);
+        if (value.empty() || (value[0] != '0' && value[0] != '1'))
+            return 0;
+
+        int quality = (value[0] - '0') * 1000;
+        int scale = 100;
+        for (size_t i = 1; i < value.size(); ++i)
+        {
+            if (i == 1)
+            {
+                if (value[i] != '.')
+                    return 0;
+                continue;
+            }
+            if (!std::isdigit(static_cast<unsigned char>(value[i])) || scale == 0)
+                return 0;
+
+            quality += (value[i] - '0') * scale;
+            scale /= 10;
+        }
+        return quality > 1000 ? 0 : quality;
+    }
+    return 1000;
+}
+
+auto merge_vary(std::string_view current, std::string_view field) -> std::string
+{
+    for (auto rest = current; !rest.empty();)
+    {
+        const auto comma = rest.find(',');
+        if (equals_ignore_case(trim(rest.substr(0, comma)), field))
+            return std::string(current);
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+    }
+
+    if (trim(current).empty())
+        return std::string(field);
+
+    std::string merged(current);
+    merged.append(", ").append(field);
+    return merged;
+}
+
+} // namespace utils::http
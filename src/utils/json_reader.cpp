@@ -0,0 +1,536 @@
+#include "utils/json_reader.h"
+#include "errors/http_handle_error.h"
+#include "utils/time/time_format.h"
+#include <charconv>
+#include <limits>
+
+namespace utils::json
+{
+
+namespace
+{
+
+auto is_digit(char c) -> bool
+{
+    return c >= '0' && c <= '9';
+}
+
+auto append_utf8(std::string &out, uint32_t code_point) -> void
+{
+    if (code_point < 0x80)
+    {
+        out += static_cast<char>(code_point);
+    }
+    else if (code_point < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (code_point >> 6));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    else if (code_point < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (code_point >> 12));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (code_point >> 18));
+        out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+} // namespace
+
+ReaderBase::ReaderBase(const ReaderLimits &limits)
+    : limits_(limits)
+{
+    path_.reserve(8);
+}
+
+auto ReaderBase::enter() -> void
+{
+    if (++depth_ > limits_.max_depth)
+        fail("nesting too deep");
+}
+
+auto ReaderBase::check_item_limit(size_t index) const -> void
+{
+    if (index >= limits_.max_array_items)
+        throw lynx::exceptions::PayloadTooLargeError(path() + ": more than " + std::to_string(limits_.max_array_items) + " items");
+}
+
+auto ReaderBase::path() const -> std::string
+{
+    std::string out;
+    for (const auto &segment : path_)
+    {
+        if (segment.name.empty())
+        {
+            out.append("[").append(std::to_string(segment.index)).append("]");
+            continue;
+        }
+
+        if (!out.empty())
+            out += '.';
+        out.append(segment.name);
+    }
+
+    return out.empty() ? "body" : out;
+}
+
+auto ReaderBase::fail(const std::string &message) const -> void
+{
+    throw lynx::exceptions::BadRequestError(path() + ": " + message);
+}
+
+auto ReaderBase::push_key(std::string_view name) -> void
+{
+    path_.push_back(PathSegment{name, 0});
+}
+
+auto ReaderBase::push_index(size_t index) -> void
+{
+    path_.push_back(PathSegment{{}, index});
+}
+
+auto ReaderBase::pop() -> void
+{
+    path_.pop_back();
+}
+
+JsonReader::JsonReader(std::string_view input, const ReaderLimits &limits)
+    : ReaderBase(limits)
+    , input_(input)
+{
+}
+
+auto JsonReader::skip_whitespace() -> void
+{
+    while (pos_ < input_.size())
+    {
+        const auto c = input_[pos_];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+            return;
+        ++pos_;
+    }
+}
+
+auto JsonReader::peek() -> char
+{
+    skip_whitespace();
+    if (pos_ >= input_.size())
+        fail("unexpected end of input");
+    return input_[pos_];
+}
+
+auto JsonReader::expect(char c, const char *what) -> void
+{
+    if (peek() != c)
+        fail(std::string("expected ") + what);
+    ++pos_;
+}
+
+auto JsonReader::begin_object() -> void
+{
+    enter();
+    expect('{', "object");
+    after_open_ = true;
+}
+
+auto JsonReader::next_key(std::string_view &key) -> bool
+{
+    auto c = peek();
+
+    if (c == '}')
+    {
+        ++pos_;
+        --depth_;
+        after_open_ = false;
+        return false;
+    }
+
+    // Depois do primeiro membro, cada chave vem precedida de vírgula
+    if (!after_open_)
+    {
+        if (c != ',')
+            fail("expected ',' or '}'");
+        ++pos_;
+        c = peek();
+    }
+    after_open_ = false;
+
+    if (c != '"')
+        fail("expected object key");
+
+    // Chave sem escape é só uma fatia da entrada; com escape, é decodificada no buffer de rascunho
+    const auto start = pos_ + 1;
+    auto end = start;
+    while (end < input_.size() && input_[end] != '"' && input_[end] != '\\' && static_cast<unsigned char>(input_[end]) >= 0x20)
+        ++end;
+
+    if (end < input_.size() && input_[end] == '"')
+    {
+        key = input_.substr(start, end - start);
+        pos_ = end + 1;
+    }
+    else
+    {
+        key_scratch_.clear();
+        read_string_into(key_scratch_);
+        key = key_scratch_;
+    }
+
+    expect(':', "':' after object key");
+    return true;
+}
+
+auto JsonReader::begin_array() -> void
+{
+    enter();
+    expect('[', "array");
+}
+
+auto JsonReader::next_item(size_t index) -> bool
+{
+    const auto c = peek();
+
+    if (c == ']')
+    {
+        ++pos_;
+        --depth_;
+        return false;
+    }
+
+    if (index > 0)
+    {
+        if (c != ',')
+            fail("expected ',' or ']'");
+        ++pos_;
+        peek();
+    }
+
+    check_item_limit(index);
+    return true;
+}
+
+auto JsonReader::read_hex4() -> uint32_t
+{
+    if (pos_ + 4 > input_.size())
+        fail("truncated \\u escape");
+
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto c = input_[pos_++];
+        value <<= 4;
+
+        if (c >= '0' && c <= '9')
+            value |= static_cast<uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            value |= static_cast<uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            value |= static_cast<uint32_t>(c - 'A' + 10);
+        else
+            fail("invalid \\u escape");
+    }
+
+    return value;
+}
+
+auto JsonReader::read_string_into(std::string &out) -> void
+{
+    expect('"', "string");
+
+    while (true)
+    {
+        // Copia em blocos até a próxima aspa ou barra
+        const auto start = pos_;
+        while (pos_ < input_.size())
+        {
+            const auto c = input_[pos_];
+            if (c == '"' || c == '\\')
+                break;
+            if (static_cast<unsigned char>(c) < 0x20)
+                fail("control character in string");
+            ++pos_;
+        }
+
+        out.append(input_.data() + start, pos_ - start);
+
+        if (out.size() > limits_.max_string_bytes)
+            fail("string longer than " + std::to_string(limits_.max_string_bytes) + " bytes");
+
+        if (pos_ >= input_.size())
+            fail("unterminated string");
+
+        if (input_[pos_] == '"')
+        {
+            ++pos_;
+            return;
+        }
+
+        ++pos_;
+        if (pos_ >= input_.size())
+            fail("unterminated string");
+
+        switch (input_[pos_++])
+        {
+        case '"':
+            out += '"';
+            break;
+        case '\\':
+            out += '\\';
+            break;
+        case '/':
+            out += '/';
+            break;
+        case 'b':
+            out += '\b';
+            break;
+        case 'f':
+            out += '\f';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'u': {
+            auto code_point = read_hex4();
+
+            if (code_point >= 0xD800 && code_point <= 0xDBFF)
+            {
+                if (pos_ + 2 > input_.size() || input_[pos_] != '\\' || input_[pos_ + 1] != 'u')
+                    fail("unpaired surrogate in \\u escape");
+                pos_ += 2;
+
+                const auto low = read_hex4();
+                if (low < 0xDC00 || low > 0xDFFF)
+                    fail("unpaired surrogate in \\u escape");
+
+                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            }
+            else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+            {
+                fail("unpaired surrogate in \\u escape");
+            }
+
+            append_utf8(out, code_point);
+            break;
+        }
+        default:
+            fail("invalid escape in string");
+        }
+    }
+}
+
+auto JsonReader::read_string(std::string &out) -> void
+{
+    out.clear();
+    if (peek() != '"')
+        fail("expected string");
+    read_string_into(out);
+}
+
+auto JsonReader::skip_string() -> void
+{
+    key_scratch_.clear();
+    read_string_into(key_scratch_);
+}
+
+// Fatia do número seguindo a gramática do JSON: -?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?
+auto JsonReader::number_token() -> std::string_view
+{
+    skip_whitespace();
+    const auto start = pos_;
+
+    if (pos_ < input_.size() && input_[pos_] == '-')
+        ++pos_;
+
+    if (pos_ >= input_.size() || !is_digit(input_[pos_]))
+        fail("expected number");
+
+    if (input_[pos_] == '0')
+    {
+        ++pos_;
+        if (pos_ < input_.size() && is_digit(input_[pos_]))
+            fail("leading zeros are not allowed");
+    }
+    else
+    {
+        while (pos_ < input_.size() && is_digit(input_[pos_]))
+            ++pos_;
+    }
+
+    if (pos_ < input_.size() && input_[pos_] == '.')
+    {
+        ++pos_;
+        if (pos_ >= input_.size() || !is_digit(input_[pos_]))
+            fail("expected digits after decimal point");
+        while (pos_ < input_.size() && is_digit(input_[pos_]))
+            ++pos_;
+    }
+
+    if (pos_ < input_.size() && (input_[pos_] == 'e' || input_[pos_] == 'E'))
+    {
+        ++pos_;
+        if (pos_ < input_.size() && (input_[pos_] == '+' || input_[pos_] == '-'))
+            ++pos_;
+        if (pos_ >= input_.size() || !is_digit(input_[pos_]))
+            fail("expected digits in exponent");
+        while (pos_ < input_.size() && is_digit(input_[pos_]))
+            ++pos_;
+    }
+
+    return input_.substr(start, pos_ - start);
+}
+
+auto JsonReader::read_int64() -> int64_t
+{
+    const auto c = peek();
+    if (c != '-' && !is_digit(c))
+        fail("expected integer");
+
+    const auto token = number_token();
+
+    int64_t value = 0;
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+
+    if (ec == std::errc::result_out_of_range)
+        fail("integer out of range");
+    if (ec != std::errc() || end != token.data() + token.size())
+        fail("expected integer");
+
+    return value;
+}
+
+auto JsonReader::read_int() -> int
+{
+    const auto value = read_int64();
+
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+        fail("integer out of range");
+
+    return static_cast<int>(value);
+}
+
+auto JsonReader::read_double() -> double
+{
+    const auto c = peek();
+    if (c != '-' && !is_digit(c))
+        fail("expected number");
+
+    const auto token = number_token();
+
+    double value = 0;
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc() || end != token.data() + token.size())
+        fail("number out of range");
+
+    return value;
+}
+
+auto JsonReader::read_time_point() -> std::chrono::system_clock::time_point
+{
+    std::string text;
+    read_string(text);
+
+    std::chrono::system_clock::time_point value;
+    if (!utils::time::parse_time(text, value))
+        fail("invalid timestamp");
+
+    return value;
+}
+
+auto JsonReader::read_bool() -> bool
+{
+    const auto c = peek();
+
+    if (c == 't' && input_.substr(pos_, 4) == "true")
+    {
+        pos_ += 4;
+        return true;
+    }
+    if (c == 'f' && input_.substr(pos_, 5) == "false")
+    {
+        pos_ += 5;
+        return false;
+    }
+
+    fail("expected boolean");
+}
+
+auto JsonReader::read_null() -> bool
+{
+    if (peek() != 'n' || input_.substr(pos_, 4) != "null")
+        return false;
+
+    pos_ += 4;
+    return true;
+}
+
+auto JsonReader::skip_value() -> void
+{
+    const auto c = peek();
+
+    switch (c)
+    {
+    case '"':
+        skip_string();
+        return;
+    case '{': {
+        begin_object();
+        std::string_view key;
+        while (next_key(key))
+            skip_value();
+        return;
+    }
+    case '[': {
+        begin_array();
+        // Pula sem o limite de itens: o valor é descartado
+        for (size_t index = 0;; ++index)
+        {
+            const auto next = peek();
+            if (next == ']')
+            {
+                ++pos_;
+                --depth_;
+                return;
+            }
+            if (index > 0)
+            {
+                if (next != ',')
+                    fail("expected ',' or ']'");
+                ++pos_;
+            }
+            skip_value();
+        }
+    }
+    case 't':
+    case 'f':
+        read_bool();
+        return;
+    case 'n':
+        if (input_.substr(pos_, 4) != "null")
+            fail("invalid literal");
+        pos_ += 4;
+        return;
+    default:
+        number_token();
+    }
+}
+
+auto JsonReader::finish() -> void
+{
+    skip_whitespace();
+    if (pos_ != input_.size())
+        fail("unexpected data after JSON value");
+}
+
+} // namespace utils::json
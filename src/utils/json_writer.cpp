@@ -0,0 +1,185 @@
+#include "utils/json_writer.h"
+#include "utils/time/time_format.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+
+namespace utils::json
+{
+
+namespace
+{
+
+constexpr std::array<char, 16> hex_digits = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+auto needs_escape(char c) -> bool
+{
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+} // namespace
+
+JsonWriter::JsonWriter(size_t reserve_bytes)
+{
+    out_.reserve(reserve_bytes);
+}
+
+// Vírgula antes de todo valor que não abre o container nem vem logo depois de uma chave
+auto JsonWriter::separate() -> void
+{
+    if (out_.empty())
+        return;
+
+    const auto last = out_.back();
+    if (last != '[' && last != '{' && last != ':')
+        out_ += ',';
+}
+
+auto JsonWriter::begin_object() -> JsonWriter &
+{
+    separate();
+    out_ += '{';
+    return *this;
+}
+
+auto JsonWriter::end_object() -> JsonWriter &
+{
+    out_ += '}';
+    return *this;
+}
+
+auto JsonWriter::begin_array() -> JsonWriter &
+{
+    separate();
+    out_ += '[';
+    return *this;
+}
+
+auto JsonWriter::end_array() -> JsonWriter &
+{
+    out_ += ']';
+    return *this;
+}
+
+auto JsonWriter::key(std::string_view name) -> JsonWriter &
+{
+    separate();
+    out_ += '"';
+    out_.append(name);
+    out_.append("\":");
+    return *this;
+}
+
+auto JsonWriter::value(int64_t number) -> JsonWriter &
+{
+    separate();
+
+    std::array<char, 24> digits;
+    auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+    out_.append(digits.data(), end);
+    return *this;
+}
+
+auto JsonWriter::value(double number) -> JsonWriter &
+{
+    // JSON não tem NaN nem infinito: to_chars escreveria "nan"/"inf" e o corpo deixaria de ser JSON
+    if (!std::isfinite(number))
+        return null();
+
+    separate();
+
+    std::array<char, 32> digits;
+    auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+    out_.append(digits.data(), end);
+    return *this;
+}
+
+auto JsonWriter::value(bool flag) -> JsonWriter &
+{
+    separate();
+    out_.append(flag ? "true" : "false");
+    return *this;
+}
+
+auto JsonWriter::value(std::string_view text) -> JsonWriter &
+{
+    separate();
+    out_ += '"';
+
+    // Copia em blocos os trechos sem caractere especial; só os especiais passam pelo escape
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const auto c = text[i];
+        if (!needs_escape(c))
+            continue;
+
+        out_.append(text.data() + start, i - start);
+        start = i + 1;
+
+        switch (c)
+        {
+        case '"':
+            out_.append("\\\"");
+            break;
+        case '\\':
+            out_.append("\\\\");
+            break;
+        case '\n':
+            out_.append("\\n");
+            break;
+        case '\r':
+            out_.append("\\r");
+            break;
+        case '\t':
+            out_.append("\\t");
+            break;
+        default:
+            out_.append("\\u00");
+            out_ += hex_digits[(static_cast<unsigned char>(c) >> 4) & 0xF];
+            out_ += hex_digits[static_cast<unsigned char>(c) & 0xF];
+        }
+    }
+
+    out_.append(text.data() + start, text.size() - start);
+    out_ += '"';
+    return *this;
+}
+
+auto JsonWriter::null() -> JsonWriter &
+{
+    separate();
+    out_.append("null");
+    return *this;
+}
+
+auto JsonWriter::value(const std::chrono::system_clock::time_point &tp) -> JsonWriter &
+{
+    std::array<char, time::max_time_length_ + 2> buffer;
+    buffer[0] = '"';
+    const auto length = time::format_time(tp, time::TimeFormat::iso8601, buffer.data() + 1);
+    buffer[length + 1] = '"';
+
+    separate();
+    out_.append(buffer.data(), length + 2);
+    return *this;
+}
+
+auto JsonWriter::buffer() const -> const std::string &
+{
+    return out_;
+}
+
+auto JsonWriter::take() -> std::string
+{
+    auto out = std::move(out_);
+    out_.clear();
+    return out;
+}
+
+auto JsonWriter::clear() -> void
+{
+    out_.clear();
+}
+
+} // namespace utils::json
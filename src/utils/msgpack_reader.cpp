@@ -0,0 +1,364 @@
+#include "utils/msgpack_reader.h"
+#include <cstring>
+#include <limits>
+
+namespace utils::msgpack
+{
+
+MsgPackReader::MsgPackReader(std::string_view input, const json::ReaderLimits &limits)
+    : ReaderBase(limits)
+    , input_(input)
+{
+}
+
+auto MsgPackReader::byte() -> uint8_t
+{
+    if (pos_ >= input_.size())
+        fail("unexpected end of input");
+    return static_cast<uint8_t>(input_[pos_++]);
+}
+
+auto MsgPackReader::big_endian(int size) -> uint64_t
+{
+    const auto raw = bytes(static_cast<size_t>(size));
+
+    uint64_t value = 0;
+    for (const auto c : raw)
+    {
+        value = (value << 8) | static_cast<uint8_t>(c);
+    }
+    return value;
+}
+
+auto MsgPackReader::bytes(size_t size) -> std::string_view
+{
+    if (size > input_.size() - pos_)
+        fail("unexpected end of input");
+
+    const auto out = input_.substr(pos_, size);
+    pos_ += size;
+    return out;
+}
+
+auto MsgPackReader::container_size(uint8_t head, uint8_t fix_mask, uint8_t size16, uint8_t size32, const char *what) -> uint32_t
+{
+    if ((head & 0xF0) == fix_mask)
+        return head & 0x0F;
+    if (head == size16)
+        return static_cast<uint32_t>(big_endian(2));
+    if (head == size32)
+        return static_cast<uint32_t>(big_endian(4));
+
+    fail(std::string("expected ") + what);
+}
+
+// Fatia da string na entrada, sem cópia
+auto MsgPackReader::string_view_of(const char *what) -> std::string_view
+{
+    const auto head = byte();
+
+    size_t size = 0;
+    if ((head & 0xE0) == 0xa0)
+        size = head & 0x1F;
+    else if (head == 0xd9)
+        size = big_endian(1);
+    else if (head == 0xda)
+        size = big_endian(2);
+    else if (head == 0xdb)
+        size = big_endian(4);
+    else
+        fail(std::string("expected ") + what);
+
+    if (size > limits_.max_string_bytes)
+        fail("string longer than " + std::to_string(limits_.max_string_bytes) + " bytes");
+
+    return bytes(size);
+}
+
+auto MsgPackReader::begin_object() -> void
+{
+    enter();
+    remaining_.push_back(container_size(byte(), 0x80, 0xde, 0xdf, "map"));
+}
+
+auto MsgPackReader::next_key(std::string_view &key) -> bool
+{
+    if (remaining_.back() == 0)
+    {
+        remaining_.pop_back();
+        --depth_;
+        return false;
+    }
+
+    --remaining_.back();
+    key = string_view_of("string key");
+    return true;
+}
+
+auto MsgPackReader::begin_array() -> void
+{
+    enter();
+    remaining_.push_back(container_size(byte(), 0x90, 0xdc, 0xdd, "array"));
+}
+
+auto MsgPackReader::next_item(size_t index) -> bool
+{
+    if (remaining_.back() == 0)
+    {
+        remaining_.pop_back();
+        --depth_;
+        return false;
+    }
+
+    check_item_limit(index);
+    --remaining_.back();
+    return true;
+}
+
+auto MsgPackReader::read_int64() -> int64_t
+{
+    const auto head = byte();
+
+    if (head < 0x80)
+        return head; // positive fixint
+    if (head >= 0xe0)
+        return static_cast<int8_t>(head); // negative fixint
+
+    switch (head)
+    {
+    case 0xcc:
+        return static_cast<int64_t>(big_endian(1));
+    case 0xcd:
+        return static_cast<int64_t>(big_endian(2));
+    case 0xce:
+        return static_cast<int64_t>(big_endian(4));
+    case 0xcf: {
+        const auto value = big_endian(8);
+        if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+            fail("integer out of range");
+        return static_cast<int64_t>(value);
+    }
+    case 0xd0:
+        return static_cast<int8_t>(big_endian(1));
+    case 0xd1:
+        return static_cast<int16_t>(big_endian(2));
+    case 0xd2:
+        return static_cast<int32_t>(big_endian(4));
+    case 0xd3:
+        return static_cast<int64_t>(big_endian(8));
+    default:
+        fail("expected integer");
+    }
+}
+
+auto MsgPackReader::read_int() -> int
+{
+    const auto value = read_int64();
+
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+        fail("integer out of range");
+
+    return static_cast<int>(value);
+}
+
+auto MsgPackReader::read_bool() -> bool
+{
+    const auto head = byte();
+
+    if (head == 0xc3)
+        return true;
+    if (head == 0xc2)
+        return false;
+
+    fail("expected boolean");
+}
+
+auto MsgPackReader::read_null() -> bool
+{
+    if (pos_ >= input_.size() || static_cast<uint8_t>(input_[pos_]) != 0xc0)
+        return false;
+
+    ++pos_;
+    return true;
+}
+
+auto MsgPackReader::read_string(std::string &out) -> void
+{
+    out.assign(string_view_of("string"));
+}
+
+auto MsgPackReader::read_double() -> double
+{
+    if (pos_ >= input_.size())
+        fail("unexpected end of input");
+
+    const auto head = static_cast<uint8_t>(input_[pos_]);
+
+    if (head == 0xca)
+    {
+        ++pos_;
+        const auto bits = static_cast<uint32_t>(big_endian(4));
+        float number;
+        std::memcpy(&number, &bits, sizeof(number));
+        return number;
+    }
+
+    if (head == 0xcb)
+    {
+        ++pos_;
+        const auto bits = big_endian(8);
+        double number;
+        std::memcpy(&number, &bits, sizeof(number));
+        return number;
+    }
+
+    // Como no JSON, inteiro também vale onde se espera número
+    return static_cast<double>(read_int64());
+}
+
+auto MsgPackReader::read_time_point() -> std::chrono::system_clock::time_point
+{
+    const auto head = byte();
+
+    int64_t seconds = 0;
+    uint32_t nanoseconds = 0;
+
+    if (head == 0xd6 && byte() == 0xff)
+    {
+        seconds = static_cast<int64_t>(big_endian(4));
+    }
+    else if (head == 0xd7 && byte() == 0xff)
+    {
+        const auto packed = big_endian(8);
+        nanoseconds = static_cast<uint32_t>(packed >> 34);
+        seconds = static_cast<int64_t>(packed & 0x3FFFFFFFFull);
+    }
+    else if (head == 0xc7 && byte() == 12 && byte() == 0xff)
+    {
+        nanoseconds = static_cast<uint32_t>(big_endian(4));
+        seconds = static_cast<int64_t>(big_endian(8));
+    }
+    else
+    {
+        fail("expected timestamp");
+    }
+
+    if (nanoseconds >= 1'000'000'000)
+        fail("invalid timestamp");
+
+    // Limite do system_clock em nanossegundos (~292 anos em volta de 1970)
+    constexpr int64_t max_seconds = std::numeric_limits<int64_t>::max() / 1'000'000'000 - 1;
+    if (seconds > max_seconds || seconds < -max_seconds)
+        fail("timestamp out of range");
+
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds)));
+}
+
+auto MsgPackReader::skip_value() -> void
+{
+    const auto head = byte();
+
+    // Formatos de tamanho fixo ou com o tamanho no próprio byte
+    if (head < 0x80 || head >= 0xe0 || head == 0xc0 || head == 0xc2 || head == 0xc3)
+        return;
+
+    if ((head & 0xE0) == 0xa0)
+    {
+        bytes(head & 0x1F);
+        return;
+    }
+
+    const auto skip_container = [this](uint64_t entries) {
+        enter();
+        // Cada entrada ocupa ao menos um byte: contagem maior que o resto da entrada já é erro
+        if (entries > input_.size() - pos_)
+            fail("unexpected end of input");
+        for (uint64_t i = 0; i < entries; ++i)
+        {
+            skip_value();
+        }
+        --depth_;
+    };
+
+    if ((head & 0xF0) == 0x80)
+        return skip_container(uint64_t{head & 0x0Fu} * 2);
+    if ((head & 0xF0) == 0x90)
+        return skip_container(head & 0x0F);
+
+    switch (head)
+    {
+    case 0xcc:
+    case 0xd0:
+        bytes(1);
+        return;
+    case 0xcd:
+    case 0xd1:
+        bytes(2);
+        return;
+    case 0xca:
+    case 0xce:
+    case 0xd2:
+        bytes(4);
+        return;
+    case 0xcb:
+    case 0xcf:
+    case 0xd3:
+        bytes(8);
+        return;
+    case 0xc4: // bin 8/16/32
+    case 0xd9: // str 8/16/32
+        bytes(big_endian(1));
+        return;
+    case 0xc5:
+    case 0xda:
+        bytes(big_endian(2));
+        return;
+    case 0xc6:
+    case 0xdb:
+        bytes(big_endian(4));
+        return;
+    case 0xd4: // fixext 1/2/4/8/16: tipo + dados
+        bytes(2);
+        return;
+    case 0xd5:
+        bytes(3);
+        return;
+    case 0xd6:
+        bytes(5);
+        return;
+    case 0xd7:
+        bytes(9);
+        return;
+    case 0xd8:
+        bytes(17);
+        return;
+    case 0xc7: // ext 8/16/32: tamanho + tipo + dados
+        bytes(big_endian(1) + 1);
+        return;
+    case 0xc8:
+        bytes(big_endian(2) + 1);
+        return;
+    case 0xc9:
+        bytes(big_endian(4) + 1);
+        return;
+    case 0xdc:
+        return skip_container(big_endian(2));
+    case 0xdd:
+        return skip_container(big_endian(4));
+    case 0xde:
+        return skip_container(big_endian(2) * 2);
+    case 0xdf:
+        return skip_container(big_endian(4) * 2);
+    default:
+        fail("invalid MessagePack type byte"); // 0xc1 é reservado
+    }
+}
+
+auto MsgPackReader::finish() -> void
+{
+    if (pos_ != input_.size())
+        fail("unexpected data after MessagePack value");
+}
+
+} // namespace utils::msgpack
@@ -0,0 +1,235 @@
+#include "utils/msgpack_writer.h"
+#include <cstring>
+
+namespace utils::msgpack
+{
+
+MsgPackWriter::MsgPackWriter(size_t reserve_bytes)
+{
+    out_.reserve(reserve_bytes);
+}
+
+auto MsgPackWriter::put_byte(uint8_t byte) -> void
+{
+    out_ += static_cast<char>(byte);
+}
+
+auto MsgPackWriter::put_big_endian(uint64_t value, int bytes) -> void
+{
+    char buffer[8];
+    for (int i = bytes - 1; i >= 0; --i)
+    {
+        buffer[i] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+    out_.append(buffer, static_cast<size_t>(bytes));
+}
+
+// Byte de tipo seguido do valor em big-endian, anexados de uma vez
+auto MsgPackWriter::put_header(uint8_t head, uint64_t value, int bytes) -> void
+{
+    char buffer[9];
+    buffer[0] = static_cast<char>(head);
+    for (int i = bytes; i >= 1; --i)
+    {
+        buffer[i] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+    out_.append(buffer, static_cast<size_t>(bytes) + 1);
+}
+
+auto MsgPackWriter::begin_map(uint32_t size) -> MsgPackWriter &
+{
+    if (size < 16)
+    {
+        put_byte(static_cast<uint8_t>(0x80 | size));
+    }
+    else if (size <= 0xFFFF)
+    {
+        put_header(0xde, size, 2);
+    }
+    else
+    {
+        put_header(0xdf, size, 4);
+    }
+    return *this;
+}
+
+auto MsgPackWriter::begin_array(uint32_t size) -> MsgPackWriter &
+{
+    if (size < 16)
+    {
+        put_byte(static_cast<uint8_t>(0x90 | size));
+    }
+    else if (size <= 0xFFFF)
+    {
+        put_header(0xdc, size, 2);
+    }
+    else
+    {
+        put_header(0xdd, size, 4);
+    }
+    return *this;
+}
+
+auto MsgPackWriter::key(std::string_view name) -> MsgPackWriter &
+{
+    return value(name);
+}
+
+auto MsgPackWriter::value(int64_t number) -> MsgPackWriter &
+{
+    if (number >= 0)
+    {
+        const auto unsigned_number = static_cast<uint64_t>(number);
+
+        if (unsigned_number < 0x80)
+        {
+            put_byte(static_cast<uint8_t>(unsigned_number));
+        }
+        else if (unsigned_number <= 0xFF)
+        {
+            put_header(0xcc, unsigned_number, 1);
+        }
+        else if (unsigned_number <= 0xFFFF)
+        {
+            put_header(0xcd, unsigned_number, 2);
+        }
+        else if (unsigned_number <= 0xFFFFFFFF)
+        {
+            put_header(0xce, unsigned_number, 4);
+        }
+        else
+        {
+            put_header(0xcf, unsigned_number, 8);
+        }
+        return *this;
+    }
+
+    if (number >= -32)
+    {
+        put_byte(static_cast<uint8_t>(number)); // negative fixint
+    }
+    else if (number >= INT8_MIN)
+    {
+        put_header(0xd0, static_cast<uint64_t>(number), 1);
+    }
+    else if (number >= INT16_MIN)
+    {
+        put_header(0xd1, static_cast<uint64_t>(number), 2);
+    }
+    else if (number >= INT32_MIN)
+    {
+        put_header(0xd2, static_cast<uint64_t>(number), 4);
+    }
+    else
+    {
+        put_header(0xd3, static_cast<uint64_t>(number), 8);
+    }
+    return *this;
+}
+
+auto MsgPackWriter::value(double number) -> MsgPackWriter &
+{
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+
+    put_header(0xcb, bits, 8);
+    return *this;
+}
+
+auto MsgPackWriter::value(bool flag) -> MsgPackWriter &
+{
+    put_byte(flag ? 0xc3 : 0xc2);
+    return *this;
+}
+
+auto MsgPackWriter::value(std::string_view text) -> MsgPackWriter &
+{
+    const auto size = text.size();
+
+    if (size < 32)
+    {
+        put_byte(static_cast<uint8_t>(0xa0 | size));
+    }
+    else if (size <= 0xFF)
+    {
+        put_header(0xd9, size, 1);
+    }
+    else if (size <= 0xFFFF)
+    {
+        put_header(0xda, size, 2);
+    }
+    else
+    {
+        put_header(0xdb, size, 4);
+    }
+
+    out_.append(text);
+    return *this;
+}
+
+auto MsgPackWriter::value(const char *text) -> MsgPackWriter &
+{
+    return value(std::string_view(text));
+}
+
+// Extensão timestamp: 32 bits quando cabe em segundos inteiros, 64 com nanossegundos, 96 no resto
+auto MsgPackWriter::value(const std::chrono::system_clock::time_point &tp) -> MsgPackWriter &
+{
+    const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+
+    auto seconds = since_epoch / 1'000'000'000;
+    auto nanoseconds = since_epoch % 1'000'000'000;
+    if (nanoseconds < 0)
+    {
+        seconds -= 1;
+        nanoseconds += 1'000'000'000;
+    }
+
+    if (seconds >= 0 && (seconds >> 34) == 0)
+    {
+        if (nanoseconds == 0 && seconds <= 0xFFFFFFFF)
+        {
+            put_header(0xd6, 0xff, 1);
+            put_big_endian(static_cast<uint64_t>(seconds), 4);
+        }
+        else
+        {
+            put_header(0xd7, 0xff, 1);
+            put_big_endian((static_cast<uint64_t>(nanoseconds) << 34) | static_cast<uint64_t>(seconds), 8);
+        }
+        return *this;
+    }
+
+    put_header(0xc7, 12, 1);
+    put_byte(0xff);
+    put_big_endian(static_cast<uint64_t>(nanoseconds), 4);
+    put_big_endian(static_cast<uint64_t>(seconds), 8);
+    return *this;
+}
+
+auto MsgPackWriter::null() -> MsgPackWriter &
+{
+    put_byte(0xc0);
+    return *this;
+}
+
+auto MsgPackWriter::buffer() const -> const std::string &
+{
+    return out_;
+}
+
+auto MsgPackWriter::take() -> std::string
+{
+    auto out = std::move(out_);
+    out_.clear();
+    return out;
+}
+
+auto MsgPackWriter::clear() -> void
+{
+    out_.clear();
+}
+
+} // namespace utils::msgpack
@@ -0,0 +1,223 @@
+#include "utils/time/time_format.h"
+#include "errors/http_handle_error.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace utils::time
+{
+
+namespace
+{
+
+using namespace std::chrono;
+
+constexpr auto make_two_digits()
+{
+    std::array<char, 200> table{};
+    for (int i = 0; i < 100; ++i)
+    {
+        table[i * 2] = static_cast<char>('0' + i / 10);
+        table[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}
+
+constexpr auto two_digits_ = make_two_digits();
+
+inline auto put_two_digits(char *out, unsigned value) -> void
+{
+    std::memcpy(out, &two_digits_[value * 2], 2);
+}
+
+/*
+ * Última data e último segundo formatados pela thread: listas trazem muitos horários do mesmo dia
+ * e, em rajadas, do mesmo segundo. Guarda só os dígitos; separador e sufixo dependem do formato.
+ */
+struct LastFormatted
+{
+    int64_t day = std::numeric_limits<int64_t>::min();
+    std::array<char, 10> date{}; // "YYYY-MM-DD"
+
+    int64_t second = std::numeric_limits<int64_t>::min();
+    std::array<char, 8> clock{}; // "HH:MM:SS"
+};
+
+auto refresh(LastFormatted &cached, int64_t second) -> void
+{
+    const auto seconds_since_epoch = sys_seconds(seconds(second));
+    const auto day = floor<days>(seconds_since_epoch);
+
+    if (day.time_since_epoch().count() != cached.day)
+    {
+        const year_month_day date(day);
+        const auto year = static_cast<unsigned>(static_cast<int>(date.year())) % 10000;
+
+        put_two_digits(cached.date.data(), year / 100);
+        put_two_digits(cached.date.data() + 2, year % 100);
+        cached.date[4] = '-';
+        put_two_digits(cached.date.data() + 5, static_cast<unsigned>(date.month()));
+        cached.date[7] = '-';
+        put_two_digits(cached.date.data() + 8, static_cast<unsigned>(date.day()));
+
+        cached.day = day.time_since_epoch().count();
+    }
+
+    const auto of_day = static_cast<unsigned>((seconds_since_epoch - day).count());
+
+    put_two_digits(cached.clock.data(), of_day / 3600);
+    cached.clock[2] = ':';
+    put_two_digits(cached.clock.data() + 3, of_day / 60 % 60);
+    cached.clock[5] = ':';
+    put_two_digits(cached.clock.data() + 6, of_day % 60);
+
+    cached.second = second;
+}
+
+// Dígito na posição i; um caractere não numérico liga invalid em vez de desviar
+inline auto digit_at(const char *text, size_t i, unsigned &invalid) -> unsigned
+{
+    const auto value = static_cast<unsigned>(static_cast<unsigned char>(text[i])) - '0';
+    invalid |= static_cast<unsigned>(value > 9);
+    return value;
+}
+
+} // namespace
+
+auto format_time(const system_clock::time_point &tp, TimeFormat format, char *out) -> size_t
+{
+    thread_local LastFormatted cached;
+
+    const auto second = floor<seconds>(tp);
+    const auto second_count = static_cast<int64_t>(second.time_since_epoch().count());
+
+    if (second_count != cached.second)
+        refresh(cached, second_count);
+
+    std::memcpy(out, cached.date.data(), 10);
+    out[10] = format == TimeFormat::sql ? ' ' : 'T';
+    std::memcpy(out + 11, cached.clock.data(), 8);
+
+    switch (format)
+    {
+    case TimeFormat::sql:
+        return 19;
+    case TimeFormat::iso8601:
+        out[19] = 'Z';
+        return 20;
+    default:
+    {
+        const auto millis = static_cast<unsigned>(duration_cast<milliseconds>(tp - second).count());
+        out[19] = '.';
+        out[20] = static_cast<char>('0' + millis / 100);
+        put_two_digits(out + 21, millis % 100);
+        out[23] = 'Z';
+        return 24;
+    }
+    }
+}
+
+auto format_time(const system_clock::time_point &tp, TimeFormat format) -> std::string
+{
+    std::array<char, max_time_length_> buffer;
+    return std::string(buffer.data(), format_time(tp, format, buffer.data()));
+}
+
+auto parse_time(std::string_view text, system_clock::time_point &out) -> bool
+{
+    if (text.size() < 19)
+        return false;
+
+    const char *p = text.data();
+    unsigned invalid = 0;
+
+    const auto year = digit_at(p, 0, invalid) * 1000 + digit_at(p, 1, invalid) * 100 + digit_at(p, 2, invalid) * 10 + digit_at(p, 3, invalid);
+    const auto month = digit_at(p, 5, invalid) * 10 + digit_at(p, 6, invalid);
+    const auto day = digit_at(p, 8, invalid) * 10 + digit_at(p, 9, invalid);
+    const auto hour = digit_at(p, 11, invalid) * 10 + digit_at(p, 12, invalid);
+    const auto minute = digit_at(p, 14, invalid) * 10 + digit_at(p, 15, invalid);
+    const auto second = digit_at(p, 17, invalid) * 10 + digit_at(p, 18, invalid);
+
+    invalid |= static_cast<unsigned>(p[4] != '-') | static_cast<unsigned>(p[7] != '-') | static_cast<unsigned>(p[13] != ':') |
+               static_cast<unsigned>(p[16] != ':') | static_cast<unsigned>(p[10] != ' ' && p[10] != 'T' && p[10] != 't');
+    invalid |= static_cast<unsigned>(hour > 23) | static_cast<unsigned>(minute > 59) | static_cast<unsigned>(second > 59);
+
+    if (invalid != 0)
+        return false;
+
+    const year_month_day date{std::chrono::year(static_cast<int>(year)), std::chrono::month(month), std::chrono::day(day)};
+    if (!date.ok())
+        return false;
+
+    size_t position = 19;
+
+    // Fração: dígitos além do nanossegundo são aceitos e descartados
+    int64_t nanos = 0;
+    if (position < text.size() && p[position] == '.')
+    {
+        const size_t start = ++position;
+        int64_t scale = 100'000'000;
+
+        while (position < text.size() && static_cast<unsigned>(static_cast<unsigned char>(p[position])) - '0' <= 9)
+        {
+            nanos += (p[position] - '0') * scale;
+            scale /= 10;
+            ++position;
+        }
+
+        if (position == start)
+            return false;
+    }
+
+    int offset_minutes = 0;
+    if (position < text.size())
+    {
+        const char zone = p[position];
+
+        if (zone == 'Z' || zone == 'z')
+        {
+            ++position;
+        }
+        else if ((zone == '+' || zone == '-') && text.size() - position == 6 && p[position + 3] == ':')
+        {
+            const auto offset_hour = digit_at(p, position + 1, invalid) * 10 + digit_at(p, position + 2, invalid);
+            const auto offset_minute = digit_at(p, position + 4, invalid) * 10 + digit_at(p, position + 5, invalid);
+
+            if (invalid != 0 || offset_hour > 23 || offset_minute > 59)
+                return false;
+
+            offset_minutes = static_cast<int>(offset_hour * 60 + offset_minute) * (zone == '-' ? -1 : 1);
+            position += 6;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (position != text.size())
+        return false;
+
+    const auto utc = sys_days(date) + hours(hour) + minutes(minute) + seconds(second) - minutes(offset_minutes);
+
+    // Com duração em nanossegundos o system_clock só cobre ~1678–2262
+    constexpr auto limit = duration_cast<seconds>(system_clock::duration::max()) - seconds(1);
+    if (utc.time_since_epoch() > limit || utc.time_since_epoch() < -limit)
+        return false;
+
+    out = time_point_cast<system_clock::duration>(utc) + duration_cast<system_clock::duration>(nanoseconds(nanos));
+    return true;
+}
+
+auto parse_time_or_throw(std::string_view text) -> system_clock::time_point
+{
+    system_clock::time_point tp;
+    if (!parse_time(text, tp))
+        throw lynx::exceptions::InternalServerError("Invalid stored timestamp: " + std::string(text));
+
+    return tp;
+}
+
+} // namespace utils::time